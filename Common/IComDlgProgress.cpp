@@ -87,6 +87,13 @@ void IComDlgProgress::UpdateMessage(const QString & krqstrMessage)
 
 
 void IComDlgProgress::UpdateProgress(const int kiCurrentVal)
+{
+    SetProgress(kiCurrentVal);
+    QApplication::processEvents();
+}
+
+
+void IComDlgProgress::SetProgress(const int kiCurrentVal)
 {
     m_pqpbProgress->setValue(kiCurrentVal);
 
@@ -95,8 +102,6 @@ void IComDlgProgress::UpdateProgress(const int kiCurrentVal)
     if (iNewValue > m_pqtbpTaskbarProgress->value())
         m_pqtbpTaskbarProgress->setValue(iNewValue);
     #endif
-
-    QApplication::processEvents();
 }
 
 
@@ -126,4 +131,6 @@ void IComDlgProgress::AbortClicked()
     #ifdef Q_OS_WIN
     m_pqtbpTaskbarProgress->hide();
     #endif
+
+    emit AbortRequested();
 }
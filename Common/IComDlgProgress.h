@@ -39,6 +39,9 @@ public:
     // Updates the progress
     void UpdateProgress(const int kiCurrentVal);
 
+    // Updates the progress without processing events, for when the work is done on another thread and progress is updated from a slot
+    void SetProgress(const int kiCurrentVal);
+
     // Increments progress value and updates
     void IncrementAndUpdateProgress();
 
@@ -52,6 +55,10 @@ public:
 private slots:
     // Called when button is clicked this takes action depending on the current status
     void AbortClicked();
+
+signals:
+    // Sent when Abort is clicked, for when the work is done on another thread and isn't polling Aborted()
+    void AbortRequested();
 };
 
 #endif // IComDlgProgress_h
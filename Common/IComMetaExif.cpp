@@ -1,4 +1,5 @@
 #include <QFile>
+#include <cstring>
 #include "IComMetaExif.h"
 
 // https://libexif.github.io/
@@ -8,30 +9,42 @@ IComMetaExif::IComMetaExif(const QString & krqstrFilePath)
 {
     m_pexdExifData = nullptr;
 
-    #ifdef Q_OS_WIN
-    // libExif opens files with fopen() so it won't work with Unicode file paths on Windows
-    // We therefore have to open the file with QFile and create the Exif Data with exif_data_new_from_data()
+    // libExif opens files with fopen(), which won't work with Unicode file paths on Windows, and exif_data_new_from_file() reads through
+    // the whole file in small chunks.  We therefore map the start of the file with QFile, which uses mmap() or MapViewOfFile(), find the
+    // Exif segment in the mapped header and create the Exif Data from just that slice with exif_data_new_from_data().  Only the pages the
+    // segment markers are on are touched and nothing is copied.  If the file can't be mapped the header is read instead
     QFile qfiImageFile(krqstrFilePath);
     if (!qfiImageFile.open(QIODevice::ReadOnly))
         return;
 
-    const QByteArray qbaImageFileData = qfiImageFile.readAll();
-    m_pexdExifData = exif_data_new_from_data(reinterpret_cast<const unsigned char*>(qbaImageFileData.constData()), static_cast<unsigned int>(qbaImageFileData.size()));
+    qint64 i64HeaderSize = qMin(qfiImageFile.size(), m_ki64MaxHeaderScan);
+    QByteArray qbaHeader;
+    const uchar* kpucHeader = qfiImageFile.map(0, i64HeaderSize);
+    if (kpucHeader == nullptr)
+    {
+        qbaHeader = qfiImageFile.read(i64HeaderSize);
+        kpucHeader = reinterpret_cast<const uchar*>(qbaHeader.constData());
+        i64HeaderSize = qbaHeader.size();
+    }
+
+    const uchar* kpucExifSegment;
+    int iExifSegmentLength;
+    if (FindExifSegment(kpucHeader, i64HeaderSize, kpucExifSegment, iExifSegmentLength) == false)
+        return;
+
+    // libexif copies the values it needs, so the mapping can be released when the file is closed
+    m_pexdExifData = exif_data_new_from_data(kpucExifSegment, static_cast<unsigned int>(iExifSegmentLength));
 
-    // Using this approach libexif always returns an ExifData object even if there's no Exif data present in the file
-    // The camera make seems to always be encoded, so if that's empty we'll assume there's no data
+    // Using this approach libexif always returns an ExifData object even if the segment couldn't be parsed, so if neither the main IFD nor
+    // the Exif IFD has any entries we'll assume there's no data.  Scanners and editors don't always write the camera make
     if (m_pexdExifData != nullptr)
     {
-        ExifEntry* exenEntry = exif_content_get_entry(m_pexdExifData->ifd[EXIF_IFD_0], EXIF_TAG_MAKE);
-        if (exenEntry == nullptr)
+        if (m_pexdExifData->ifd[EXIF_IFD_0]->count == 0 && m_pexdExifData->ifd[EXIF_IFD_EXIF]->count == 0)
         {
-            exif_data_free(m_pexdExifData);
+            exif_data_unref(m_pexdExifData);
             m_pexdExifData = nullptr;
         }
     }
-    #else
-    m_pexdExifData = exif_data_new_from_file(krqstrFilePath.toLocal8Bit().constData());
-    #endif
 }
 
 
@@ -99,6 +112,50 @@ void IComMetaExif::TrimSpacesFromEnd(char* rgcBuffer)
 }
 
 
+bool IComMetaExif::FindExifSegment(const uchar* kpucData, const qint64 ki64Size, const uchar* & rkpucSegment, int & riSegmentLength)
+{
+    // File must start with the SOI marker
+    if (ki64Size < 2 || kpucData[0] != 0xFF || kpucData[1] != 0xD8)
+        return false;
+
+    // Each segment is a two byte marker followed by a big-endian length that includes the length bytes but not the marker
+    qint64 i64Pos = 2;
+    while (i64Pos + 4 <= ki64Size)
+    {
+        if (kpucData[i64Pos] != 0xFF)
+            return false;
+
+        // Marker bytes can be padded with any number of 0xFF fill bytes
+        while (i64Pos + 4 <= ki64Size && kpucData[i64Pos+1] == 0xFF)
+            ++i64Pos;
+        if (i64Pos + 4 > ki64Size)
+            return false;
+
+        // Start of scan and end of image mean the Exif segment would already have been passed
+        const uchar kucMarker = kpucData[i64Pos+1];
+        if (kucMarker == 0xDA || kucMarker == 0xD9)
+            return false;
+
+        const int kiSegmentLength = (kpucData[i64Pos+2] << 8 | kpucData[i64Pos+3]) - 2;
+        if (kiSegmentLength < 0)
+            return false;
+        i64Pos += 4;
+
+        // APP1 is also used for XMP, so the segment must start with the Exif header, which libexif expects at the start of the data
+        if (kucMarker == 0xE1 && kiSegmentLength > 6 && i64Pos + kiSegmentLength <= ki64Size && memcmp(kpucData + i64Pos, "Exif\0\0", 6) == 0)
+        {
+            rkpucSegment = kpucData + i64Pos;
+            riSegmentLength = kiSegmentLength;
+            return true;
+        }
+
+        i64Pos += kiSegmentLength;
+    }
+
+    return false;
+}
+
+
 bool IComMetaExif::FileCanContainExif(const QString & kqstrExtension)
 {
     QString qstrExtension = kqstrExtension.toLower();
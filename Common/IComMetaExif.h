@@ -14,6 +14,9 @@ public:
     // Buffer for reading values into
     char                        m_rgcBuffer[256];
 
+    // The APP1 segment holding the Exif data must come before the image data, so no more than this much of the file is mapped and scanned
+    static const qint64         m_ki64MaxHeaderScan = 1024 * 1024;
+
 public:
     IComMetaExif(const QString & krqstrFilePath);
     ~IComMetaExif();
@@ -31,6 +34,10 @@ private:
     // Remove spaces on the right of the string
     void TrimSpacesFromEnd(char* rgcBuffer);
 
+    // Walks the JPEG segment headers in the passed file header, skipping over any segment that isn't Exif, and points rkpucSegment at the
+    // contents of the Exif APP1 segment.  Returns false if the file isn't a JPEG or the segment isn't complete before the image data
+    static bool FindExifSegment(const uchar* kpucData, const qint64 ki64Size, const uchar* & rkpucSegment, int & riSegmentLength);
+
 public:
     // Returns true if this file extension can contain Exif inforamtion
     static bool FileCanContainExif(const QString & kqstrExtension);
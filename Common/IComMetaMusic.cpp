@@ -5,8 +5,9 @@
 //http://taglib.org/api/classTagLib_1_1AudioProperties.html
 
 
-IComMetaMusic::IComMetaMusic(const QString & krqstrFilePath)
+IComMetaMusic::IComMetaMusic(const QString & krqstrFilePath, const int kiReadStyle)
 {
+    m_iReadStyle = kiReadStyle;
     OpenFile(krqstrFilePath);
 }
 
@@ -23,10 +24,18 @@ bool IComMetaMusic::OpenFile(const QString & krqstrFilePath)
     m_ptltagTags = nullptr;
     m_ptlapAudioProp = nullptr;
 
+    // With ReadNone audioProperties() returns nullptr, which the Get functions below already handle
+    const bool kbReadAudioProp = (m_iReadStyle != ReadNone);
+    TagLib::AudioProperties::ReadStyle tlrsReadStyle = TagLib::AudioProperties::Average;
+    if (m_iReadStyle == ReadFast)
+        tlrsReadStyle = TagLib::AudioProperties::Fast;
+    else if (m_iReadStyle == ReadAccurate)
+        tlrsReadStyle = TagLib::AudioProperties::Accurate;
+
     #ifdef Q_OS_WIN
-    m_ptrfrFileRef = new TagLib::FileRef(reinterpret_cast<const wchar_t*>(krqstrFilePath.constData()));
+    m_ptrfrFileRef = new TagLib::FileRef(reinterpret_cast<const wchar_t*>(krqstrFilePath.constData()), kbReadAudioProp, tlrsReadStyle);
     #else
-    m_ptrfrFileRef = new TagLib::FileRef(TagLib::FileName(krqstrFilePath.toUtf8()));
+    m_ptrfrFileRef = new TagLib::FileRef(TagLib::FileName(krqstrFilePath.toUtf8()), kbReadAudioProp, tlrsReadStyle);
     #endif
 
     if (m_ptrfrFileRef->isNull() == false)
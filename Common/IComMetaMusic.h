@@ -9,6 +9,10 @@
 class IComMetaMusic
 {
 public:
+    // How audio properties are read.  Working out the length and bitrate can mean scanning the frames of MP3 and FLAC files, which takes far
+    // longer than reading the tags, so ReadNone skips the audio properties when they aren't needed.  ReadAverage is TagLib's default
+    enum ReadStyle              {ReadNone, ReadFast, ReadAverage, ReadAccurate};
+
     // File object, also used to access audo properties
     TagLib::FileRef*            m_ptrfrFileRef;
 
@@ -18,8 +22,11 @@ public:
     // Audio info
     TagLib::AudioProperties*    m_ptlapAudioProp;
 
+    // Read style passed at construction, which is also used when the file is reopened
+    int                         m_iReadStyle;
+
 public:
-    IComMetaMusic(const QString & krqstrFilePath);
+    IComMetaMusic(const QString & krqstrFilePath, const int kiReadStyle = ReadAverage);
     ~IComMetaMusic();
 
 private:
@@ -1,23 +1,23 @@
 #ifndef IComSysSorts_h
 #define IComSysSorts_h
 
-#include <QTableWidgetSelectionRange>
+#include <QItemSelectionRange>
 
 
-struct IComTableWidgetSelectionSortAsc
+struct IComItemSelectionSortAsc
 {
-    inline bool operator() (const QTableWidgetSelectionRange & krqtwirSelection1, const QTableWidgetSelectionRange & krqtwirSelection2)
+    inline bool operator() (const QItemSelectionRange & krqisrSelection1, const QItemSelectionRange & krqisrSelection2)
     {
-        return (krqtwirSelection1.topRow() < krqtwirSelection2.topRow());
+        return (krqisrSelection1.top() < krqisrSelection2.top());
     }
 };
 
 
-struct IComTableWidgetSelectionSortDesc
+struct IComItemSelectionSortDesc
 {
-    inline bool operator() (const QTableWidgetSelectionRange & krqtwirSelection1, const QTableWidgetSelectionRange & krqtwirSelection2)
+    inline bool operator() (const QItemSelectionRange & krqisrSelection1, const QItemSelectionRange & krqisrSelection2)
     {
-        return (krqtwirSelection1.bottomRow() > krqtwirSelection2.bottomRow());
+        return (krqisrSelection1.bottom() > krqisrSelection2.bottom());
     }
 };
 
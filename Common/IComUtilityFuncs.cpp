@@ -2,11 +2,11 @@
 #include "IComUtilityFuncs.h"
 
 
-int IComUtilityFuncs::GetTableRowHeightFitToFont(QTableWidget* pqtwTable)
+int IComUtilityFuncs::GetTableRowHeightFitToFont(QTableView* pqtvTable)
 {
     const int kiMinRowHeight = 17;
 
-    QFontMetrics qfmFontMetrics(pqtwTable->font());
+    QFontMetrics qfmFontMetrics(pqtvTable->font());
     int iRowHeight = qfmFontMetrics.height()+2;
     if (iRowHeight < kiMinRowHeight)
         iRowHeight = kiMinRowHeight;
@@ -2,14 +2,14 @@
 #define IComUtilityFuncs_h
 
 #include <QUrl>
-class QTableWidget;
+class QTableView;
 
 
 class IComUtilityFuncs
 {
 public:
-    // Returns the row height to use for a QTableWidget based on the current font
-    static int GetTableRowHeightFitToFont(QTableWidget* pqtwTable);
+    // Returns the row height to use for a QTableView or QTableWidget based on the current font
+    static int GetTableRowHeightFitToFont(QTableView* pqtvTable);
 
     // Returns URL for My Computer on Windows - Other GUIDs are at: https://msdn.microsoft.com/en-us/library/windows/desktop/dd378457.aspx
     static QUrl GetMyComputerURL()  {return QUrl("clsid:0AC0837C-BBF8-452A-850D-79D08E667CA7");}
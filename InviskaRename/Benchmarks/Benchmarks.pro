@@ -0,0 +1,167 @@
+# Micro-benchmarks for generating preview names.  The model the renames read from depends on the rest of the application, so every source
+# except InviskaMain.cpp is built into the benchmark.  Build in release and run without a display using the offscreen platform:
+#   qmake CONFIG+=BuildRelease && make && ./release/benchren -platform offscreen
+
+QT += core gui widgets network concurrent testlib
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+
+TARGET = benchren
+
+INCLUDEPATH += .. ../../Common ../../../Libs/TagLib/include ../../../Libs/LibExif/include
+DEPENDPATH  += .. ../../Common ../../../Libs/TagLib/include ../../../Libs/LibExif/include
+
+LIBS += \
+    $$PWD/../../../Libs/TagLib/lib/libtag.a \
+    $$PWD/../../../Libs/LibExif/libexif/.libs/libexif.a
+
+DEFINES += TAGLIB_STATIC
+
+HEADERS += \
+    ../../Common/IComDlgFileProperties.h \
+    ../../Common/IComDlgHelpAbout.h \
+    ../../Common/IComDlgProgress.h \
+    ../../Common/IComMetaExif.h \
+    ../../Common/IComMetaMusic.h \
+    ../../Common/IComQLineEdit.h \
+    ../../Common/IComSysAbsoluteDay.h \
+    ../../Common/IComSysIniFilePath.h \
+    ../../Common/IComSysLatestVersion.h \
+    ../../Common/IComSysSingleInstance.h \
+    ../../Common/IComSysSorts.h \
+    ../../Common/IComUIMainWinBase.h \
+    ../../Common/IComUIMenuBarBase.h \
+    ../../Common/IComUIPrefGeneral.h \
+    ../../Common/IComUtilityFuncs.h \
+    ../../Common/IComWdgtMetaExif.h \
+    ../../Common/IComWdgtMetaMusic.h \
+    ../IDlgOrganiseMenu.h \
+    ../IDlgPreferences.h \
+    ../IDlgRenameErrorList.h \
+    ../IDlgRenameBase.h \
+    ../IDlgRenameFile.h \
+    ../IDlgRenameMenuItem.h \
+    ../IDlgSaveAction.h \
+    ../IMetaAttrib.h \
+    ../IMetaBase.h \
+    ../IMetaExif.h \
+    ../IMetaMusic.h \
+    ../IMetaStore.h \
+    ../IMetaTagLookup.h \
+    ../IRenameInvalidCharSub.h \
+    ../IRenameLegacySave.h \
+    ../IRenamePlan.h \
+    ../ISysDirEntry.h \
+    ../ISysDirEnumerator.h \
+    ../ISysDirWatcher.h \
+    ../ISysMetaCache.h \
+    ../ISysMetaReader.h \
+    ../ISysFileInfoSort.h \
+    ../ISysFileInfoSortClasses.h \
+    ../IUIFileList.h \
+    ../IUIFileListModel.h \
+    ../IUIMainWindow.h \
+    ../IUIMenuBar.h \
+    ../IUIMenuBookmarks.h \
+    ../IUIMenuRenames.h \
+    ../IUIMenuSavesBase.h \
+    ../IUIMenuTags.h \
+    ../IUIRenameFilter.h \
+    ../IUIRenameName.h \
+    ../IUIRenameNumber.h \
+    ../IUIRenameRegEx.h \
+    ../IUIRenameTabBase.h \
+    ../IUIRename.h \
+    ../IUISideBar.h \
+    ../IUIToolBar.h
+
+SOURCES += \
+    ../../Common/IComDlgFileProperties.cpp \
+    ../../Common/IComDlgHelpAbout.cpp \
+    ../../Common/IComDlgProgress.cpp \
+    ../../Common/IComMetaExif.cpp \
+    ../../Common/IComMetaMusic.cpp \
+    ../../Common/IComQLineEdit.cpp \
+    ../../Common/IComSysAbsoluteDay.cpp \
+    ../../Common/IComSysIniFilePath.cpp \
+    ../../Common/IComSysLatestVersion.cpp \
+    ../../Common/IComSysSingleInstance.cpp \
+    ../../Common/IComUIMainWinBase.cpp \
+    ../../Common/IComUIMenuBarBase.cpp \
+    ../../Common/IComUIPrefGeneral.cpp \
+    ../../Common/IComUtilityFuncs.cpp \
+    ../../Common/IComWdgtMetaExif.cpp \
+    ../../Common/IComWdgtMetaMusic.cpp \
+    ../IDlgOrganiseMenu.cpp \
+    ../IDlgPreferences.cpp \
+    ../IDlgRenameErrorList.cpp \
+    ../IDlgRenameBase.cpp \
+    ../IDlgRenameFile.cpp \
+    ../IDlgRenameMenuItem.cpp \
+    ../IDlgSaveAction.cpp \
+    ../IMetaAttrib.cpp \
+    ../IMetaBase.cpp \
+    ../IMetaExif.cpp \
+    ../IMetaMusic.cpp \
+    ../IMetaStore.cpp \
+    ../IMetaTagLookup.cpp \
+    ../IRenameInvalidCharSub.cpp \
+    ../IRenameLegacySave.cpp \
+    ../IRenamePlan.cpp \
+    ../ISysDirEnumerator.cpp \
+    ../ISysDirWatcher.cpp \
+    ../ISysMetaCache.cpp \
+    ../ISysMetaReader.cpp \
+    ../ISysFileInfoSort.cpp \
+    ../ISysFileInfoSortClasses.cpp \
+    ../IUIFileList.cpp \
+    ../IUIFileListModel.cpp \
+    ../IUIMainWindow.cpp \
+    ../IUIMenuBar.cpp \
+    ../IUIMenuBookmarks.cpp \
+    ../IUIMenuRenames.cpp \
+    ../IUIMenuSavesBase.cpp \
+    ../IUIMenuTags.cpp \
+    ../IUIRenameFilter.cpp \
+    ../IUIRenameName.cpp \
+    ../IUIRenameNumber.cpp \
+    ../IUIRenameRegEx.cpp \
+    ../IUIRenameTabBase.cpp \
+    ../IUIRename.cpp \
+    ../IUISideBar.cpp \
+    ../IUIToolBar.cpp \
+    IBenchRename.cpp
+
+FORMS += \
+    ../../Common/UIComPrefGeneral.ui \
+    ../UIPreferences.ui \
+    ../UIRenameName.ui \
+    ../UIRenameNumber.ui \
+    ../UIRenameRegEx.ui
+
+unix: {
+    # Required to avoid linker error with static TagLib on Mac and Linux
+    LIBS += -lz
+}
+
+DEFINES += \
+    QT_DEPRECATED_WARNINGS \
+    APP_VERSION=\"\\\"12.0\\\"\" \
+    APP_NAME=\"\\\"Inviska Rename\\\"\" \
+    APP_NAME_NO_SPACES=\"\\\"InviskaRename\\\"\"
+
+
+# For building release from command line - qmake CONFIG+=BuildRelease
+contains(CONFIG, BuildRelease) {
+    CONFIG -= debug_and_release
+    CONFIG -= debug
+    CONFIG += release
+
+    OUTPUTDIR = release
+    DESTDIR = $$OUTPUTDIR
+    OBJECTS_DIR = $$OUTPUTDIR
+    MOC_DIR = $$OUTPUTDIR
+    RCC_DIR = $$OUTPUTDIR
+    UI_DIR = $$OUTPUTDIR
+}
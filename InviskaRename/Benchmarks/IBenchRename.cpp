@@ -0,0 +1,320 @@
+#include <QtTest>
+#include "IMetaTagLookup.h"
+#include "IMetaAttrib.h"
+#include "IMetaMusic.h"
+#include "IRenamePlan.h"
+#include "IUIFileListModel.h"
+#include "ISysDirEntry.h"
+
+
+// Compares the current preview name generation code with the code it replaced, which is kept here as it was before it was replaced
+class IBenchRename : public QObject
+{
+    Q_OBJECT
+
+private:
+    // Number of rows the tag templates are rendered for
+    static const int                m_kiNumTagRows = 100000;
+
+    // Model with a Music record for every row, the tag lookup and the tagged text with the tags found in it
+    IUIFileListModel*               m_pflmFileModel;
+    IMetaTagLookup*                 m_pmtlMetaTagLookup;
+    QString                         m_qstrTagText;
+    QList<ITagInfo>                 m_qlstTags;
+
+    // Number of names converted by the case benchmarks, and the names, which are mostly ASCII with an occasional accented name
+    static const int                m_kiNumCaseNames = 1000000;
+    QStringList                     m_qstrlCaseNames;
+
+public:
+    IBenchRename();
+
+private:
+    // Finds the [$cat-code] tags in the passed text in the same way as IUIRenameTabBase::ReadTagCodes()
+    void ReadTagCodes(const QString & krqstrText, QList<ITagInfo> & rqlstTags);
+
+    // Replaced by ITagTemplate::Render()
+    QString ReplaceTagCodesWithValues(const QString & krqstrString, const QList<ITagInfo> & krqlstReplaceNameTags, const IUIFileListModel* kpflmFileModel, const int kiRow) const;
+
+    // Replaced by IRenamePlan::ConvertCase()
+    static void ConvertCaseOld(QString & rqstrName, const int kiCase);
+    static void ConvertNameToTitleCase(QString & rqstrName);
+
+    // Adds the case to convert to as the data for the case benchmarks
+    static void AddCaseData();
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void TagTextReplaceTagCodes();
+    void TagTextRenderTemplate();
+
+    void CaseConvertOld_data();
+    void CaseConvertOld();
+    void CaseConvertCurrent_data();
+    void CaseConvertCurrent();
+};
+
+
+IBenchRename::IBenchRename()
+{
+    m_pflmFileModel = nullptr;
+    m_pmtlMetaTagLookup = nullptr;
+}
+
+
+void IBenchRename::initTestCase()
+{
+    m_pmtlMetaTagLookup = new IMetaTagLookup;
+    m_pflmFileModel = new IUIFileListModel(nullptr);
+
+    ISysDirEntryList qvecdeEntries;
+    qvecdeEntries.reserve(m_kiNumTagRows);
+    ISysDirEntry deEntry;
+    deEntry.m_bIsFile = true;
+    for (int iRow = 0 ; iRow < m_kiNumTagRows ; ++iRow)
+    {
+        deEntry.m_qstrName = QString("%1 - Track %2.mp3").arg(iRow / 12).arg(iRow % 12 + 1, 2, 10, QChar('0'));
+        qvecdeEntries.append(deEntry);
+    }
+    m_pflmFileModel->SetEntryList(qvecdeEntries);
+
+    IMetaMusic mmuMusicMeta;
+    QStringList qstrlTagValues;
+    for (int iRow = 0 ; iRow < m_kiNumTagRows ; ++iRow)
+    {
+        qstrlTagValues.clear();
+        qstrlTagValues << QString("Track Title %1").arg(iRow) << QString("Artist %1").arg(iRow / 120) << QString("Album %1").arg(iRow / 12)
+                       << QString::number(iRow % 12 + 1) << QString::number(1970 + iRow % 50) << "Rock" << "" << "3:45" << "2" << "44100" << "320";
+        mmuMusicMeta.SetTagValues(qstrlTagValues);
+        m_pflmFileModel->SetMusicMeta(iRow, mmuMusicMeta);
+    }
+
+    m_qstrTagText = "[$mu-artist] - [$mu-album] ([$mu-year]) - [$mu-track] - [$mu-title]";
+    ReadTagCodes(m_qstrTagText, m_qlstTags);
+    QCOMPARE(m_qlstTags.size(), 5);
+
+    // Both versions must give the same result for the timings to be comparable
+    const ITagTemplate kttmpTemplate(m_qstrTagText, m_qlstTags);
+    for (int iRow = 0 ; iRow < m_kiNumTagRows ; iRow += 997)
+        QCOMPARE(kttmpTemplate.Render(m_pmtlMetaTagLookup, m_pflmFileModel, iRow), ReplaceTagCodesWithValues(m_qstrTagText, m_qlstTags, m_pflmFileModel, iRow));
+
+    const QStringList kqstrlCasePatterns = QStringList() << "the quick brown fox - track %1 (live)" << "IMG_%1 [Holiday].jpg"
+                                                         << "Artist Name - Album Name - %1 - Song Title" << "my.document,version %1;final"
+                                                         << "ALREADY UPPER CASE %1" << "Caf\xc3\xa9 del Mar - Volumen %1";
+    m_qstrlCaseNames.reserve(m_kiNumCaseNames);
+    for (int iName = 0 ; iName < m_kiNumCaseNames ; ++iName)
+    {
+        // One name in twenty has an accented character so the Unicode fallback is included in the same proportion
+        const int kiPattern = (iName % 20 == 19 ? kqstrlCasePatterns.size()-1 : iName % (kqstrlCasePatterns.size()-1));
+        m_qstrlCaseNames.append(kqstrlCasePatterns.at(kiPattern).arg(iName));
+    }
+
+    for (int iCase = IRenameOp::CaseTitle ; iCase <= IRenameOp::CaseUpper ; ++iCase)
+    {
+        for (int iName = 0 ; iName < 40 ; ++iName)
+        {
+            QString qstrOld = m_qstrlCaseNames.at(iName);
+            QString qstrCurrent = m_qstrlCaseNames.at(iName);
+            ConvertCaseOld(qstrOld, iCase);
+            IRenamePlan::ConvertCase(qstrCurrent, iCase);
+            QCOMPARE(qstrCurrent, qstrOld);
+        }
+    }
+}
+
+
+void IBenchRename::cleanupTestCase()
+{
+    delete m_pflmFileModel;
+    delete m_pmtlMetaTagLookup;
+}
+
+
+void IBenchRename::ReadTagCodes(const QString & krqstrText, QList<ITagInfo> & rqlstTags)
+{
+    rqlstTags.clear();
+    ITagInfo tagiTagInfo;
+    int iSearchStart = 0;
+    while (true)
+    {
+        tagiTagInfo.m_iStartIndex = krqstrText.indexOf("[$", iSearchStart);
+        if (tagiTagInfo.m_iStartIndex == -1)
+            return;
+
+        const int kiSeparatorIndex = krqstrText.indexOf('-', tagiTagInfo.m_iStartIndex);
+        tagiTagInfo.m_iEndIndex = krqstrText.indexOf(']', kiSeparatorIndex);
+        if (kiSeparatorIndex == -1 || tagiTagInfo.m_iEndIndex == -1)
+            return;
+
+        const QString kqstrCategory = krqstrText.mid(tagiTagInfo.m_iStartIndex+2, kiSeparatorIndex - tagiTagInfo.m_iStartIndex - 2);
+        const QString kqstrTagCode = krqstrText.mid(kiSeparatorIndex+1, tagiTagInfo.m_iEndIndex - kiSeparatorIndex - 1);
+        m_pmtlMetaTagLookup->LookupTag(tagiTagInfo, kqstrCategory, kqstrTagCode);
+        if (tagiTagInfo.m_iTagID != ITagInfo::Invalid)
+            rqlstTags.append(tagiTagInfo);
+
+        iSearchStart = tagiTagInfo.m_iEndIndex+1;
+    }
+}
+
+
+QString IBenchRename::ReplaceTagCodesWithValues(const QString & krqstrString, const QList<ITagInfo> & krqlstReplaceNameTags, const IUIFileListModel* kpflmFileModel, const int kiRow) const
+{
+    const int kiAttribValueLength = 19;
+
+    // Music and Exif values are references into the model's meta store, so the only allocation is the result, which is sized up front.
+    // File attribute values are formatted from the file's timestamps so they're worked out as they're appended
+    int iLength = krqstrString.length();
+    QList<ITagInfo>::const_iterator kitTagInfo;
+    for (kitTagInfo = krqlstReplaceNameTags.constBegin() ; kitTagInfo != krqlstReplaceNameTags.constEnd() ; ++kitTagInfo)
+    {
+        iLength -= kitTagInfo->m_iEndIndex - kitTagInfo->m_iStartIndex + 1;
+        iLength += (kitTagInfo->m_tcatCatagory == ITagInfo::Attrib ? kiAttribValueLength : m_pmtlMetaTagLookup->GetStoredValueForTagCode(kpflmFileModel, kiRow, *kitTagInfo).length());
+    }
+
+    QString qstrSubstituted;
+    qstrSubstituted.reserve(iLength);
+
+    int iSubStringStart = 0;
+    for (kitTagInfo = krqlstReplaceNameTags.constBegin() ; kitTagInfo != krqlstReplaceNameTags.constEnd() ; ++kitTagInfo)
+    {
+        qstrSubstituted += krqstrString.midRef(iSubStringStart, kitTagInfo->m_iStartIndex - iSubStringStart);
+
+        if (kitTagInfo->m_tcatCatagory == ITagInfo::Attrib)
+            qstrSubstituted += IMetaAttrib::GetTagValue(kpflmFileModel->GetFileInfo(kiRow), kitTagInfo->m_iTagID);
+        else
+            qstrSubstituted += m_pmtlMetaTagLookup->GetStoredValueForTagCode(kpflmFileModel, kiRow, *kitTagInfo);
+
+        iSubStringStart = kitTagInfo->m_iEndIndex+1;
+    }
+
+    if (iSubStringStart < krqstrString.length())
+        qstrSubstituted += krqstrString.midRef(iSubStringStart);
+
+    return qstrSubstituted;
+}
+
+
+void IBenchRename::TagTextReplaceTagCodes()
+{
+    qint64 i64TotalLength = 0;
+    QBENCHMARK
+    {
+        for (int iRow = 0 ; iRow < m_kiNumTagRows ; ++iRow)
+            i64TotalLength += ReplaceTagCodesWithValues(m_qstrTagText, m_qlstTags, m_pflmFileModel, iRow).length();
+    }
+    QVERIFY(i64TotalLength > 0);
+}
+
+
+void IBenchRename::TagTextRenderTemplate()
+{
+    // The template is compiled once when the rename plan is built, so compiling it is included in the timing for a fair comparison
+    qint64 i64TotalLength = 0;
+    QBENCHMARK
+    {
+        const ITagTemplate kttmpTemplate(m_qstrTagText, m_qlstTags);
+        for (int iRow = 0 ; iRow < m_kiNumTagRows ; ++iRow)
+            i64TotalLength += kttmpTemplate.Render(m_pmtlMetaTagLookup, m_pflmFileModel, iRow).length();
+    }
+    QVERIFY(i64TotalLength > 0);
+}
+
+
+void IBenchRename::ConvertCaseOld(QString & rqstrName, const int kiCase)
+{
+    switch (kiCase)
+    {
+    case IRenameOp::CaseTitle       :   ConvertNameToTitleCase(rqstrName);
+                                        break;
+
+    case IRenameOp::CaseSentance    :   rqstrName = rqstrName.toLower();
+                                        rqstrName[0] = rqstrName.at(0).toUpper();
+                                        break;
+
+    case IRenameOp::CaseLower       :   rqstrName = rqstrName.toLower();
+                                        break;
+
+    case IRenameOp::CaseUpper       :   rqstrName = rqstrName.toUpper();
+                                        break;
+    }
+}
+
+
+void IBenchRename::ConvertNameToTitleCase(QString & rqstrName)
+{
+    QString qstrWordBreakChars = " -()[]{}.,;:/\\";
+    rqstrName = rqstrName.toLower();
+    rqstrName[0] = rqstrName[0].toUpper();
+
+    int iLength = rqstrName.length();
+    for (int iIndex = 1 ; iIndex < iLength ; ++iIndex)
+    {
+        if (qstrWordBreakChars.contains(rqstrName[iIndex-1]))
+            rqstrName[iIndex] = rqstrName[iIndex].toUpper();
+    }
+}
+
+
+void IBenchRename::AddCaseData()
+{
+    QTest::addColumn<int>("iCase");
+    QTest::newRow("Title")      << static_cast<int>(IRenameOp::CaseTitle);
+    QTest::newRow("Sentence")   << static_cast<int>(IRenameOp::CaseSentance);
+    QTest::newRow("Lower")      << static_cast<int>(IRenameOp::CaseLower);
+    QTest::newRow("Upper")      << static_cast<int>(IRenameOp::CaseUpper);
+}
+
+
+void IBenchRename::CaseConvertOld_data()
+{
+    AddCaseData();
+}
+
+
+void IBenchRename::CaseConvertOld()
+{
+    // Each name is converted from a shared copy of the original, so both versions start from the same state on every pass
+    QFETCH(int, iCase);
+    qint64 i64TotalLength = 0;
+    QBENCHMARK
+    {
+        QStringList::const_iterator kitName;
+        for (kitName = m_qstrlCaseNames.constBegin() ; kitName != m_qstrlCaseNames.constEnd() ; ++kitName)
+        {
+            QString qstrName = *kitName;
+            ConvertCaseOld(qstrName, iCase);
+            i64TotalLength += qstrName.length();
+        }
+    }
+    QVERIFY(i64TotalLength > 0);
+}
+
+
+void IBenchRename::CaseConvertCurrent_data()
+{
+    AddCaseData();
+}
+
+
+void IBenchRename::CaseConvertCurrent()
+{
+    QFETCH(int, iCase);
+    qint64 i64TotalLength = 0;
+    QBENCHMARK
+    {
+        QStringList::const_iterator kitName;
+        for (kitName = m_qstrlCaseNames.constBegin() ; kitName != m_qstrlCaseNames.constEnd() ; ++kitName)
+        {
+            QString qstrName = *kitName;
+            IRenamePlan::ConvertCase(qstrName, iCase);
+            i64TotalLength += qstrName.length();
+        }
+    }
+    QVERIFY(i64TotalLength > 0);
+}
+
+
+QTEST_MAIN(IBenchRename)
+#include "IBenchRename.moc"
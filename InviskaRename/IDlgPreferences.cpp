@@ -139,6 +139,7 @@ void IDlgPreferences::SetWidgetStates()
 
     m_pqcbShowSideBar->setChecked(m_pmwMainWindow->SideBarEnabled());
     m_pqcbAutoRefreshEnabled->setChecked(puifmFileList->AutoRefreshEnabled());
+    m_pqsbAutoRefreshWindowMS->setValue(puifmFileList->GetAutoRefreshWindow());
     m_pqcbSaveSortOrder->setChecked(puifmFileList->SaveSortOrder());
     m_pqcbOpenFileWhenDblClicked->setChecked(puifmFileList->OpenFileWhenDblClicked());
     m_qcolNameChangeTextColour = puifmFileList->GetNameChangeTextColour();
@@ -203,6 +204,7 @@ bool IDlgPreferences::SaveSettings()
     m_rqsetSettings.beginGroup("FileList");
     m_rqsetSettings.setValue("ShowSideBar", m_pqcbShowSideBar->isChecked());
     m_rqsetSettings.setValue("AutoRefreshDirectories", m_pqcbAutoRefreshEnabled->isChecked());
+    m_rqsetSettings.setValue("AutoRefreshWindowMS", m_pqsbAutoRefreshWindowMS->value());
     m_rqsetSettings.setValue("SaveSortOrder", m_pqcbSaveSortOrder->isChecked());
     m_rqsetSettings.setValue("OpenFileWhenDblClicked", m_pqcbOpenFileWhenDblClicked->isChecked());
     m_rqsetSettings.setValue("NameChangeColourText", m_pqcbNameChangeColourText->isChecked());
@@ -255,6 +257,7 @@ void IDlgPreferences::ProcessChanges()
 
     m_pmwMainWindow->SetSideBarEnabled(m_pqcbShowSideBar->isChecked());
     puifmFileList->SetAutoRefreshEnabled(m_pqcbAutoRefreshEnabled->isChecked());
+    puifmFileList->SetAutoRefreshWindow(m_pqsbAutoRefreshWindowMS->value());
     puifmFileList->SetSaveSortOrder(m_pqcbSaveSortOrder->isChecked());
     puifmFileList->SetOpenFileWhenDblClicked(m_pqcbOpenFileWhenDblClicked->isChecked());
     puifmFileList->SetHighlightSettings(m_pqcbNameChangeColourText->isChecked(), m_qcolNameChangeTextColour, m_pqcbNameChangeHighlightRow->isChecked(), m_qcolNameChangeHighlightColour);
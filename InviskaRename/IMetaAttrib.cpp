@@ -1,7 +1,5 @@
-#include <QTableWidgetItem>
 #include <QFileInfo>
 #include <QDateTime>
-#include "IUIFileList.h"
 #include "IMetaAttrib.h"
 #include "IMetaTagLookup.h"
 #include "IMetaBase.h"
@@ -35,11 +33,10 @@ void IMetaAttrib::InitTagLookupHash()
 }
 
 
-QString IMetaAttrib::GetTagValue(const QTableWidgetItem* kpqtwiFileItem, const int kiTagID)
+QString IMetaAttrib::GetTagValue(const QFileInfo & krqfiFileInfo, const int kiTagID)
 {
-    if (kpqtwiFileItem->data(IUIFileList::FileInfo).isNull())
+    if (krqfiFileInfo.filePath().isEmpty())
         return QString();
-    const QFileInfo & krqfiFileInfo = kpqtwiFileItem->data(IUIFileList::FileInfo).value<QFileInfo>();
 
     switch (kiTagID)
     {
@@ -2,7 +2,7 @@
 #define IMetaAttrib_h
 
 #include <QHash>
-class QTableWidgetItem;
+class QFileInfo;
 
 
 class IMetaAttrib
@@ -21,7 +21,7 @@ public:
     static void InitTagLookupHash();
 
     // Returns tag value for passed tag ID
-    static QString GetTagValue(const QTableWidgetItem* kpqtwiFileItem, const int kiTagID);
+    static QString GetTagValue(const QFileInfo & krqfiFileInfo, const int kiTagID);
 
     // Returns tag ID from MusicTagsIDs enum or ITagInfo::Invalid if passed tag string is invalid
     static int GetTagID(const QString & krqstrTagCode);
@@ -12,6 +12,7 @@ IMetaBase::IMetaBase()
 {
     m_prgqstrTagValues = nullptr;
     m_piReferenceCount = nullptr;
+    m_iNumTags = 0;
 }
 
 
@@ -20,6 +21,7 @@ IMetaBase::IMetaBase(const int kiNumElements)
     m_prgqstrTagValues = new QString[static_cast<unsigned long long>(kiNumElements)];
     m_piReferenceCount = new int;
     *m_piReferenceCount = 1;
+    m_iNumTags = kiNumElements;
 }
 
 
@@ -27,11 +29,33 @@ IMetaBase::IMetaBase(const IMetaBase & krmbaCopyMe)
 {
     m_piReferenceCount = krmbaCopyMe.m_piReferenceCount;
     m_prgqstrTagValues = krmbaCopyMe.m_prgqstrTagValues;
-    ++(*m_piReferenceCount);
+    m_iNumTags = krmbaCopyMe.m_iNumTags;
+    if (m_piReferenceCount != nullptr)
+        ++(*m_piReferenceCount);
 }
 
 
 IMetaBase::~IMetaBase()
+{
+    Release();
+}
+
+
+IMetaBase & IMetaBase::operator=(const IMetaBase & krmbaCopyMe)
+{
+    // The reference is added first so assigning an object to itself doesn't delete the array
+    if (krmbaCopyMe.m_piReferenceCount != nullptr)
+        ++(*krmbaCopyMe.m_piReferenceCount);
+    Release();
+
+    m_piReferenceCount = krmbaCopyMe.m_piReferenceCount;
+    m_prgqstrTagValues = krmbaCopyMe.m_prgqstrTagValues;
+    m_iNumTags = krmbaCopyMe.m_iNumTags;
+    return *this;
+}
+
+
+void IMetaBase::Release()
 {
     if (m_piReferenceCount != nullptr)
     {
@@ -51,6 +75,30 @@ QString IMetaBase::GetTagValue(const int kiTagID) const
 }
 
 
+QStringList IMetaBase::GetTagValues() const
+{
+    QStringList qstrlTagValues;
+    qstrlTagValues.reserve(m_iNumTags);
+    for (int iTagID = 0 ; iTagID < m_iNumTags ; ++iTagID)
+        qstrlTagValues.append(m_prgqstrTagValues[iTagID]);
+    return qstrlTagValues;
+}
+
+
+void IMetaBase::SetTagValues(const QStringList & krqstrlTagValues)
+{
+    // Other objects may share the current array, so a new one is always allocated
+    Release();
+
+    m_iNumTags = krqstrlTagValues.size();
+    m_prgqstrTagValues = new QString[static_cast<unsigned long long>(m_iNumTags)];
+    m_piReferenceCount = new int;
+    *m_piReferenceCount = 1;
+    for (int iTagID = 0 ; iTagID < m_iNumTags ; ++iTagID)
+        m_prgqstrTagValues[iTagID] = krqstrlTagValues.at(iTagID);
+}
+
+
 
 bool IMetaBase::SetSeparators(const QChar & krqchDate, const QChar & krqchTime, const QChar & krqchFraction)
 {
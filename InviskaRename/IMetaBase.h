@@ -2,6 +2,8 @@
 #define IMetaBase_h
 
 #include <QObject>
+#include <QStringList>
+#include <QBitArray>
 
 
 class IMetaBase
@@ -13,6 +15,9 @@ protected:
     // Number of objects referencing the tag value array so it's not deleted until it's unreferenced
     int*                                m_piReferenceCount;
 
+    // Number of elements in the tag value array
+    int                                 m_iNumTags;
+
     // Separators to use in substituted tag values
     static QChar                        m_qchSeparatorDate;
     static QChar                        m_qchSeparatorTime;
@@ -24,9 +29,19 @@ public:
     IMetaBase(const IMetaBase & krmbaCopyMe);
     virtual ~IMetaBase();
 
+    // Shares the tag value array of the passed object, releasing the current one
+    IMetaBase & operator=(const IMetaBase & krmbaCopyMe);
+
     // Returns tag value for passed tag ID
     virtual QString GetTagValue(const int kiTagID) const;
 
+    // Returns number of elements in the tag value array
+    int GetNumTags() const                                                      {return m_iNumTags;}
+
+    // Returns all tag values in tag ID order, or replaces them with the passed values, which is used to store and restore tags in the meta cache
+    QStringList GetTagValues() const;
+    void SetTagValues(const QStringList & krqstrlTagValues);
+
     // Separators accessors
     static QChar &  GetSeparatorDate()                                          {return m_qchSeparatorDate;}
     static QChar &  GetSeparatorTime()                                          {return m_qchSeparatorTime;}
@@ -35,6 +50,10 @@ public:
     static void     SetSeparatorTime(const QChar & krqchSeparatorTime)          {m_qchSeparatorTime = krqchSeparatorTime;}
     static void     SetSeparatorFraction(const QChar & krqchSeparatorFraction)  {m_qchSeparatorFraction = krqchSeparatorFraction;}
     static bool     SetSeparators(const QChar & krqchDate, const QChar & krqchTime, const QChar & krqchFraction);
+
+private:
+    // Releases this object's reference to the tag value array, deleting it if it's no longer referenced
+    void Release();
 };
 
 Q_DECLARE_METATYPE(IMetaBase)
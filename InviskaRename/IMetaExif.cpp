@@ -11,12 +11,13 @@ IMetaExif::IMetaExif() : IMetaBase()
 }
 
 
-IMetaExif::IMetaExif(IComMetaExif* pmexExifMeta, const IRenameInvalidCharSub & kricsInvalidCharSub, const bool kbAdvancedMode) : IMetaBase(kbAdvancedMode ? NumTagsAdvanced : NumTagsBasic)
+IMetaExif::IMetaExif(IComMetaExif* pmexExifMeta, const IRenameInvalidCharSub & kricsInvalidCharSub, const bool kbAdvancedMode, const QBitArray & krqbtaRequiredTags) :
+                     IMetaBase(kbAdvancedMode ? NumTagsAdvanced : NumTagsBasic)
 {
-    if (kbAdvancedMode)
-        ReadTagsAdvanced(pmexExifMeta, kricsInvalidCharSub);
+    if (krqbtaRequiredTags.isEmpty())
+        ReadTags(pmexExifMeta, kricsInvalidCharSub, QBitArray(m_iNumTags, true));
     else
-        ReadTagsBasic(pmexExifMeta, kricsInvalidCharSub);
+        ReadTags(pmexExifMeta, kricsInvalidCharSub, krqbtaRequiredTags);
 }
 
 
@@ -114,96 +115,105 @@ void IMetaExif::InitTagLookupHashAdvanced()
 }
 
 
-void IMetaExif::ReadTagsBasic(IComMetaExif* pmexExifMeta, const IRenameInvalidCharSub & kricsInvalidCharSub)
+void IMetaExif::ReadTags(IComMetaExif* pmexExifMeta, const IRenameInvalidCharSub & kricsInvalidCharSub, const QBitArray & krqbtaRequiredTags)
 {
-    QString qstrDateTime                        = GetDateTimeSeparatorSub(pmexExifMeta);
-    m_prgqstrTagValues[DateTime]                = qstrDateTime;
-    m_prgqstrTagValues[Date]                    = qstrDateTime.left(10);
-    m_prgqstrTagValues[Time]                    = qstrDateTime.mid(11, 9);
-    m_prgqstrTagValues[DateYYYY]                = qstrDateTime.left(4);
-    m_prgqstrTagValues[DateYY]                  = qstrDateTime.mid(2, 2);
-    m_prgqstrTagValues[DateMM]                  = qstrDateTime.mid(5, 2);
-    m_prgqstrTagValues[DateDD]                  = qstrDateTime.mid(8, 2);
-    m_prgqstrTagValues[TimeHH]                  = qstrDateTime.mid(11, 2);
-    m_prgqstrTagValues[TimeMM]                  = qstrDateTime.mid(14, 2);
-    m_prgqstrTagValues[TimeSS]                  = qstrDateTime.mid(17, 2);
-    m_prgqstrTagValues[TimeSubSec]              = GetTimeSubSec3Digit(pmexExifMeta);
-
-    m_prgqstrTagValues[CameraMake]              = pmexExifMeta->GetValue(   EXIF_IFD_0,                 EXIF_TAG_MAKE);
-    m_prgqstrTagValues[CameraModel]             = GetValueInvalidCharSub(   EXIF_IFD_0,                 EXIF_TAG_MODEL,                     pmexExifMeta,       kricsInvalidCharSub);
-    m_prgqstrTagValues[FNumber]                 = GetFNumberWithoutUnit(pmexExifMeta);
-    m_prgqstrTagValues[ISOSpeed]                = pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_ISO_SPEED_RATINGS);
-    m_prgqstrTagValues[ExposureTime]            = GetExposureTime(pmexExifMeta);
-    m_prgqstrTagValues[ExposureTimeDec]         = GetExposureTimeDecimal(pmexExifMeta);
-    m_prgqstrTagValues[FocalLength]             = GetFocalLengthWithoutUnit(EXIF_IFD_EXIF,              EXIF_TAG_FOCAL_LENGTH,              pmexExifMeta);
-    m_prgqstrTagValues[FocalLengthIn35mm]       = GetFocalLengthWithoutUnit(EXIF_IFD_EXIF,              EXIF_TAG_FOCAL_LENGTH_IN_35MM_FILM, pmexExifMeta);
-    m_prgqstrTagValues[Program]                 = pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_EXPOSURE_PROGRAM);
-    m_prgqstrTagValues[PixelDimX]               = pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_PIXEL_X_DIMENSION);
-    m_prgqstrTagValues[PixelDimY]               = pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_PIXEL_Y_DIMENSION);
+    // Only the tags used by the current rename are read, as reading every tag in advanced mode significantly increases load time
+    for (int iTagID = 0 ; iTagID < m_iNumTags ; ++iTagID)
+    {
+        if (krqbtaRequiredTags.testBit(iTagID))
+            m_prgqstrTagValues[iTagID] = ReadTagValue(iTagID, pmexExifMeta, kricsInvalidCharSub);
+    }
 }
 
 
-void IMetaExif::ReadTagsAdvanced(IComMetaExif* pmexExifMeta, const IRenameInvalidCharSub & kricsInvalidCharSub)
+QString IMetaExif::ReadTagValue(const int kiTagID, IComMetaExif* pmexExifMeta, const IRenameInvalidCharSub & kricsInvalidCharSub)
 {
-    ReadTagsBasic(pmexExifMeta, kricsInvalidCharSub);
-
-    m_prgqstrTagValues[Software]                = pmexExifMeta->GetValue(   EXIF_IFD_0,                 EXIF_TAG_SOFTWARE);
-
-    m_prgqstrTagValues[DigitalZoomRatio]        = pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_DIGITAL_ZOOM_RATIO);
-    m_prgqstrTagValues[Flash]                   = pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_FLASH);
-    m_prgqstrTagValues[Orientation]             = pmexExifMeta->GetValue(   EXIF_IFD_0,                 EXIF_TAG_ORIENTATION);
-
-    m_prgqstrTagValues[ShutterSpeedValue]       = GetValueReplaceSlash(     EXIF_IFD_EXIF,              EXIF_TAG_SHUTTER_SPEED_VALUE,       pmexExifMeta);
-    m_prgqstrTagValues[ExposureBiasValue]       = pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_EXPOSURE_BIAS_VALUE);
-    m_prgqstrTagValues[BrightnessValue]         = GetValueReplaceSlash(     EXIF_IFD_EXIF,              EXIF_TAG_BRIGHTNESS_VALUE,          pmexExifMeta);
-    m_prgqstrTagValues[ApertureValue]           = GetValueReplaceSlash(     EXIF_IFD_EXIF,              EXIF_TAG_APERTURE_VALUE,            pmexExifMeta);
-    m_prgqstrTagValues[MaxApertureValue]        = GetValueReplaceSlash(     EXIF_IFD_EXIF,              EXIF_TAG_MAX_APERTURE_VALUE,        pmexExifMeta);
-    m_prgqstrTagValues[SceneCaptureType]        = pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_SCENE_CAPTURE_TYPE);
-    m_prgqstrTagValues[CustomRendered]          = pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_CUSTOM_RENDERED);
-    m_prgqstrTagValues[ExposureMode]            = pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_EXPOSURE_MODE);
-    m_prgqstrTagValues[WhiteBalance]            = pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_WHITE_BALANCE);
-    m_prgqstrTagValues[GainControl]             = pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_GAIN_CONTROL);
-    m_prgqstrTagValues[Contrast]                = pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_CONTRAST);
-    m_prgqstrTagValues[Saturation]              = pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_SATURATION);
-    m_prgqstrTagValues[Sharpness]               = pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_SHARPNESS);
-    m_prgqstrTagValues[MeteringMode]            = pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_METERING_MODE);
-    m_prgqstrTagValues[LightSource]             = pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_LIGHT_SOURCE);
-    m_prgqstrTagValues[FocalPlaneXResolution]   = pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_FOCAL_PLANE_X_RESOLUTION);
-    m_prgqstrTagValues[FocalPlaneYResolution]   = pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_FOCAL_PLANE_Y_RESOLUTION);
-    m_prgqstrTagValues[FocalPlaneResolutionUnit]= pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_FOCAL_PLANE_RESOLUTION_UNIT);
-    m_prgqstrTagValues[SubjectDistanceRange]    = pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_SUBJECT_DISTANCE_RANGE);
-    m_prgqstrTagValues[SensingMethod]           = pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_SENSING_METHOD);
-    m_prgqstrTagValues[SceneType]               = pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_SCENE_TYPE);
-
-    m_prgqstrTagValues[ColorSpace]              = pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_COLOR_SPACE);
-    m_prgqstrTagValues[Compression]             = pmexExifMeta->GetValue(   EXIF_IFD_1,                 EXIF_TAG_COMPRESSION);
-    m_prgqstrTagValues[ComponentsConfiguration] = pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_COMPONENTS_CONFIGURATION);
-    m_prgqstrTagValues[CompressedBitsPerPixel]  = pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_COMPRESSED_BITS_PER_PIXEL);
-    m_prgqstrTagValues[YCbCrPositioning]        = pmexExifMeta->GetValue(   EXIF_IFD_0,                 EXIF_TAG_YCBCR_POSITIONING);
-    m_prgqstrTagValues[XResolution]             = pmexExifMeta->GetValue(   EXIF_IFD_1,                 EXIF_TAG_X_RESOLUTION);
-    m_prgqstrTagValues[YResolution]             = pmexExifMeta->GetValue(   EXIF_IFD_1,                 EXIF_TAG_Y_RESOLUTION);
-    m_prgqstrTagValues[ResolutionUnit]          = pmexExifMeta->GetValue(   EXIF_IFD_1,                 EXIF_TAG_RESOLUTION_UNIT);
-    m_prgqstrTagValues[FileSource]              = pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_FILE_SOURCE);
-    m_prgqstrTagValues[ExifVersion]             = pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_EXIF_VERSION);
-    m_prgqstrTagValues[FlashPixVersion]         = pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_FLASH_PIX_VERSION);
-    m_prgqstrTagValues[InteroperabilityIndex]   = pmexExifMeta->GetValue(   EXIF_IFD_INTEROPERABILITY,  EXIF_TAG_INTEROPERABILITY_INDEX);
-    m_prgqstrTagValues[InteroperabilityVersion] = pmexExifMeta->GetValue(   EXIF_IFD_INTEROPERABILITY,  EXIF_TAG_INTEROPERABILITY_VERSION);
-
-    m_prgqstrTagValues[Title]                   = GetValueInvalidCharSub(   EXIF_IFD_0,                 EXIF_TAG_XP_TITLE,                  pmexExifMeta,       kricsInvalidCharSub);
-    m_prgqstrTagValues[Subject]                 = GetValueInvalidCharSub(   EXIF_IFD_0,                 EXIF_TAG_XP_SUBJECT,                pmexExifMeta,       kricsInvalidCharSub);
-    m_prgqstrTagValues[Author]                  = GetValueInvalidCharSub(   EXIF_IFD_0,                 EXIF_TAG_XP_AUTHOR,                 pmexExifMeta,       kricsInvalidCharSub);
-    m_prgqstrTagValues[Comment]                 = GetValueInvalidCharSub(   EXIF_IFD_0,                 EXIF_TAG_XP_COMMENT,                pmexExifMeta,       kricsInvalidCharSub);
-    m_prgqstrTagValues[Keywords]                = GetValueInvalidCharSub(   EXIF_IFD_0,                 EXIF_TAG_XP_KEYWORDS,               pmexExifMeta,       kricsInvalidCharSub);
-    m_prgqstrTagValues[Copyright]               = GetValueInvalidCharSub(   EXIF_IFD_0,                 EXIF_TAG_COPYRIGHT,                 pmexExifMeta,       kricsInvalidCharSub);
-
-    m_prgqstrTagValues[GPSLatitude]             = pmexExifMeta->GetValue(   EXIF_IFD_GPS,               static_cast<ExifTag>(EXIF_TAG_GPS_LATITUDE));
-    m_prgqstrTagValues[GPSLatitudeRef]          = pmexExifMeta->GetValue(   EXIF_IFD_GPS,               static_cast<ExifTag>(EXIF_TAG_GPS_LATITUDE_REF));
-    m_prgqstrTagValues[GPSLongitude]            = pmexExifMeta->GetValue(   EXIF_IFD_GPS,               static_cast<ExifTag>(EXIF_TAG_GPS_LONGITUDE));
-    m_prgqstrTagValues[GPSLongitudeRef]         = pmexExifMeta->GetValue(   EXIF_IFD_GPS,               static_cast<ExifTag>(EXIF_TAG_GPS_LONGITUDE_REF));
-    m_prgqstrTagValues[GPSAltitude]             = pmexExifMeta->GetValue(   EXIF_IFD_GPS,               static_cast<ExifTag>(EXIF_TAG_GPS_ALTITUDE));
-    m_prgqstrTagValues[GPSAltitudeRef]          = pmexExifMeta->GetValue(   EXIF_IFD_GPS,               static_cast<ExifTag>(EXIF_TAG_GPS_ALTITUDE_REF));
-    m_prgqstrTagValues[GPSDateStamp]            = GetGPSDateSeparatorSub(pmexExifMeta);
-    m_prgqstrTagValues[GPSTimeStamp]            = GetGPSTimeSeparatorSub(pmexExifMeta);
+    switch (kiTagID)
+    {
+    case DateTime:                   return GetDateTimeSeparatorSub(pmexExifMeta);
+    case Date:                       return GetDateTimeSeparatorSub(pmexExifMeta).left(10);
+    case Time:                       return GetDateTimeSeparatorSub(pmexExifMeta).mid(11, 9);
+    case DateYYYY:                   return GetDateTimeSeparatorSub(pmexExifMeta).left(4);
+    case DateYY:                     return GetDateTimeSeparatorSub(pmexExifMeta).mid(2, 2);
+    case DateMM:                     return GetDateTimeSeparatorSub(pmexExifMeta).mid(5, 2);
+    case DateDD:                     return GetDateTimeSeparatorSub(pmexExifMeta).mid(8, 2);
+    case TimeHH:                     return GetDateTimeSeparatorSub(pmexExifMeta).mid(11, 2);
+    case TimeMM:                     return GetDateTimeSeparatorSub(pmexExifMeta).mid(14, 2);
+    case TimeSS:                     return GetDateTimeSeparatorSub(pmexExifMeta).mid(17, 2);
+    case TimeSubSec:                 return GetTimeSubSec3Digit(pmexExifMeta);
+
+    case CameraMake:                 return pmexExifMeta->GetValue(   EXIF_IFD_0,                 EXIF_TAG_MAKE);
+    case CameraModel:                return GetValueInvalidCharSub(   EXIF_IFD_0,                 EXIF_TAG_MODEL,                     pmexExifMeta,       kricsInvalidCharSub);
+    case FNumber:                    return GetFNumberWithoutUnit(pmexExifMeta);
+    case ISOSpeed:                   return pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_ISO_SPEED_RATINGS);
+    case ExposureTime:               return GetExposureTime(pmexExifMeta);
+    case ExposureTimeDec:            return GetExposureTimeDecimal(pmexExifMeta);
+    case FocalLength:                return GetFocalLengthWithoutUnit(EXIF_IFD_EXIF,              EXIF_TAG_FOCAL_LENGTH,              pmexExifMeta);
+    case FocalLengthIn35mm:          return GetFocalLengthWithoutUnit(EXIF_IFD_EXIF,              EXIF_TAG_FOCAL_LENGTH_IN_35MM_FILM, pmexExifMeta);
+    case Program:                    return pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_EXPOSURE_PROGRAM);
+    case PixelDimX:                  return pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_PIXEL_X_DIMENSION);
+    case PixelDimY:                  return pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_PIXEL_Y_DIMENSION);
+
+    case Software:                   return pmexExifMeta->GetValue(   EXIF_IFD_0,                 EXIF_TAG_SOFTWARE);
+
+    case DigitalZoomRatio:           return pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_DIGITAL_ZOOM_RATIO);
+    case Flash:                      return pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_FLASH);
+    case Orientation:                return pmexExifMeta->GetValue(   EXIF_IFD_0,                 EXIF_TAG_ORIENTATION);
+
+    case ShutterSpeedValue:          return GetValueReplaceSlash(     EXIF_IFD_EXIF,              EXIF_TAG_SHUTTER_SPEED_VALUE,       pmexExifMeta);
+    case ExposureBiasValue:          return pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_EXPOSURE_BIAS_VALUE);
+    case BrightnessValue:            return GetValueReplaceSlash(     EXIF_IFD_EXIF,              EXIF_TAG_BRIGHTNESS_VALUE,          pmexExifMeta);
+    case ApertureValue:              return GetValueReplaceSlash(     EXIF_IFD_EXIF,              EXIF_TAG_APERTURE_VALUE,            pmexExifMeta);
+    case MaxApertureValue:           return GetValueReplaceSlash(     EXIF_IFD_EXIF,              EXIF_TAG_MAX_APERTURE_VALUE,        pmexExifMeta);
+    case SceneCaptureType:           return pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_SCENE_CAPTURE_TYPE);
+    case CustomRendered:             return pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_CUSTOM_RENDERED);
+    case ExposureMode:               return pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_EXPOSURE_MODE);
+    case WhiteBalance:               return pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_WHITE_BALANCE);
+    case GainControl:                return pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_GAIN_CONTROL);
+    case Contrast:                   return pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_CONTRAST);
+    case Saturation:                 return pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_SATURATION);
+    case Sharpness:                  return pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_SHARPNESS);
+    case MeteringMode:               return pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_METERING_MODE);
+    case LightSource:                return pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_LIGHT_SOURCE);
+    case FocalPlaneXResolution:      return pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_FOCAL_PLANE_X_RESOLUTION);
+    case FocalPlaneYResolution:      return pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_FOCAL_PLANE_Y_RESOLUTION);
+    case FocalPlaneResolutionUnit:   return pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_FOCAL_PLANE_RESOLUTION_UNIT);
+    case SubjectDistanceRange:       return pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_SUBJECT_DISTANCE_RANGE);
+    case SensingMethod:              return pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_SENSING_METHOD);
+    case SceneType:                  return pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_SCENE_TYPE);
+
+    case ColorSpace:                 return pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_COLOR_SPACE);
+    case Compression:                return pmexExifMeta->GetValue(   EXIF_IFD_1,                 EXIF_TAG_COMPRESSION);
+    case ComponentsConfiguration:    return pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_COMPONENTS_CONFIGURATION);
+    case CompressedBitsPerPixel:     return pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_COMPRESSED_BITS_PER_PIXEL);
+    case YCbCrPositioning:           return pmexExifMeta->GetValue(   EXIF_IFD_0,                 EXIF_TAG_YCBCR_POSITIONING);
+    case XResolution:                return pmexExifMeta->GetValue(   EXIF_IFD_1,                 EXIF_TAG_X_RESOLUTION);
+    case YResolution:                return pmexExifMeta->GetValue(   EXIF_IFD_1,                 EXIF_TAG_Y_RESOLUTION);
+    case ResolutionUnit:             return pmexExifMeta->GetValue(   EXIF_IFD_1,                 EXIF_TAG_RESOLUTION_UNIT);
+    case FileSource:                 return pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_FILE_SOURCE);
+    case ExifVersion:                return pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_EXIF_VERSION);
+    case FlashPixVersion:            return pmexExifMeta->GetValue(   EXIF_IFD_EXIF,              EXIF_TAG_FLASH_PIX_VERSION);
+    case InteroperabilityIndex:      return pmexExifMeta->GetValue(   EXIF_IFD_INTEROPERABILITY,  EXIF_TAG_INTEROPERABILITY_INDEX);
+    case InteroperabilityVersion:    return pmexExifMeta->GetValue(   EXIF_IFD_INTEROPERABILITY,  EXIF_TAG_INTEROPERABILITY_VERSION);
+
+    case Title:                      return GetValueInvalidCharSub(   EXIF_IFD_0,                 EXIF_TAG_XP_TITLE,                  pmexExifMeta,       kricsInvalidCharSub);
+    case Subject:                    return GetValueInvalidCharSub(   EXIF_IFD_0,                 EXIF_TAG_XP_SUBJECT,                pmexExifMeta,       kricsInvalidCharSub);
+    case Author:                     return GetValueInvalidCharSub(   EXIF_IFD_0,                 EXIF_TAG_XP_AUTHOR,                 pmexExifMeta,       kricsInvalidCharSub);
+    case Comment:                    return GetValueInvalidCharSub(   EXIF_IFD_0,                 EXIF_TAG_XP_COMMENT,                pmexExifMeta,       kricsInvalidCharSub);
+    case Keywords:                   return GetValueInvalidCharSub(   EXIF_IFD_0,                 EXIF_TAG_XP_KEYWORDS,               pmexExifMeta,       kricsInvalidCharSub);
+    case Copyright:                  return GetValueInvalidCharSub(   EXIF_IFD_0,                 EXIF_TAG_COPYRIGHT,                 pmexExifMeta,       kricsInvalidCharSub);
+
+    case GPSLatitude:                return pmexExifMeta->GetValue(   EXIF_IFD_GPS,               static_cast<ExifTag>(EXIF_TAG_GPS_LATITUDE));
+    case GPSLatitudeRef:             return pmexExifMeta->GetValue(   EXIF_IFD_GPS,               static_cast<ExifTag>(EXIF_TAG_GPS_LATITUDE_REF));
+    case GPSLongitude:               return pmexExifMeta->GetValue(   EXIF_IFD_GPS,               static_cast<ExifTag>(EXIF_TAG_GPS_LONGITUDE));
+    case GPSLongitudeRef:            return pmexExifMeta->GetValue(   EXIF_IFD_GPS,               static_cast<ExifTag>(EXIF_TAG_GPS_LONGITUDE_REF));
+    case GPSAltitude:                return pmexExifMeta->GetValue(   EXIF_IFD_GPS,               static_cast<ExifTag>(EXIF_TAG_GPS_ALTITUDE));
+    case GPSAltitudeRef:             return pmexExifMeta->GetValue(   EXIF_IFD_GPS,               static_cast<ExifTag>(EXIF_TAG_GPS_ALTITUDE_REF));
+    case GPSDateStamp:               return GetGPSDateSeparatorSub(pmexExifMeta);
+    case GPSTimeStamp:               return GetGPSTimeSeparatorSub(pmexExifMeta);
+    }
+
+    return QString();
 }
 
 
@@ -32,20 +32,23 @@ private:
 
 public:
     IMetaExif();
-    IMetaExif(IComMetaExif* pmexExifMeta, const IRenameInvalidCharSub & kricsInvalidCharSub, const bool kbAdvancedMode);
+    // Reads the tags whose bits are set in krqbtaRequiredTags, or every tag if it's empty
+    IMetaExif(IComMetaExif* pmexExifMeta, const IRenameInvalidCharSub & kricsInvalidCharSub, const bool kbAdvancedMode, const QBitArray & krqbtaRequiredTags = QBitArray());
 
     // Initialised the tag lookup hash with valid tags and associated tag IDs
     static void InitTagLookupHashBasic();
     static void InitTagLookupHashAdvanced();
 
-    // Read tags from passed ExifMeta object and store in string array
-    void ReadTagsBasic(IComMetaExif* pmexExifMeta, const IRenameInvalidCharSub & kricsInvalidCharSub);
-    void ReadTagsAdvanced(IComMetaExif* pmexExifMeta, const IRenameInvalidCharSub & kricsInvalidCharSub);
+    // Read the required tags from passed ExifMeta object and store in string array.  Advanced mode tags are only read in advanced mode
+    void ReadTags(IComMetaExif* pmexExifMeta, const IRenameInvalidCharSub & kricsInvalidCharSub, const QBitArray & krqbtaRequiredTags);
 
     // Returns tag ID from MusicTagsIDs enum or ITagInfo::Invalid if passed tag string is invalid
     static int GetTagID(const QString & krqstrTagCode);
 
 private:
+    // Returns the value of the passed tag from the ExifMeta object
+    QString ReadTagValue(const int kiTagID, IComMetaExif* pmexExifMeta, const IRenameInvalidCharSub & kricsInvalidCharSub);
+
     // Gets Exif value associated with ID and Tag and performs invalid character substitution
     QString GetValueInvalidCharSub(const ExifIfd kexidID, const ExifTag kextaTag,  IComMetaExif* pmexExifMeta, const IRenameInvalidCharSub & kricsInvalidCharSub);
 
@@ -12,9 +12,12 @@ IMetaMusic::IMetaMusic() : IMetaBase()
 }
 
 
-IMetaMusic::IMetaMusic(IComMetaMusic* pmmuMusicMeta, const IRenameInvalidCharSub & kricsInvalidCharSub) : IMetaBase(NumTags)
+IMetaMusic::IMetaMusic(IComMetaMusic* pmmuMusicMeta, const IRenameInvalidCharSub & kricsInvalidCharSub, const QBitArray & krqbtaRequiredTags) : IMetaBase(NumTags)
 {
-    ReadTags(pmmuMusicMeta, kricsInvalidCharSub);
+    if (krqbtaRequiredTags.isEmpty())
+        ReadTags(pmmuMusicMeta, kricsInvalidCharSub, QBitArray(NumTags, true));
+    else
+        ReadTags(pmmuMusicMeta, kricsInvalidCharSub, krqbtaRequiredTags);
 }
 
 
@@ -34,19 +37,34 @@ void IMetaMusic::InitTagLookupHash()
 }
 
 
-void IMetaMusic::ReadTags(IComMetaMusic* pmmuMusicMeta, const IRenameInvalidCharSub & kricsInvalidCharSub)
+void IMetaMusic::ReadTags(IComMetaMusic* pmmuMusicMeta, const IRenameInvalidCharSub & kricsInvalidCharSub, const QBitArray & krqbtaRequiredTags)
 {
-    m_prgqstrTagValues[Title]       = kricsInvalidCharSub.PerformSubstitution(pmmuMusicMeta->GetTitle());
-    m_prgqstrTagValues[Artist]      = kricsInvalidCharSub.PerformSubstitution(pmmuMusicMeta->GetArtist());
-    m_prgqstrTagValues[Album]       = kricsInvalidCharSub.PerformSubstitution(pmmuMusicMeta->GetAlbum());
-    m_prgqstrTagValues[Track]       = pmmuMusicMeta->GetTrackTwoDigit();
-    m_prgqstrTagValues[Year]        = pmmuMusicMeta->GetYear();
-    m_prgqstrTagValues[Genre]       = kricsInvalidCharSub.PerformSubstitution(pmmuMusicMeta->GetGenre());
-    m_prgqstrTagValues[Comment]     = kricsInvalidCharSub.PerformSubstitution(pmmuMusicMeta->GetComment());
-    m_prgqstrTagValues[RunTime]     = pmmuMusicMeta->GetLengthMMSS(m_qchSeparatorTime);
-    m_prgqstrTagValues[Channels]    = pmmuMusicMeta->GetChannels();
-    m_prgqstrTagValues[SampleRate]  = pmmuMusicMeta->GetSampleRate();
-    m_prgqstrTagValues[BitRate]     = pmmuMusicMeta->GetBitRate();
+    for (int iTagID = 0 ; iTagID < NumTags ; ++iTagID)
+    {
+        if (krqbtaRequiredTags.testBit(iTagID))
+            m_prgqstrTagValues[iTagID] = ReadTagValue(iTagID, pmmuMusicMeta, kricsInvalidCharSub);
+    }
+}
+
+
+QString IMetaMusic::ReadTagValue(const int kiTagID, IComMetaMusic* pmmuMusicMeta, const IRenameInvalidCharSub & kricsInvalidCharSub)
+{
+    switch (kiTagID)
+    {
+    case Title:         return kricsInvalidCharSub.PerformSubstitution(pmmuMusicMeta->GetTitle());
+    case Artist:        return kricsInvalidCharSub.PerformSubstitution(pmmuMusicMeta->GetArtist());
+    case Album:         return kricsInvalidCharSub.PerformSubstitution(pmmuMusicMeta->GetAlbum());
+    case Track:         return pmmuMusicMeta->GetTrackTwoDigit();
+    case Year:          return pmmuMusicMeta->GetYear();
+    case Genre:         return kricsInvalidCharSub.PerformSubstitution(pmmuMusicMeta->GetGenre());
+    case Comment:       return kricsInvalidCharSub.PerformSubstitution(pmmuMusicMeta->GetComment());
+    case RunTime:       return pmmuMusicMeta->GetLengthMMSS(m_qchSeparatorTime);
+    case Channels:      return pmmuMusicMeta->GetChannels();
+    case SampleRate:    return pmmuMusicMeta->GetSampleRate();
+    case BitRate:       return pmmuMusicMeta->GetBitRate();
+    }
+
+    return QString();
 }
 
 
@@ -57,3 +75,15 @@ int IMetaMusic::GetTagID(const QString & krqstrTagCode)
         return ITagInfo::Invalid;
     return *itTagID;
 }
+
+
+int IMetaMusic::GetReadStyle(const QBitArray & krqbtaRequiredTags)
+{
+    if (krqbtaRequiredTags.isEmpty())
+        return IComMetaMusic::ReadAverage;
+
+    if (krqbtaRequiredTags.testBit(RunTime) || krqbtaRequiredTags.testBit(Channels) || krqbtaRequiredTags.testBit(SampleRate) || krqbtaRequiredTags.testBit(BitRate))
+        return IComMetaMusic::ReadAverage;
+
+    return IComMetaMusic::ReadNone;
+}
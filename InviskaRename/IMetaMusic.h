@@ -20,16 +20,25 @@ private:
 
 public:
     IMetaMusic();
-    IMetaMusic(IComMetaMusic* pmmuMusicMeta, const IRenameInvalidCharSub & kricsInvalidCharSub);
+    // Reads the tags whose bits are set in krqbtaRequiredTags, or every tag if it's empty
+    IMetaMusic(IComMetaMusic* pmmuMusicMeta, const IRenameInvalidCharSub & kricsInvalidCharSub, const QBitArray & krqbtaRequiredTags = QBitArray());
 
     // Initialised the tag lookup hash with valid tags and associated tag IDs
     static void InitTagLookupHash();
 
-    // Read tags from passed MusicMeta object and store in string array
-    void ReadTags(IComMetaMusic* pmmuMusicMeta, const IRenameInvalidCharSub & kricsInvalidCharSub);
+    // Read the required tags from passed MusicMeta object and store in string array
+    void ReadTags(IComMetaMusic* pmmuMusicMeta, const IRenameInvalidCharSub & kricsInvalidCharSub, const QBitArray & krqbtaRequiredTags);
 
     // Returns tag ID from MusicTagsIDs enum or ITagInfo::Invalid if passed tag string is invalid
     static int GetTagID(const QString & krqstrTagCode);
+
+    // Returns the IComMetaMusic::ReadStyle for reading the passed tags, which is ReadNone unless one of the audio property tags is required.
+    // An empty array means every tag is required
+    static int GetReadStyle(const QBitArray & krqbtaRequiredTags);
+
+private:
+    // Returns the value of the passed tag from the MusicMeta object
+    QString ReadTagValue(const int kiTagID, IComMetaMusic* pmmuMusicMeta, const IRenameInvalidCharSub & kricsInvalidCharSub);
 };
 
 Q_DECLARE_METATYPE(IMetaMusic)
@@ -0,0 +1,58 @@
+#include "IMetaStore.h"
+#include "IMetaBase.h"
+
+
+IMetaStore::IMetaStore(const int kiNumTags)
+{
+    m_qvecqvecqstrTagValues.resize(kiNumTags);
+    m_iNumRecords = 0;
+}
+
+
+void IMetaStore::Clear()
+{
+    QVector<QVector<QString> >::iterator itColumn;
+    for (itColumn = m_qvecqvecqstrTagValues.begin() ; itColumn != m_qvecqvecqstrTagValues.end() ; ++itColumn)
+        itColumn->clear();
+
+    m_iNumRecords = 0;
+}
+
+
+int IMetaStore::AddRecord(const IMetaBase & krmbaMeta)
+{
+    SetRecord(m_iNumRecords, krmbaMeta);
+    return m_iNumRecords++;
+}
+
+
+void IMetaStore::SetRecord(const int kiRecord, const IMetaBase & krmbaMeta)
+{
+    const int kiNumTags = qMin(krmbaMeta.GetNumTags(), m_qvecqvecqstrTagValues.size());
+    const int kiNumColumns = m_qvecqvecqstrTagValues.size();
+    for (int iTagID = 0 ; iTagID < kiNumColumns ; ++iTagID)
+    {
+        QVector<QString> & rqvecqstrColumn = m_qvecqvecqstrTagValues[iTagID];
+        const QString kqstrValue = (iTagID < kiNumTags ? krmbaMeta.GetTagValue(iTagID) : QString());
+
+        // Empty values past the end of the column are implied, which also clears any old value if the record is being replaced
+        if (kiRecord < rqvecqstrColumn.size())
+        {
+            rqvecqstrColumn[kiRecord] = kqstrValue;
+        }
+        else if (kqstrValue.isEmpty() == false)
+        {
+            rqvecqstrColumn.resize(kiRecord+1);
+            rqvecqstrColumn[kiRecord] = kqstrValue;
+        }
+    }
+}
+
+
+QStringRef IMetaStore::GetTagValue(const int kiRecord, const int kiTagID) const
+{
+    const QVector<QString> & krqvecqstrColumn = m_qvecqvecqstrTagValues.at(kiTagID);
+    if (kiRecord >= krqvecqstrColumn.size())
+        return QStringRef();
+    return QStringRef(&krqvecqstrColumn.at(kiRecord));
+}
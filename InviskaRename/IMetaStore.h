@@ -0,0 +1,40 @@
+#ifndef IMetaStore_h
+#define IMetaStore_h
+
+#include <QString>
+#include <QStringRef>
+#include <QVector>
+class IMetaBase;
+
+
+/* Tag values for all the files in a directory that have one type of tag, held column-wise with one column per tag ID.  Each file's tags are
+ * a record in the store, so a tag value is found with two array lookups and returned as a reference without copying the string.  Columns
+ * are only extended as far as the last record with a value for that tag, so tags that aren't used, like the advanced Exif tags in basic
+ * mode, don't take any space. */
+class IMetaStore
+{
+private:
+    // Tag values, where m_qvecqvecqstrTagValues[TagID][Record] is the value of one tag for one file
+    QVector<QVector<QString> >          m_qvecqvecqstrTagValues;
+
+    // Number of records in the store
+    int                                 m_iNumRecords;
+
+public:
+    IMetaStore(const int kiNumTags);
+
+    // Removes all records
+    void Clear();
+
+    // Adds a record with the values of the passed tags and returns its index, or replaces the values of an existing record
+    int AddRecord(const IMetaBase & krmbaMeta);
+    void SetRecord(const int kiRecord, const IMetaBase & krmbaMeta);
+
+    // Returns the number of records
+    int NumRecords() const                                              {return m_iNumRecords;}
+
+    // Returns the value of the passed tag for the passed record, which is only valid until the record is changed or the store is cleared
+    QStringRef GetTagValue(const int kiRecord, const int kiTagID) const;
+};
+
+#endif // IMetaStore_h
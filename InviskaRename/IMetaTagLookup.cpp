@@ -1,10 +1,10 @@
-#include <QTableWidgetItem>
 #include <QDateTime>
+#include <QVarLengthArray>
 #include "IMetaTagLookup.h"
 #include "IMetaMusic.h"
 #include "IMetaExif.h"
 #include "IMetaAttrib.h"
-#include "IUIFileList.h"
+#include "IUIFileListModel.h"
 
 
 IMetaTagLookup::IMetaTagLookup()
@@ -48,46 +48,141 @@ void IMetaTagLookup::LookupTag(ITagInfo & rtagiTagInfo, const QString & krqstrCa
 }
 
 
-QString IMetaTagLookup::GetValueForTagCode(const QTableWidgetItem* kpqtwiFileItem, const ITagInfo & krtagiTagInfo)
+QStringRef IMetaTagLookup::GetStoredValueForTagCode(const IUIFileListModel* kpflmFileModel, const int kiRow, const ITagInfo & krtagiTagInfo) const
 {
     if (krtagiTagInfo.m_tcatCatagory == ITagInfo::Music)
-    {
-        if (kpqtwiFileItem->data(IUIFileList::MusicMeta).isNull())
-            return QString();
-        return kpqtwiFileItem->data(IUIFileList::MusicMeta).value<IMetaMusic>().GetTagValue(krtagiTagInfo.m_iTagID);
-    }
+        return kpflmFileModel->GetMusicTagValue(kiRow, krtagiTagInfo.m_iTagID);
 
     if (krtagiTagInfo.m_tcatCatagory == ITagInfo::Exif)
+        return kpflmFileModel->GetExifTagValue(kiRow, krtagiTagInfo.m_iTagID);
+
+    return QStringRef();
+}
+
+
+ITagTemplate::ITagTemplate()
+{
+    m_iLiteralLength = 0;
+    m_iNumTags = 0;
+    m_iNumCaptureRefs = 0;
+}
+
+
+ITagTemplate::ITagTemplate(const QString & krqstrText, const QList<ITagInfo> & krqlstTags, const bool kbCaptureRefs) : m_qstrText(krqstrText)
+{
+    m_iLiteralLength = 0;
+    m_iNumTags = krqlstTags.size();
+    m_iNumCaptureRefs = 0;
+    m_qvectsSegments.reserve(krqlstTags.size() * 2 + 1);
+
+    ITagTemplateSegment tsTag;
+    tsTag.m_iStart = 0;
+    tsTag.m_iLength = 0;
+    tsTag.m_iCaptureGroup = -1;
+
+    int iLiteralStart = 0;
+    QList<ITagInfo>::const_iterator kitTagInfo;
+    for (kitTagInfo = krqlstTags.constBegin() ; kitTagInfo != krqlstTags.constEnd() ; ++kitTagInfo)
     {
-        if (kpqtwiFileItem->data(IUIFileList::ExifMeta).isNull())
-            return QString();
-        return kpqtwiFileItem->data(IUIFileList::ExifMeta).value<IMetaExif>().GetTagValue(krtagiTagInfo.m_iTagID);
+        AddLiteral(iLiteralStart, kitTagInfo->m_iStartIndex, kbCaptureRefs);
+        tsTag.m_tagiTag = *kitTagInfo;
+        m_qvectsSegments.append(tsTag);
+        iLiteralStart = kitTagInfo->m_iEndIndex+1;
     }
+    AddLiteral(iLiteralStart, m_qstrText.length(), kbCaptureRefs);
+}
 
-    if (krtagiTagInfo.m_tcatCatagory == ITagInfo::Attrib)
+
+void ITagTemplate::AddLiteral(const int kiStart, const int kiEnd, const bool kbCaptureRefs)
+{
+    int iLiteralStart = kiStart;
+    if (kbCaptureRefs)
     {
-        return IMetaAttrib::GetTagValue(kpqtwiFileItem, krtagiTagInfo.m_iTagID);
+        ITagTemplateSegment tsCaptureRef;
+        tsCaptureRef.m_iStart = 0;
+        tsCaptureRef.m_iLength = 0;
+        tsCaptureRef.m_tagiTag.m_tcatCatagory = ITagInfo::Invalid;
+        tsCaptureRef.m_tagiTag.m_iTagID = ITagInfo::Invalid;
+
+        // $ followed by a single digit refers to a capture group, and any other $ is left as it is
+        int iIndex = m_qstrText.indexOf('$', kiStart);
+        while (iIndex != -1 && iIndex + 1 < kiEnd)
+        {
+            if (m_qstrText.at(iIndex+1).isDigit())
+            {
+                AddLiteralSegment(iLiteralStart, iIndex);
+                tsCaptureRef.m_iCaptureGroup = m_qstrText.at(iIndex+1).digitValue();
+                m_qvectsSegments.append(tsCaptureRef);
+                ++m_iNumCaptureRefs;
+                iLiteralStart = iIndex + 2;
+            }
+            iIndex = m_qstrText.indexOf('$', iIndex+1);
+        }
     }
 
-    return QString();
+    AddLiteralSegment(iLiteralStart, kiEnd);
 }
 
 
-QString IMetaTagLookup::ReplaceTagCodesWithValues(const QString & krqstrString, const QList<ITagInfo> & krqlstReplaceNameTags, const QTableWidgetItem* kpqtwiFileItem)
+void ITagTemplate::AddLiteralSegment(const int kiStart, const int kiEnd)
 {
-    int iSubStringStart = 0;
-    QString qstrSubstituted;
+    if (kiEnd <= kiStart)
+        return;
+
+    ITagTemplateSegment tsLiteral;
+    tsLiteral.m_iStart = kiStart;
+    tsLiteral.m_iLength = kiEnd - kiStart;
+    tsLiteral.m_tagiTag.m_tcatCatagory = ITagInfo::Invalid;
+    tsLiteral.m_tagiTag.m_iTagID = ITagInfo::Invalid;
+    tsLiteral.m_iCaptureGroup = -1;
+    m_qvectsSegments.append(tsLiteral);
+    m_iLiteralLength += tsLiteral.m_iLength;
+}
 
-    QList<ITagInfo>::const_iterator kitTagInfo;
-    for (kitTagInfo = krqlstReplaceNameTags.constBegin() ; kitTagInfo != krqlstReplaceNameTags.constEnd() ; ++kitTagInfo)
+
+QString ITagTemplate::Render(const IMetaTagLookup* kpmtlMetaTagLookup, const IUIFileListModel* kpflmFileModel, const int kiRow,
+                             const QRegularExpressionMatch & krqremRegExMatch) const
+{
+    // Music and Exif values are references into the model's meta store and capture groups are references into the matched string, so
+    // they're looked up once while the result is sized and then appended.  File attribute values are formatted from the file's timestamps
+    // so they're worked out as they're appended
+    const bool kbRegExMatch = krqremRegExMatch.hasMatch();
+    QVarLengthArray<QStringRef, 16> qvlaqsrStoredValues;
+    int iLength = m_iLiteralLength;
+    QVector<ITagTemplateSegment>::const_iterator kitSegment;
+    for (kitSegment = m_qvectsSegments.constBegin() ; kitSegment != m_qvectsSegments.constEnd() ; ++kitSegment)
     {
-        qstrSubstituted += krqstrString.mid(iSubStringStart, kitTagInfo->m_iStartIndex - iSubStringStart) + GetValueForTagCode(kpqtwiFileItem, *kitTagInfo);
-        iSubStringStart = kitTagInfo->m_iEndIndex+1;
+        if (kitSegment->m_iCaptureGroup != -1)
+        {
+            qvlaqsrStoredValues.append(kbRegExMatch ? krqremRegExMatch.capturedRef(kitSegment->m_iCaptureGroup) : QStringRef());
+            iLength += qvlaqsrStoredValues.last().length();
+        }
+        else if (kitSegment->m_tagiTag.m_tcatCatagory == ITagInfo::Attrib)
+        {
+            iLength += m_kiAttribValueLength;
+        }
+        else if (kitSegment->m_tagiTag.m_tcatCatagory != ITagInfo::Invalid)
+        {
+            qvlaqsrStoredValues.append(kpmtlMetaTagLookup->GetStoredValueForTagCode(kpflmFileModel, kiRow, kitSegment->m_tagiTag));
+            iLength += qvlaqsrStoredValues.last().length();
+        }
     }
 
-    if (iSubStringStart < krqstrString.length())
-        qstrSubstituted += krqstrString.mid(iSubStringStart);
+    QString qstrRendered;
+    qstrRendered.reserve(iLength);
 
+    int iStoredValue = 0;
+    for (kitSegment = m_qvectsSegments.constBegin() ; kitSegment != m_qvectsSegments.constEnd() ; ++kitSegment)
+    {
+        if (kitSegment->m_iCaptureGroup != -1)
+            qstrRendered += qvlaqsrStoredValues.at(iStoredValue++);
+        else if (kitSegment->m_tagiTag.m_tcatCatagory == ITagInfo::Invalid)
+            qstrRendered += m_qstrText.midRef(kitSegment->m_iStart, kitSegment->m_iLength);
+        else if (kitSegment->m_tagiTag.m_tcatCatagory == ITagInfo::Attrib)
+            qstrRendered += IMetaAttrib::GetTagValue(kpflmFileModel->GetFileInfo(kiRow), kitSegment->m_tagiTag.m_iTagID);
+        else
+            qstrRendered += qvlaqsrStoredValues.at(iStoredValue++);
+    }
 
-    return qstrSubstituted;
+    return qstrRendered;
 }
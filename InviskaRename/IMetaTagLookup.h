@@ -3,7 +3,12 @@
 
 #include <QHash>
 #include <QString>
-class QTableWidgetItem;
+#include <QStringRef>
+#include <QList>
+#include <QVector>
+#include <QRegularExpressionMatch>
+class IUIFileListModel;
+class IMetaTagLookup;
 
 
 struct ITagInfo
@@ -23,6 +28,64 @@ struct ITagInfo
 };
 
 
+// A piece of a compiled tag template, which is a range of the template's text, a tag whose value is inserted or a RegEx capture group
+struct ITagTemplateSegment
+{
+    // Start and length of literal text in the template string, which are unused for tags and capture groups
+    int                             m_iStart;
+    int                             m_iLength;
+
+    // Tag to insert, with ITagInfo::Invalid as the category for literal text and capture groups
+    ITagInfo                        m_tagiTag;
+
+    // Number of the capture group for $ references, or -1 for literal text and tags
+    int                             m_iCaptureGroup;
+};
+
+
+/* Text containing tag codes compiled into a list of literal ranges, tags and, for RegEx stages, $ references to capture groups.  The text
+ * is only scanned when the template is compiled, so rendering it for a row just looks up each value, works out the final length and builds
+ * the result with one allocation.  Literal ranges refer to the template's own copy of the text, so nothing is copied until the result is
+ * built, and values inserted for one reference are never scanned for another. */
+class ITagTemplate
+{
+private:
+    // Text the template was compiled from, and its segments in order
+    QString                         m_qstrText;
+    QVector<ITagTemplateSegment>    m_qvectsSegments;
+
+    // Combined length of the literal segments, and number of tag and capture group segments
+    int                             m_iLiteralLength;
+    int                             m_iNumTags;
+    int                             m_iNumCaptureRefs;
+
+    // Length reserved for a file attribute value when sizing the result, which is the length of the longest date/time value
+    static const int                m_kiAttribValueLength = 19;
+
+public:
+    ITagTemplate();
+
+    // Compiles the passed text, where krqlstTags are the tags found in it by IUIRenameTabBase::ReadTagCodes() in the order they appear.
+    // If kbCaptureRefs is true, $ followed by a digit in the text outside the tags is compiled as a reference to that capture group
+    ITagTemplate(const QString & krqstrText, const QList<ITagInfo> & krqlstTags, const bool kbCaptureRefs = false);
+
+    // Indicates if the template has any tags or capture group references, as a template without them renders as the text it was compiled from
+    bool IsStatic() const                                   {return m_iNumTags == 0 && m_iNumCaptureRefs == 0;}
+
+    // Returns the text with each tag replaced by its value for the passed row and each capture group reference replaced by the group's
+    // text in krqremRegExMatch, which is empty if there was no match
+    QString Render(const IMetaTagLookup* kpmtlMetaTagLookup, const IUIFileListModel* kpflmFileModel, const int kiRow,
+                   const QRegularExpressionMatch & krqremRegExMatch = QRegularExpressionMatch()) const;
+
+private:
+    // Appends segments for the passed range of the text if it isn't empty, splitting out capture group references if kbCaptureRefs is true
+    void AddLiteral(const int kiStart, const int kiEnd, const bool kbCaptureRefs);
+
+    // Appends a single literal segment for the passed range of the text if it isn't empty
+    void AddLiteralSegment(const int kiStart, const int kiEnd);
+};
+
+
 class IMetaTagLookup
 {
 public:
@@ -38,11 +101,8 @@ public:
     // Sets the ITagInfo Category and TagID values, with the TagID being set to ITagInfo::Invalid if it's not valid
     void LookupTag(ITagInfo & rtagiTagInfo, const QString & krqstrCategory, const QString & krqstrTagCode);
 
-    // Returns the value for the specified tag code
-    QString GetValueForTagCode(const QTableWidgetItem* kpqtwiFileItem, const ITagInfo & krtagiTagInfo);
-
-    // Replaces the tag codes in the passed string with the tag value and returns the resulting string
-    QString ReplaceTagCodesWithValues(const QString & krqstrString, const QList<ITagInfo> & krqlstReplaceNameTags, const QTableWidgetItem* kpqtwiFileItem);
+    // Returns a reference to the value for the specified Music or Exif tag code in the model's meta store, or an empty reference for other tags
+    QStringRef GetStoredValueForTagCode(const IUIFileListModel* kpflmFileModel, const int kiRow, const ITagInfo & krtagiTagInfo) const;
 };
 
 #endif // IMetaTagLookup_h
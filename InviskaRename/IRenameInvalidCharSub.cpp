@@ -1,4 +1,5 @@
 #include <QTableWidget>
+#include <QHash>
 #include "IRenameInvalidCharSub.h"
 #include "IDlgPreferences.h"
 #include "IComMetaMusic.h"
@@ -40,6 +41,8 @@ IRenameInvalidCharSub::IRenameInvalidCharSub(QSettings & rqsetSettings) : m_rqse
         m_rgbReplacementEnabled[iIndex] = !(m_rgqstrReplacment[iIndex].size() == 1 && m_rgqstrReplacment[iIndex].at(0) == m_qstrInvalidCharacters.at(iIndex));
     }
     m_rqsetSettings.endGroup();
+
+    BuildSubstitutionTable();
 }
 
 
@@ -88,18 +91,63 @@ void IRenameInvalidCharSub::SavePreferencesChanges(QTableWidget* pqtwInvalidChar
         m_rgbReplacementEnabled[iIndex] = !(m_rgqstrReplacment[iIndex].size() == 1 && m_rgqstrReplacment[iIndex].at(0) == m_qstrInvalidCharacters.at(iIndex));
     }
     m_rqsetSettings.endGroup();
+
+    BuildSubstitutionTable();
+}
+
+
+void IRenameInvalidCharSub::BuildSubstitutionTable()
+{
+    for (int iChar = 0 ; iChar < 128 ; ++iChar)
+        m_rgi8SubstitutionTable[iChar] = -1;
+
+    for (int iIndex = 0 ; iIndex < NumInvalidChars ; ++iIndex)
+    {
+        if (m_rgbReplacementEnabled[iIndex])
+            m_rgi8SubstitutionTable[m_qstrInvalidCharacters.at(iIndex).unicode()] = static_cast<qint8>(iIndex);
+    }
 }
 
 
 QString IRenameInvalidCharSub::PerformSubstitution(QString qstrString) const
 {
-    if (qstrString.isEmpty() == false)
+    // Find the first character to replace, as most strings don't have any and are returned as they are
+    const ushort* kpusStart = qstrString.utf16();
+    const ushort* kpusEnd = kpusStart + qstrString.length();
+    const ushort* kpusChar = kpusStart;
+    while (kpusChar != kpusEnd && (*kpusChar >= 128 || m_rgi8SubstitutionTable[*kpusChar] == -1))
+        ++kpusChar;
+
+    if (kpusChar == kpusEnd)
+        return qstrString;
+
+    // Runs of characters that aren't replaced are appended in one go
+    QString qstrSubstituted;
+    qstrSubstituted.reserve(qstrString.length() + 8);
+    const ushort* kpusRunStart = kpusStart;
+    for ( ; kpusChar != kpusEnd ; ++kpusChar)
     {
-        for (int iIndex = 0 ; iIndex < NumInvalidChars ; ++iIndex)
-        {
-            if (m_rgbReplacementEnabled[iIndex])
-                qstrString.replace(m_qstrInvalidCharacters.at(iIndex), m_rgqstrReplacment[iIndex]);
-        }
+        if (*kpusChar >= 128 || m_rgi8SubstitutionTable[*kpusChar] == -1)
+            continue;
+
+        qstrSubstituted += qstrString.midRef(kpusRunStart - kpusStart, kpusChar - kpusRunStart);
+        qstrSubstituted += m_rgqstrReplacment[m_rgi8SubstitutionTable[*kpusChar]];
+        kpusRunStart = kpusChar + 1;
+    }
+    qstrSubstituted += qstrString.midRef(kpusRunStart - kpusStart, kpusEnd - kpusRunStart);
+
+    return qstrSubstituted;
+}
+
+
+uint IRenameInvalidCharSub::GetSettingsHash() const
+{
+    QString qstrSettings;
+    for (int iIndex = 0 ; iIndex < NumInvalidChars ; ++iIndex)
+    {
+        if (m_rgbReplacementEnabled[iIndex])
+            qstrSettings += m_qstrInvalidCharacters.at(iIndex) + m_rgqstrReplacment[iIndex];
+        qstrSettings += QChar(0);
     }
-    return qstrString;
+    return qHash(qstrSettings);
 }
@@ -31,6 +31,10 @@ private:
     bool                m_rgbReplacementEnabled[NumInvalidChars];
     QString             m_rgqstrReplacment[NumInvalidChars];
 
+    // Index in m_rgqstrReplacment of the replacement for each ASCII character, or -1 if the character isn't replaced.  The invalid characters
+    // are all ASCII, so anything outside the table is never replaced
+    qint8               m_rgi8SubstitutionTable[128];
+
     // Indicates changes were made to the sutstitute characters while the Preferences dialog was open
     bool                m_bChangesMade;
 
@@ -46,9 +50,18 @@ public:
     // Checks if character replacement settings have changed and stores changed settings to this class and QSettings
     void SavePreferencesChanges(QTableWidget* pqtwInvalidCharacterTable);
 
-    // Performs invalid character substitutions on passed string
+    // Performs invalid character substitutions on passed string in a single pass, so replacement strings aren't themselves substituted.
+    // Strings without any characters to replace are returned without being copied
     QString PerformSubstitution(QString qstrString) const;
 
+    // Returns a hash of the substitutions in effect, so tags stored in the meta cache can be discarded if they were substituted differently
+    uint GetSettingsHash() const;
+
+private:
+    // Rebuilds m_rgi8SubstitutionTable from the enabled replacements
+    void BuildSubstitutionTable();
+
+public:
     // Accessor functions
     int GetNumInvalidChars()    {return NumInvalidChars;}
     bool ChangesMade()          {return m_bChangesMade;}
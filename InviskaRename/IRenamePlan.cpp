@@ -0,0 +1,409 @@
+#include <algorithm>
+#include "IRenamePlan.h"
+#include "IUIFileListModel.h"
+#include "IRenameInvalidCharSub.h"
+
+
+// Stages run on the name and on the extension of each file, in the order they're applied
+static const int kiNameStages[]         = {IRenamePlan::StageName, IRenamePlan::StageNumbering, IRenamePlan::StageRegExName1, IRenamePlan::StageRegExName2, IRenamePlan::StageRegExName3};
+static const int kiExtensionStages[]    = {IRenamePlan::StageExtension, IRenamePlan::StageRegExExten};
+static const int kiNumNameStages        = sizeof(kiNameStages) / sizeof(kiNameStages[0]);
+static const int kiNumExtensionStages   = sizeof(kiExtensionStages) / sizeof(kiExtensionStages[0]);
+
+// Characters after which title case starts a new word, which are " -()[]{}.,;:/\", as a bit mask of ASCII codes 0-63 and 64-127
+static const quint64 kui64WordBreakMask[2] = {Q_UINT64_C(0x0C00F30100000000), Q_UINT64_C(0x2800000038000000)};
+
+// Indicates if the passed character is one of the title case word break characters
+static inline bool IsWordBreak(const ushort kusChar)
+{
+    return kusChar < 128 && (kui64WordBreakMask[kusChar >> 6] >> (kusChar & 63)) & 1;
+}
+
+// Indicates if every character of the passed string is ASCII.  The characters are ORed together without branching so the compiler can
+// vectorise the loop
+static bool IsAscii(const QString & krqstrString)
+{
+    ushort usCombined = 0;
+    const ushort* kpusChar = krqstrString.utf16();
+    const ushort* kpusEnd = kpusChar + krqstrString.length();
+    for ( ; kpusChar != kpusEnd ; ++kpusChar)
+        usCombined |= *kpusChar;
+    return usCombined < 128;
+}
+
+
+IRenameOp::IRenameOp(const int kiType)
+{
+    m_iType             = kiType;
+    m_iPos              = 0;
+    m_iCount            = 0;
+    m_iStartNumber      = 0;
+    m_iIncrement        = 0;
+}
+
+
+IRenamePlan::IRenamePlan(const IMetaTagLookup* kpmtlMetaTagLookup, const IRenameInvalidCharSub* kpicsInvalidCharSub, const Qt::CaseSensitivity kqcsCaseSensitivity)
+{
+    m_qveciStageStart.fill(0, NumStages+1);
+    m_iCurrentStage = NoStage;
+    m_bRegExStage = false;
+    m_qcsCaseSensitivity = kqcsCaseSensitivity;
+    m_kpmtlMetaTagLookup = kpmtlMetaTagLookup;
+    m_kpicsInvalidCharSub = kpicsInvalidCharSub;
+}
+
+
+void IRenamePlan::BeginStage(const int kiStage, const bool kbRegExStage)
+{
+    m_iCurrentStage = kiStage;
+    m_bRegExStage = kbRegExStage;
+}
+
+
+void IRenamePlan::AddOp(const IRenameOp & krropOp)
+{
+    m_qvecropOps.append(krropOp);
+
+    // Every later stage starts after the operation just added until operations are added to it
+    for (int iStage = m_iCurrentStage+1 ; iStage <= NumStages ; ++iStage)
+        m_qveciStageStart[iStage] = m_qvecropOps.size();
+}
+
+
+void IRenamePlan::AddTextOp(const int kiType, const QString & krqstrText, const QList<ITagInfo> & krqlstTags, const int kiPos)
+{
+    IRenameOp ropOp(kiType);
+    ropOp.m_qstrText = krqstrText;
+    ropOp.m_ttmpText = ITagTemplate(krqstrText, krqlstTags, m_bRegExStage);
+    ropOp.m_iPos = kiPos;
+    AddOp(ropOp);
+}
+
+
+void IRenamePlan::AddReplaceTextOp(const QString & krqstrFind, const QString & krqstrText, const QList<ITagInfo> & krqlstTags)
+{
+    IRenameOp ropOp(IRenameOp::ReplaceText);
+    ropOp.m_qstrFind = krqstrFind;
+    ropOp.m_qstrText = krqstrText;
+    ropOp.m_ttmpText = ITagTemplate(krqstrText, krqlstTags);
+    AddOp(ropOp);
+}
+
+
+void IRenamePlan::AddCropOp(const int kiType, const int kiPos, const int kiCount)
+{
+    IRenameOp ropOp(kiType);
+    ropOp.m_iPos = kiPos;
+    ropOp.m_iCount = kiCount;
+    AddOp(ropOp);
+}
+
+
+void IRenamePlan::AddChangeCaseOp(const int kiCase)
+{
+    IRenameOp ropOp(IRenameOp::ChangeCase);
+    ropOp.m_iPos = kiCase;
+    AddOp(ropOp);
+}
+
+
+void IRenamePlan::AddNumberOp(const int kiType, const int kiStartNumber, const int kiIncrement, const int kiNumberCharWidth, const int kiPos)
+{
+    IRenameOp ropOp(kiType);
+    ropOp.m_iStartNumber = kiStartNumber;
+    ropOp.m_iIncrement = kiIncrement;
+    ropOp.m_iCount = kiNumberCharWidth;
+    ropOp.m_iPos = kiPos;
+    AddOp(ropOp);
+}
+
+
+void IRenamePlan::AddRegExMatchOp(const QRegularExpression & krqreRegEx, const int kiStartPos)
+{
+    IRenameOp ropOp(IRenameOp::RegExMatch);
+    ropOp.m_qreRegEx = krqreRegEx;
+    ropOp.m_iPos = kiStartPos;
+    AddOp(ropOp);
+}
+
+
+void IRenamePlan::GenerateStage(const int kiStage, QString & rqstrName, const IUIFileListModel* kpflmFileModel, const int kiRow, const int kiRenameIndex) const
+{
+    // Match of the stage's RegExMatch operation, which stays empty if the stage has no valid expression so $ references are removed.  The
+    // match offsets are only valid until the name is replaced
+    QRegularExpressionMatch qremRegExMatch;
+    bool bMatchOffsetsValid = false;
+
+    const IRenameOp* kpropOp = m_qvecropOps.constData() + m_qveciStageStart.at(kiStage);
+    const IRenameOp* kpropEnd = m_qvecropOps.constData() + m_qveciStageStart.at(kiStage+1);
+    for ( ; kpropOp != kpropEnd ; ++kpropOp)
+    {
+        const IRenameOp & krropOp = *kpropOp;
+        switch (krropOp.m_iType)
+        {
+        case IRenameOp::ReplaceName     :   rqstrName = GetOpText(krropOp, qremRegExMatch, kpflmFileModel, kiRow);
+                                            bMatchOffsetsValid = false;
+                                            break;
+
+        case IRenameOp::ReplaceText     :   rqstrName.replace(krropOp.m_qstrFind, GetOpText(krropOp, qremRegExMatch, kpflmFileModel, kiRow), m_qcsCaseSensitivity);
+                                            break;
+
+        case IRenameOp::ReplaceMatch    :   if (qremRegExMatch.capturedLength() == 0)
+                                                break;
+
+                                            // The match is replaced where it was found rather than searching the name for the matched text.  If
+                                            // the name has been replaced since, occurrences of the matched text in the new name are replaced
+                                            if (bMatchOffsetsValid)
+                                                rqstrName.replace(qremRegExMatch.capturedStart(), qremRegExMatch.capturedLength(), GetOpText(krropOp, qremRegExMatch, kpflmFileModel, kiRow));
+                                            else
+                                                rqstrName.replace(qremRegExMatch.captured(), GetOpText(krropOp, qremRegExMatch, kpflmFileModel, kiRow), m_qcsCaseSensitivity);
+                                            break;
+
+        case IRenameOp::InsertAt        :   if (krropOp.m_iPos <= rqstrName.length())
+                                                rqstrName.insert(krropOp.m_iPos, GetOpText(krropOp, qremRegExMatch, kpflmFileModel, kiRow));
+                                            break;
+
+        case IRenameOp::InsertAtStart   :   rqstrName.prepend(GetOpText(krropOp, qremRegExMatch, kpflmFileModel, kiRow));
+                                            break;
+
+        case IRenameOp::InsertAtEnd     :   rqstrName.append(GetOpText(krropOp, qremRegExMatch, kpflmFileModel, kiRow));
+                                            break;
+
+        case IRenameOp::CropAt          :   rqstrName.remove(krropOp.m_iPos, krropOp.m_iCount);
+                                            break;
+
+        case IRenameOp::CropLeft        :   rqstrName.remove(0, krropOp.m_iCount);
+                                            break;
+
+        case IRenameOp::CropRight       :   rqstrName.truncate(rqstrName.length() - krropOp.m_iCount);
+                                            break;
+
+        case IRenameOp::ChangeCase      :   ConvertCase(rqstrName, krropOp.m_iPos);
+                                            break;
+
+        case IRenameOp::NumberAtStart   :
+        case IRenameOp::NumberAtEnd     :
+        case IRenameOp::NumberAt        :   {
+                                            const QString kqstrNumber = QString("%1").arg(krropOp.m_iStartNumber + (krropOp.m_iIncrement * kiRenameIndex), krropOp.m_iCount, 10, QChar('0'));
+                                            if (krropOp.m_iType == IRenameOp::NumberAtStart)
+                                                rqstrName.prepend(kqstrNumber);
+                                            else if (krropOp.m_iType == IRenameOp::NumberAtEnd)
+                                                rqstrName.append(kqstrNumber);
+                                            else if (krropOp.m_iPos <= rqstrName.length())
+                                                rqstrName.insert(krropOp.m_iPos, kqstrNumber);
+                                            }
+                                            break;
+
+        case IRenameOp::RegExMatch      :   qremRegExMatch = krropOp.m_qreRegEx.match(rqstrName, krropOp.m_iPos);
+                                            bMatchOffsetsValid = true;
+                                            break;
+        }
+    }
+}
+
+
+QString IRenamePlan::GetOpText(const IRenameOp & krropOp, const QRegularExpressionMatch & krqremRegExMatch, const IUIFileListModel* kpflmFileModel, const int kiRow) const
+{
+    // Literal text is shared rather than copied
+    if (krropOp.m_ttmpText.IsStatic())
+        return krropOp.m_qstrText;
+
+    return krropOp.m_ttmpText.Render(m_kpmtlMetaTagLookup, kpflmFileModel, kiRow, krqremRegExMatch);
+}
+
+
+void IRenamePlan::ConvertCase(QString & rqstrName, const int kiCase)
+{
+    if (rqstrName.isEmpty() || kiCase == IRenameOp::CaseNoChange)
+        return;
+
+    // Names are nearly always ASCII, which can be converted in place with one pass and no lookups.  Other names go through QString, which
+    // handles the full Unicode case mappings, including ones that change the length of the string
+    if (IsAscii(rqstrName) == false)
+    {
+        ConvertCaseUnicode(rqstrName, kiCase);
+        return;
+    }
+
+    // The string is only detached once a character actually changes, so names already in the right case aren't copied
+    const bool kbUpper = (kiCase == IRenameOp::CaseUpper);
+    const bool kbTitle = (kiCase == IRenameOp::CaseTitle);
+    bool bWordStart = (kbTitle || kiCase == IRenameOp::CaseSentance);
+    QChar* pqchName = nullptr;
+    const int kiLength = rqstrName.length();
+    for (int iIndex = 0 ; iIndex < kiLength ; ++iIndex)
+    {
+        const ushort kusChar = rqstrName.at(iIndex).unicode();
+        ushort usConverted = kusChar;
+        if (kbUpper || bWordStart)
+        {
+            if (kusChar >= 'a' && kusChar <= 'z')
+                usConverted = kusChar - ('a' - 'A');
+        }
+        else if (kusChar >= 'A' && kusChar <= 'Z')
+        {
+            usConverted = kusChar + ('a' - 'A');
+        }
+
+        if (usConverted != kusChar)
+        {
+            if (pqchName == nullptr)
+                pqchName = rqstrName.data();
+            pqchName[iIndex] = QChar(usConverted);
+        }
+
+        bWordStart = kbTitle && IsWordBreak(kusChar);
+    }
+}
+
+
+void IRenamePlan::ConvertCaseUnicode(QString & rqstrName, const int kiCase)
+{
+    if (kiCase == IRenameOp::CaseUpper)
+    {
+        rqstrName = rqstrName.toUpper();
+        return;
+    }
+
+    rqstrName = rqstrName.toLower();
+    if (kiCase == IRenameOp::CaseLower || rqstrName.isEmpty())
+        return;
+
+    rqstrName[0] = rqstrName.at(0).toUpper();
+    if (kiCase != IRenameOp::CaseTitle)
+        return;
+
+    const int kiLength = rqstrName.length();
+    for (int iIndex = 1 ; iIndex < kiLength ; ++iIndex)
+    {
+        if (IsWordBreak(rqstrName.at(iIndex-1).unicode()))
+            rqstrName[iIndex] = rqstrName.at(iIndex).toUpper();
+    }
+}
+
+
+void IRenamePlan::GeneratePreview(IRenamePreviewRow & rrprRow, const IUIFileListModel* kpflmFileModel, const int kiChangedStage) const
+{
+    // Directory names are renamed whole, and left() returns entire string if n is less than zero, so this works even if there's no extension
+    const QString & krqstrFileName = kpflmFileModel->GetNameCurrent(rrprRow.m_iRow);
+    const int kiExtensionIndex = kpflmFileModel->IsDir(rrprRow.m_iRow) ? -1 : krqstrFileName.lastIndexOf('.');
+    const QString kqstrGeneratedName = RunStages(kiNameStages, kiNumNameStages, krqstrFileName.left(kiExtensionIndex), rrprRow, rrprRow.m_bRenumber, kpflmFileModel, kiChangedStage);
+
+    if (kiExtensionIndex == -1)
+    {
+        rrprRow.m_qstrPreviewName = kqstrGeneratedName;
+    }
+    else
+    {
+        const QString & krqstrGeneratedExtension = RunStages(kiExtensionStages, kiNumExtensionStages, krqstrFileName.mid(kiExtensionIndex+1), rrprRow, false, kpflmFileModel, kiChangedStage);
+        if (krqstrGeneratedExtension.isEmpty())
+        {
+            rrprRow.m_qstrPreviewName = kqstrGeneratedName;
+        }
+        else if (krqstrGeneratedExtension.startsWith('.'))
+        {
+            int iIndex = 1;
+            int iLength = krqstrGeneratedExtension.length();
+            while (iIndex < iLength && krqstrGeneratedExtension.at(iIndex) == '.')
+                ++iIndex;
+
+            if (iIndex >= iLength)
+                rrprRow.m_qstrPreviewName = kqstrGeneratedName;
+            else
+                rrprRow.m_qstrPreviewName = kqstrGeneratedName + krqstrGeneratedExtension.mid(iIndex-1);
+        }
+        else
+        {
+            rrprRow.m_qstrPreviewName = kqstrGeneratedName + '.' + krqstrGeneratedExtension;
+        }
+    }
+
+    // The line edits don't accept invalid characters, but the name can still pick them up from the current name through RegEx captures.
+    // Substituting here means the rename checks and the rename itself use the name that's shown
+    rrprRow.m_qstrPreviewName = m_kpicsInvalidCharSub->PerformSubstitution(rrprRow.m_qstrPreviewName);
+    RemoveInvalidTrailingCharacters(rrprRow.m_qstrPreviewName);
+}
+
+
+void IRenamePlan::RemoveInvalidTrailingCharacters(QString & rqstrFileName)
+{
+    // Trailing spaces can make files inaccessible on Windows.  On Linux and Mac traling spaces are allowed, but can cause problems.
+    // On macOS "file.txt" is considered a text file, while "file.txt " is treated as an executable, so it's best to remove trailing spaes on all platforms.
+    // Trailing dots are are also invlaid on Windows, and they again change the MIME type on Mac so we strip them off as well.
+    int iLength = rqstrFileName.length();
+    while (iLength > 0 && (rqstrFileName.at(iLength-1) == ' ' || rqstrFileName.at(iLength-1) == '.'))
+        --iLength;
+    rqstrFileName.truncate(iLength);
+}
+
+
+void IRenamePlan::CopyStageOutput(QString & rqstrCachedOutput, const QString & krqstrOutput)
+{
+    // Strings that haven't been modified since they were shared, like the name passed into the chain, are simply shared
+    if (krqstrOutput.isDetached() == false)
+    {
+        rqstrCachedOutput = krqstrOutput;
+        return;
+    }
+
+    const int kiLength = krqstrOutput.length();
+    if (rqstrCachedOutput.isDetached() && rqstrCachedOutput.capacity() >= kiLength)
+    {
+        rqstrCachedOutput.resize(kiLength);
+        std::copy(krqstrOutput.constBegin(), krqstrOutput.constEnd(), rqstrCachedOutput.begin());
+    }
+    else
+    {
+        rqstrCachedOutput = QString(krqstrOutput.constData(), kiLength);
+    }
+}
+
+
+const QString & IRenamePlan::RunStages(const int* kpiStages, const int kiNumStages, const QString & krqstrInput, IRenamePreviewRow & rrprRow, const bool kbRenumber,
+                                       const IUIFileListModel* kpflmFileModel, const int kiChangedStage) const
+{
+    QStringList & rqstrlStages = *rrprRow.m_pqstrlStages;
+
+    // Stages before the changed stage can't have changed, so the chain starts from the changed stage, or from numbering if the row's number
+    // has changed.  The chain can stop early once a stage's output matches the cache, but not before the changed stage has run, as its
+    // cached output may be left over from before it was enabled, or before numbering has been applied to a renumbered row.  Rows with
+    // nothing cached must run every stage
+    int iFirstStage = kiNumStages;
+    int iLastForcedStage = -1;
+    for (int iStage = 0 ; iStage < kiNumStages ; ++iStage)
+    {
+        if (kpiStages[iStage] == kiChangedStage)
+        {
+            iFirstStage = qMin(iFirstStage, iStage);
+            iLastForcedStage = qMax(iLastForcedStage, iStage);
+        }
+
+        if (kbRenumber && kpiStages[iStage] == StageNumbering)
+        {
+            iFirstStage = qMin(iFirstStage, iStage);
+            iLastForcedStage = qMax(iLastForcedStage, iStage);
+        }
+    }
+
+    if (rrprRow.m_bCached == false)
+    {
+        iFirstStage = 0;
+        iLastForcedStage = kiNumStages;
+    }
+
+    // The stages work on one buffer, which is only allocated when the first stage modifies it.  Each stage's output is copied into the
+    // cache entry's existing buffer rather than shared with the working buffer, as sharing would make the next stage that modifies the
+    // working buffer detach it and allocate a new one.  A chain of RegEx stages therefore reuses the same buffers from one preview to the next
+    QString qstrOutput = (iFirstStage == 0 ? krqstrInput : rqstrlStages.at(kpiStages[iFirstStage-1]));
+    for (int iStage = iFirstStage ; iStage < kiNumStages ; ++iStage)
+    {
+        GenerateStage(kpiStages[iStage], qstrOutput, kpflmFileModel, rrprRow.m_iRow, rrprRow.m_iRenameIndex);
+
+        QString & rqstrCachedOutput = rqstrlStages[kpiStages[iStage]];
+        if (iStage >= iLastForcedStage && qstrOutput == rqstrCachedOutput)
+            break;
+        CopyStageOutput(rqstrCachedOutput, qstrOutput);
+    }
+
+    return rqstrlStages.at(kpiStages[kiNumStages-1]);
+}
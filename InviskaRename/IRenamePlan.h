@@ -0,0 +1,154 @@
+#ifndef IRenamePlan_h
+#define IRenamePlan_h
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QVector>
+#include <QRegularExpression>
+#include "IMetaTagLookup.h"
+class IUIFileListModel;
+class IRenameInvalidCharSub;
+
+
+/* A single precompiled rename operation.  Operations are only compiled for settings that are enabled and complete, so applying one only
+ * needs to switch on its type.  Text that has no tag codes or RegEx references is used as it is without being scanned. */
+class IRenameOp
+{
+public:
+    // Operation types
+    enum OpType                 {ReplaceName, ReplaceText, InsertAt, InsertAtStart, InsertAtEnd, CropAt, CropLeft, CropRight, ChangeCase,
+                                 NumberAtStart, NumberAtEnd, NumberAt, RegExMatch, ReplaceMatch};
+
+    // Values for ChangeCase operations, which match the Change Case combo box
+    enum Case                   {CaseNoChange, CaseTitle, CaseSentance, CaseLower, CaseUpper};
+
+    int                         m_iType;
+
+    // Text to insert or replace with, and text to find for ReplaceText
+    QString                     m_qstrText;
+    QString                     m_qstrFind;
+
+    // m_qstrText compiled into literal text, tags and, for RegEx stages, $ references to capture groups, which is only rendered if it
+    // has tags or references
+    ITagTemplate                m_ttmpText;
+
+    // Position and number of characters for inserts and crops, or the case for ChangeCase, or the position and zero fill width for numbering
+    int                         m_iPos;
+    int                         m_iCount;
+
+    // First number and increment for numbering
+    int                         m_iStartNumber;
+    int                         m_iIncrement;
+
+    // Regular expression for RegExMatch, which is matched starting at m_iPos.  The tab optimises the expression when its pattern is set,
+    // and as QRegularExpression is implicitly shared every copy of the plan uses the same compiled pattern
+    QRegularExpression          m_qreRegEx;
+
+public:
+    IRenameOp(const int kiType = ReplaceName);
+};
+
+
+// A row whose preview name is being generated, with pointers to everything the plan writes so nothing in the model's row store is resized
+// or detached while the rows are being generated on several threads
+struct IRenamePreviewRow
+{
+    int                         m_iRow;
+    int                         m_iRenameIndex;
+
+    // Indicates if m_pqstrlStages holds valid stage outputs, and if the row's number must be regenerated
+    bool                        m_bCached;
+    bool                        m_bRenumber;
+
+    // Cached stage outputs for the row, indexed by IRenamePlan::Stage
+    QStringList*                m_pqstrlStages;
+
+    // Generated preview name
+    QString                     m_qstrPreviewName;
+};
+
+
+/* Rename settings compiled into a flat list of operations.  The tabs hold their settings in widgets, which can only be read on the GUI
+ * thread, so each tab compiles its settings into the plan once when the preview is generated, in stage order, and the plan is then applied
+ * to the rows without touching any widgets.  The operations of each stage are stored contiguously and the start of each stage is recorded,
+ * so a single stage can be re-run when its settings change.  Nothing in a compiled plan is modified and applying it only reads the model, so
+ * one plan can be shared by the threads generating the preview names, and a plan can be built and applied without any UI at all. */
+class IRenamePlan
+{
+public:
+    // Stages of name generation, which are also the IDs of the rename tabs.  NoStage is used when no stage's settings have changed
+    enum Stage                  {NoStage = -1, StageName, StageExtension, StageNumbering, StageRegExName1, StageRegExName2, StageRegExName3, StageRegExExten, NumStages};
+
+private:
+    // Operations of every stage, in stage order
+    QVector<IRenameOp>          m_qvecropOps;
+
+    // Index in m_qvecropOps of the first operation of each stage, with an extra entry for the end of the last stage
+    QVector<int>                m_qveciStageStart;
+
+    // Stage operations are currently being added to, and whether it's a RegEx stage
+    int                         m_iCurrentStage;
+    bool                        m_bRegExStage;
+
+    // Case sensitivity for "Replace The Text" and "Replace Match With" comparisons
+    Qt::CaseSensitivity         m_qcsCaseSensitivity;
+
+    // For replacing tag codes with values, which only reads lookup tables that aren't changed while the preview is generated
+    const IMetaTagLookup*       m_kpmtlMetaTagLookup;
+
+    // Substitutions applied to the final preview names, which aren't changed while the preview is generated either
+    const IRenameInvalidCharSub*    m_kpicsInvalidCharSub;
+
+public:
+    IRenamePlan(const IMetaTagLookup* kpmtlMetaTagLookup, const IRenameInvalidCharSub* kpicsInvalidCharSub, const Qt::CaseSensitivity kqcsCaseSensitivity);
+
+    // Starts adding operations to the passed stage.  Stages must be started in order and any stage that isn't started has no operations.
+    // Text added to a RegEx stage is checked for $ references to the capture groups of the stage's RegExMatch
+    void BeginStage(const int kiStage, const bool kbRegExStage = false);
+
+    // Add operations to the current stage
+    void AddTextOp(const int kiType, const QString & krqstrText, const QList<ITagInfo> & krqlstTags, const int kiPos = 0);
+    void AddReplaceTextOp(const QString & krqstrFind, const QString & krqstrText, const QList<ITagInfo> & krqlstTags);
+    void AddCropOp(const int kiType, const int kiPos, const int kiCount);
+    void AddChangeCaseOp(const int kiCase);
+    void AddNumberOp(const int kiType, const int kiStartNumber, const int kiIncrement, const int kiNumberCharWidth, const int kiPos = 0);
+    void AddRegExMatchOp(const QRegularExpression & krqreRegEx, const int kiStartPos);
+
+    // Indicates if the passed stage has any operations
+    bool StageEnabled(const int kiStage) const              {return m_qveciStageStart.at(kiStage) != m_qveciStageStart.at(kiStage+1);}
+
+    // Applies the operations of the passed stage to the passed string, which is the output of the previous stage.  kiRenameIndex is the
+    // position of the row among the rows being renamed, which numbering is based on
+    void GenerateStage(const int kiStage, QString & rqstrName, const IUIFileListModel* kpflmFileModel, const int kiRow, const int kiRenameIndex) const;
+
+    // Generates the preview name for the passed row.  The stages are run from the changed stage using the cached output of the stage before,
+    // and stop once a stage's output matches the cache, since later stages only depend on that output.  Invalid characters are substituted
+    // in the final name and invalid trailing characters removed, so the preview is exactly the name the file will be renamed to
+    void GeneratePreview(IRenamePreviewRow & rrprRow, const IUIFileListModel* kpflmFileModel, const int kiChangedStage) const;
+
+    // Converts the passed name to the passed IRenameOp::Case
+    static void ConvertCase(QString & rqstrName, const int kiCase);
+
+private:
+    // Appends the passed operation to the current stage
+    void AddOp(const IRenameOp & krropOp);
+
+    // Case conversion for names containing characters outside ASCII
+    static void ConvertCaseUnicode(QString & rqstrName, const int kiCase);
+
+    // Returns the text of a text operation with tag codes and RegEx references replaced
+    QString GetOpText(const IRenameOp & krropOp, const QRegularExpressionMatch & krqremRegExMatch, const IUIFileListModel* kpflmFileModel, const int kiRow) const;
+
+    // Copies the output of a stage into its cache entry, reusing the entry's buffer where it isn't shared and is large enough
+    static void CopyStageOutput(QString & rqstrCachedOutput, const QString & krqstrOutput);
+
+    // Strips off invalid characters from the end of the passed filename
+    static void RemoveInvalidTrailingCharacters(QString & rqstrFileName);
+
+    // Runs the passed sequence of stages for the name or extension of a row and returns the output of the last stage
+    const QString & RunStages(const int* kpiStages, const int kiNumStages, const QString & krqstrInput, IRenamePreviewRow & rrprRow, const bool kbRenumber,
+                              const IUIFileListModel* kpflmFileModel, const int kiChangedStage) const;
+};
+
+#endif // IRenamePlan_h
@@ -0,0 +1,39 @@
+#ifndef ISysDirEntry_h
+#define ISysDirEntry_h
+
+#include <QFileInfo>
+#include <QVector>
+#include <QMetaType>
+
+
+// A directory entry read by ISysDirEnumerator.  The type flags are worked out while the directory is read and the modified time is only
+// filled in if it was requested, so the file list can be populated and sorted without each QFileInfo having to stat the file again.
+class ISysDirEntry
+{
+public:
+    // QFileInfo for the entry, which is constructed from the path only so it hasn't stat'd the file
+    QFileInfo               m_qfiFileInfo;
+    QString                 m_qstrName;
+
+    // Type of entry.  Both are false for special files and broken symbolic links, which are only listed when system files are shown
+    bool                    m_bIsDir;
+    bool                    m_bIsFile;
+
+    // Modified time in milliseconds since the epoch, or -1 if it wasn't requested
+    qint64                  m_i64ModifiedMS;
+
+    // Inode and device of the entry, or 0 if they're not available on the current platform
+    quint64                 m_ui64Inode;
+    quint64                 m_ui64Device;
+
+    // Used when sorting by extension to store the extension so the MIME type only needs looking up once
+    QString                 m_qstrExtension;
+
+public:
+    ISysDirEntry() : m_bIsDir(false), m_bIsFile(false), m_i64ModifiedMS(-1), m_ui64Inode(0), m_ui64Device(0) {}
+};
+
+typedef QVector<ISysDirEntry> ISysDirEntryList;
+Q_DECLARE_METATYPE(ISysDirEntryList)
+
+#endif // ISysDirEntry_h
@@ -0,0 +1,285 @@
+#include <QDirIterator>
+#include <QDateTime>
+#include "ISysDirEnumerator.h"
+
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+// Layout of the records returned by getdents64, which glibc doesn't declare
+struct ISysLinuxDirent64
+{
+    quint64                 d_ino;
+    qint64                  d_off;
+    unsigned short          d_reclen;
+    unsigned char           d_type;
+    char                    d_name[1];
+};
+#endif
+
+
+ISysDirEnumerator::ISysDirEnumerator(const QString & krqstrPath, const QDir::Filters kqdirfFilter, const int kiAttributes, const int kiEnumerationID)
+{
+    m_qstrPath = krqstrPath;
+    m_qdirfFilter = kqdirfFilter;
+    m_iAttributes = kiAttributes;
+    m_iEnumerationID = kiEnumerationID;
+    m_bSendBatches = false;
+
+    connect(this, SIGNAL(finished()), this, SLOT(deleteLater()));
+}
+
+
+ISysDirEntryList ISysDirEnumerator::ReadAll()
+{
+    m_bSendBatches = false;
+    m_qvecdeEntries.clear();
+    ReadDirectory();
+    return m_qvecdeEntries;
+}
+
+
+void ISysDirEnumerator::run()
+{
+    m_bSendBatches = true;
+    m_qvecdeEntries.reserve(m_kiBatchSize);
+    m_qetBatchTimer.start();
+
+    if (ReadDirectory() == false || isInterruptionRequested())
+        return;
+
+    if (m_qvecdeEntries.isEmpty() == false)
+        SendBatch();
+    emit EnumerationComplete(m_iEnumerationID);
+}
+
+
+bool ISysDirEnumerator::ReadDirectory()
+{
+    #ifdef Q_OS_LINUX
+    return ReadDirectoryLinux();
+    #else
+    return ReadDirectoryGeneric();
+    #endif
+}
+
+
+#ifdef Q_OS_LINUX
+bool ISysDirEnumerator::ReadDirectoryLinux()
+{
+    const int kiDirFD = open(QFile::encodeName(m_qstrPath).constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (kiDirFD == -1)
+        return ReadDirectoryGeneric();
+
+    // All entries are on the same device as the directory, apart from mount points, which aren't renamed anyway
+    struct stat statDir;
+    const quint64 kui64Device = (fstat(kiDirFD, &statDir) == 0) ? statDir.st_dev : 0;
+
+    const bool kbListHidden = m_qdirfFilter & QDir::Hidden;
+    const bool kbReadModified = m_iAttributes & AttribModified;
+
+    char szBuffer[32768];
+    long lBytesRead;
+    while ((lBytesRead = syscall(SYS_getdents64, kiDirFD, szBuffer, sizeof(szBuffer))) > 0)
+    {
+        long lOffset = 0;
+        while (lOffset < lBytesRead)
+        {
+            const ISysLinuxDirent64* kpdirEntry = reinterpret_cast<const ISysLinuxDirent64*>(szBuffer + lOffset);
+            lOffset += kpdirEntry->d_reclen;
+
+            const char* kszName = kpdirEntry->d_name;
+            if (kszName[0] == '.' && (kszName[1] == '\0' || (kszName[1] == '.' && kszName[2] == '\0')))
+                continue;
+            if (kszName[0] == '.' && kbListHidden == false)
+                continue;
+
+            ISysDirEntry deEntry;
+            bool bTypeKnown = true;
+            switch (kpdirEntry->d_type)
+            {
+            case DT_DIR     :   deEntry.m_bIsDir = true;
+                                break;
+            case DT_REG     :   deEntry.m_bIsFile = true;
+                                break;
+            case DT_LNK     :
+            case DT_UNKNOWN :   bTypeKnown = false;
+                                break;
+            }
+
+            // Symbolic links are followed, as with QFileInfo, so they need a stat to find the type of the target
+            bool bModifiedRead = false;
+            if (bTypeKnown == false || kbReadModified)
+            {
+                #ifdef STATX_TYPE
+                struct statx stxEntry;
+                const unsigned int kuiMask = (bTypeKnown ? 0 : STATX_TYPE) | (kbReadModified ? STATX_MTIME : 0);
+                if (statx(kiDirFD, kszName, AT_STATX_SYNC_AS_STAT, kuiMask, &stxEntry) == 0)
+                {
+                    if (bTypeKnown == false && (stxEntry.stx_mask & STATX_TYPE))
+                    {
+                        deEntry.m_bIsDir = S_ISDIR(stxEntry.stx_mode);
+                        deEntry.m_bIsFile = S_ISREG(stxEntry.stx_mode);
+                        bTypeKnown = true;
+                    }
+                    if (kbReadModified && (stxEntry.stx_mask & STATX_MTIME))
+                    {
+                        deEntry.m_i64ModifiedMS = stxEntry.stx_mtime.tv_sec * 1000 + stxEntry.stx_mtime.tv_nsec / 1000000;
+                        bModifiedRead = true;
+                    }
+                }
+                #else
+                struct stat statEntry;
+                if (fstatat(kiDirFD, kszName, &statEntry, 0) == 0)
+                {
+                    deEntry.m_bIsDir = S_ISDIR(statEntry.st_mode);
+                    deEntry.m_bIsFile = S_ISREG(statEntry.st_mode);
+                    deEntry.m_i64ModifiedMS = statEntry.st_mtim.tv_sec * 1000 + statEntry.st_mtim.tv_nsec / 1000000;
+                    bTypeKnown = true;
+                    bModifiedRead = true;
+                }
+                #endif
+            }
+
+            if (TypeIncluded(deEntry) == false)
+                continue;
+
+            deEntry.m_qstrName = QFile::decodeName(kszName);
+            deEntry.m_qfiFileInfo = QFileInfo(GetEntryPath(deEntry.m_qstrName));
+            deEntry.m_ui64Inode = kpdirEntry->d_ino;
+            deEntry.m_ui64Device = kui64Device;
+            if (kbReadModified && bModifiedRead == false)
+                deEntry.m_i64ModifiedMS = deEntry.m_qfiFileInfo.lastModified().toMSecsSinceEpoch();
+
+            AddEntry(deEntry);
+        }
+
+        if (m_bSendBatches && isInterruptionRequested())
+        {
+            close(kiDirFD);
+            return false;
+        }
+    }
+
+    close(kiDirFD);
+
+    // The read can fail part way through with EIO, or with ESTALE or ENOENT on network file systems.  A partial listing would be merged as
+    // if the missing entries had been deleted, so the entries not yet sent are discarded and the directory is read again
+    if (lBytesRead < 0)
+    {
+        m_qvecdeEntries.clear();
+        return ReadDirectoryGeneric(m_qsetSentNames);
+    }
+
+    return true;
+}
+#endif
+
+
+bool ISysDirEnumerator::ReadDirectoryGeneric(const QSet<QString> & krqsetSkipNames)
+{
+    const bool kbReadModified = m_iAttributes & AttribModified;
+
+    QDirIterator qditDirIterator(m_qstrPath, m_qdirfFilter | QDir::NoDotAndDotDot);
+    while (qditDirIterator.hasNext())
+    {
+        if (m_bSendBatches && isInterruptionRequested())
+            return false;
+
+        qditDirIterator.next();
+
+        ISysDirEntry deEntry;
+        deEntry.m_qfiFileInfo = qditDirIterator.fileInfo();
+        deEntry.m_qstrName = deEntry.m_qfiFileInfo.fileName();
+        if (krqsetSkipNames.contains(deEntry.m_qstrName))
+            continue;
+        deEntry.m_bIsDir = deEntry.m_qfiFileInfo.isDir();
+        deEntry.m_bIsFile = deEntry.m_qfiFileInfo.isFile();
+        if (kbReadModified)
+            deEntry.m_i64ModifiedMS = deEntry.m_qfiFileInfo.lastModified().toMSecsSinceEpoch();
+
+        AddEntry(deEntry);
+    }
+
+    return true;
+}
+
+
+bool ISysDirEnumerator::ReadEntry(const QString & krqstrName, ISysDirEntry & rdeEntry) const
+{
+    rdeEntry = ISysDirEntry();
+    rdeEntry.m_qstrName = krqstrName;
+    rdeEntry.m_qfiFileInfo = QFileInfo(GetEntryPath(krqstrName));
+
+    const QFileInfo & krqfiFileInfo = rdeEntry.m_qfiFileInfo;
+    if (krqfiFileInfo.exists() == false && krqfiFileInfo.isSymLink() == false)
+        return false;
+    if ((m_qdirfFilter & QDir::Hidden) == false && krqfiFileInfo.isHidden())
+        return false;
+
+    rdeEntry.m_bIsDir = krqfiFileInfo.isDir();
+    rdeEntry.m_bIsFile = krqfiFileInfo.isFile();
+    if (TypeIncluded(rdeEntry) == false)
+        return false;
+
+    if (m_iAttributes & AttribModified)
+        rdeEntry.m_i64ModifiedMS = krqfiFileInfo.lastModified().toMSecsSinceEpoch();
+
+    // lstat() is used so the inode matches the one getdents64 reports for symbolic links
+    #ifdef Q_OS_LINUX
+    struct stat statEntry;
+    if (lstat(QFile::encodeName(krqfiFileInfo.filePath()).constData(), &statEntry) == 0)
+    {
+        rdeEntry.m_ui64Inode = statEntry.st_ino;
+        rdeEntry.m_ui64Device = statEntry.st_dev;
+    }
+    #endif
+
+    return true;
+}
+
+
+bool ISysDirEnumerator::TypeIncluded(const ISysDirEntry & krdeEntry) const
+{
+    // Broken links and special files such as sockets and devices are treated as system files, as they are by QDir
+    if (krdeEntry.m_bIsDir)
+        return m_qdirfFilter & QDir::Dirs;
+    if (krdeEntry.m_bIsFile)
+        return m_qdirfFilter & QDir::Files;
+    return (m_qdirfFilter & QDir::System) && (m_qdirfFilter & QDir::Files);
+}
+
+
+void ISysDirEnumerator::AddEntry(const ISysDirEntry & krdeEntry)
+{
+    m_qvecdeEntries.append(krdeEntry);
+
+    if (m_bSendBatches && (m_qvecdeEntries.size() >= m_kiBatchSize || m_qetBatchTimer.elapsed() >= m_kiBatchIntervalMS))
+        SendBatch();
+}
+
+
+void ISysDirEnumerator::SendBatch()
+{
+    #ifdef Q_OS_LINUX
+    ISysDirEntryList::const_iterator kitEntry;
+    for (kitEntry = m_qvecdeEntries.constBegin() ; kitEntry != m_qvecdeEntries.constEnd() ; ++kitEntry)
+        m_qsetSentNames.insert(kitEntry->m_qstrName);
+    #endif
+
+    emit EntriesRead(m_iEnumerationID, m_qvecdeEntries);
+    m_qvecdeEntries.clear();
+    m_qvecdeEntries.reserve(m_kiBatchSize);
+    m_qetBatchTimer.restart();
+}
+
+
+QString ISysDirEnumerator::GetEntryPath(const QString & krqstrName) const
+{
+    if (m_qstrPath.endsWith('/'))
+        return m_qstrPath + krqstrName;
+    return m_qstrPath + '/' + krqstrName;
+}
@@ -0,0 +1,92 @@
+#ifndef ISysDirEnumerator_h
+#define ISysDirEnumerator_h
+
+#include <QThread>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QSet>
+#include "ISysDirEntry.h"
+
+
+/* Reads the contents of a directory on a worker thread so the UI isn't blocked while large or slow (network) directories are read.
+ * Entries are passed back in batches via EntriesRead() so the file list can display the directory while it's being read.  The file list
+ * cancels the read with requestInterruption() when the user navigates elsewhere.  The object deletes itself when the thread finishes.
+ * ReadAll() performs the same read on the calling thread for refreshes that need the listing immediately.
+ * On Linux the directory is read in a single pass with getdents64, using d_type to tell files from folders, and statx is only called for
+ * entries whose type isn't known or when an attribute is requested, with the mask limited to what's needed. */
+class ISysDirEnumerator : public QThread
+{
+    Q_OBJECT
+
+public:
+    // Attributes that can be requested in addition to the entry type
+    enum Attributes             {AttribNone = 0x00, AttribModified = 0x01};
+
+private:
+    // Directory to read and the QDir filter to apply.  Only the Dirs, Files, Hidden and System flags are used
+    QString                     m_qstrPath;
+    QDir::Filters               m_qdirfFilter;
+
+    // Attributes to read for each entry
+    int                         m_iAttributes;
+
+    // ID passed with each signal so the file list can ignore queued batches from a read it has since cancelled
+    int                         m_iEnumerationID;
+
+    // Entries read since the last batch was sent, or the whole directory when reading via ReadAll()
+    ISysDirEntryList            m_qvecdeEntries;
+
+    // Indicates if entries should be sent in batches (thread) or kept until the read completes (ReadAll())
+    bool                        m_bSendBatches;
+    QElapsedTimer               m_qetBatchTimer;
+
+    #ifdef Q_OS_LINUX
+    // Names of the entries sent in batches so far, so they can be skipped if getdents64 fails and the directory is read again
+    QSet<QString>               m_qsetSentNames;
+    #endif
+
+    // A batch is sent once it holds this many entries or this much time has passed since the last batch, whichever comes first
+    const int                   m_kiBatchSize = 500;
+    const int                   m_kiBatchIntervalMS = 100;
+
+public:
+    ISysDirEnumerator(const QString & krqstrPath, const QDir::Filters kqdirfFilter, const int kiAttributes, const int kiEnumerationID = 0);
+
+    // Reads the whole directory on the calling thread and returns the entries
+    ISysDirEntryList ReadAll();
+
+    // Reads a single entry on the calling thread, returning false if it no longer exists or is excluded by the filter
+    bool ReadEntry(const QString & krqstrName, ISysDirEntry & rdeEntry) const;
+
+protected:
+    // Reads the directory, sending batches of entries until the read completes or interruption is requested
+    void run();
+
+private:
+    // Reads the directory, returning false if the read was interrupted.  If getdents64 fails part way through the Linux read, the directory
+    // is read again with QDirIterator rather than reporting a partial listing as complete, skipping the entries that have already been sent
+    bool ReadDirectory();
+    #ifdef Q_OS_LINUX
+    bool ReadDirectoryLinux();
+    #endif
+    bool ReadDirectoryGeneric(const QSet<QString> & krqsetSkipNames = QSet<QString>());
+
+    // Returns true if entries of this type are included by the filter
+    bool TypeIncluded(const ISysDirEntry & krdeEntry) const;
+
+    // Adds an entry to the current batch, sending the batch if it's full or enough time has passed
+    void AddEntry(const ISysDirEntry & krdeEntry);
+    void SendBatch();
+
+    // Returns the path of the entry with the passed name
+    QString GetEntryPath(const QString & krqstrName) const;
+
+signals:
+    // Sends the next batch of entries read from the directory
+    void EntriesRead(const int kiEnumerationID, const ISysDirEntryList & krqvecdeEntryList);
+
+    // Sent after the last batch if the read wasn't interrupted
+    void EnumerationComplete(const int kiEnumerationID);
+};
+
+#endif // ISysDirEnumerator_h
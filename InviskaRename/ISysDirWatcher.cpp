@@ -0,0 +1,225 @@
+#include <QFile>
+#include <QSocketNotifier>
+#include "ISysDirWatcher.h"
+
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#include <sys/inotify.h>
+
+// Events the directory is watched for.  IN_CLOSE_WRITE rather than IN_MODIFY is used so a file being written only reports one change
+static const quint32 kui32InotifyMask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_CLOSE_WRITE | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+#endif
+
+
+ISysDirWatcher::ISysDirWatcher(QObject* pqobjParent, const int kiCoalesceWindowMS, const bool kbUseNativeWatcher) : QObject(pqobjParent)
+{
+    m_iCoalesceWindowMS = kiCoalesceWindowMS;
+    m_bFullRefreshNeeded = false;
+    m_qtimCoalesceTimer.setSingleShot(true);
+
+    #ifdef Q_OS_LINUX
+    m_iInotifyFD = kbUseNativeWatcher ? inotify_init1(IN_NONBLOCK | IN_CLOEXEC) : -1;
+    m_iWatchDescriptor = -1;
+    m_pqsnInotifyNotifier = nullptr;
+    if (m_iInotifyFD != -1)
+    {
+        m_pqsnInotifyNotifier = new QSocketNotifier(m_iInotifyFD, QSocketNotifier::Read, this);
+        connect(m_pqsnInotifyNotifier, SIGNAL(activated(int)), this, SLOT(ReadInotifyEvents()));
+    }
+    #else
+    Q_UNUSED(kbUseNativeWatcher);
+    #endif
+
+    connect(&m_qfswFSWatcher,       SIGNAL(directoryChanged(const QString &)),  this, SLOT(DirectoryChanged(const QString &)));
+    connect(&m_qtimCoalesceTimer,   SIGNAL(timeout()),                          this, SLOT(SendChanges()));
+}
+
+
+ISysDirWatcher::~ISysDirWatcher()
+{
+    #ifdef Q_OS_LINUX
+    if (m_iInotifyFD != -1)
+    {
+        delete m_pqsnInotifyNotifier;
+        close(m_iInotifyFD);
+    }
+    #endif
+}
+
+
+void ISysDirWatcher::WatchDirectory(const QString & krqstrDirectory)
+{
+    Clear();
+
+    #ifdef Q_OS_LINUX
+    if (m_iInotifyFD != -1)
+    {
+        m_iWatchDescriptor = inotify_add_watch(m_iInotifyFD, QFile::encodeName(krqstrDirectory).constData(), kui32InotifyMask);
+        if (m_iWatchDescriptor != -1)
+        {
+            m_qstrDirectory = krqstrDirectory;
+            return;
+        }
+    }
+    #endif
+
+    if (m_qfswFSWatcher.addPath(krqstrDirectory))
+        m_qstrDirectory = krqstrDirectory;
+}
+
+
+void ISysDirWatcher::Clear()
+{
+    m_qtimCoalesceTimer.stop();
+    m_qetBurstTimer.invalidate();
+    m_qvecdcChanges.clear();
+    m_bFullRefreshNeeded = false;
+
+    #ifdef Q_OS_LINUX
+    m_qhashMoveFromChange.clear();
+    if (m_iWatchDescriptor != -1)
+    {
+        inotify_rm_watch(m_iInotifyFD, m_iWatchDescriptor);
+        m_iWatchDescriptor = -1;
+        m_qstrDirectory.clear();
+    }
+    #endif
+
+    if (m_qstrDirectory.isEmpty() == false)
+    {
+        m_qfswFSWatcher.removePath(m_qstrDirectory);
+        m_qstrDirectory.clear();
+    }
+}
+
+
+bool ISysDirWatcher::TakeChanges(ISysDirChangeList & rqvecdcChanges)
+{
+    const bool kbChangesKnown = (m_bFullRefreshNeeded == false);
+    rqvecdcChanges.swap(m_qvecdcChanges);
+    m_qvecdcChanges.clear();
+    m_bFullRefreshNeeded = false;
+    return kbChangesKnown;
+}
+
+
+void ISysDirWatcher::ChangeDetected()
+{
+    if (m_qetBurstTimer.isValid() == false)
+        m_qetBurstTimer.start();
+
+    if (m_qetBurstTimer.elapsed() >= m_iCoalesceWindowMS * m_kiMaxBurstWindows)
+        SendChanges();
+    else
+        m_qtimCoalesceTimer.start(m_iCoalesceWindowMS);
+}
+
+
+void ISysDirWatcher::DirectoryChanged(const QString & krqstrDirectory)
+{
+    if (krqstrDirectory != m_qstrDirectory)
+        return;
+
+    m_bFullRefreshNeeded = true;
+    ChangeDetected();
+}
+
+
+#ifdef Q_OS_LINUX
+void ISysDirWatcher::ReadInotifyEvents()
+{
+    alignas(struct inotify_event) char szBuffer[16384];
+    bool bChangeDetected = false;
+    ssize_t sszBytesRead;
+    while ((sszBytesRead = read(m_iInotifyFD, szBuffer, sizeof(szBuffer))) > 0)
+    {
+        ssize_t sszOffset = 0;
+        while (sszOffset < sszBytesRead)
+        {
+            const struct inotify_event* kpineEvent = reinterpret_cast<const struct inotify_event*>(szBuffer + sszOffset);
+            sszOffset += sizeof(struct inotify_event) + kpineEvent->len;
+
+            // If the event queue overflowed some changes have been lost
+            if (kpineEvent->mask & IN_Q_OVERFLOW)
+            {
+                m_bFullRefreshNeeded = true;
+                bChangeDetected = true;
+                continue;
+            }
+
+            // Events still queued for a directory that's no longer being watched are discarded
+            if (kpineEvent->wd != m_iWatchDescriptor || m_iWatchDescriptor == -1)
+                continue;
+
+            // If the directory itself is deleted or moved the watch is removed, so the directory is re-read to find out what happened
+            if (kpineEvent->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED | IN_UNMOUNT))
+            {
+                m_bFullRefreshNeeded = true;
+                bChangeDetected = true;
+                continue;
+            }
+
+            if (kpineEvent->len == 0)
+                continue;
+
+            const QString kqstrName = QFile::decodeName(kpineEvent->name);
+            if (kpineEvent->mask & IN_CREATE)
+            {
+                m_qvecdcChanges.append(ISysDirChange(ISysDirChange::Created, kqstrName));
+            }
+            else if (kpineEvent->mask & IN_DELETE)
+            {
+                m_qvecdcChanges.append(ISysDirChange(ISysDirChange::Deleted, kqstrName));
+            }
+            else if (kpineEvent->mask & IN_CLOSE_WRITE)
+            {
+                m_qvecdcChanges.append(ISysDirChange(ISysDirChange::Modified, kqstrName));
+            }
+            else if (kpineEvent->mask & IN_MOVED_FROM)
+            {
+                // Recorded as a deletion, which becomes a rename if the entry is moved back into the directory under a new name
+                m_qhashMoveFromChange.insert(kpineEvent->cookie, m_qvecdcChanges.size());
+                m_qvecdcChanges.append(ISysDirChange(ISysDirChange::Deleted, kqstrName));
+            }
+            else if (kpineEvent->mask & IN_MOVED_TO)
+            {
+                QHash<quint32, int>::iterator itMoveFrom = m_qhashMoveFromChange.find(kpineEvent->cookie);
+                if (itMoveFrom != m_qhashMoveFromChange.end())
+                {
+                    ISysDirChange & rdcChange = m_qvecdcChanges[*itMoveFrom];
+                    rdcChange.m_iType = ISysDirChange::Renamed;
+                    rdcChange.m_qstrNewName = kqstrName;
+                    m_qhashMoveFromChange.erase(itMoveFrom);
+                }
+                else
+                {
+                    m_qvecdcChanges.append(ISysDirChange(ISysDirChange::Created, kqstrName));
+                }
+            }
+            else
+            {
+                continue;
+            }
+
+            bChangeDetected = true;
+        }
+    }
+
+    if (bChangeDetected)
+        ChangeDetected();
+}
+#endif
+
+
+void ISysDirWatcher::SendChanges()
+{
+    m_qtimCoalesceTimer.stop();
+    m_qetBurstTimer.invalidate();
+
+    #ifdef Q_OS_LINUX
+    // A move out of the directory whose other half hasn't arrived by the end of the burst is left as a deletion
+    m_qhashMoveFromChange.clear();
+    #endif
+
+    emit ChangesReady();
+}
@@ -0,0 +1,119 @@
+#ifndef ISysDirWatcher_h
+#define ISysDirWatcher_h
+
+#include <QObject>
+#include <QFileSystemWatcher>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+class QSocketNotifier;
+
+
+// A change to a single entry in the watched directory, as reported by the native watcher
+class ISysDirChange
+{
+public:
+    enum ChangeType             {Created, Deleted, Modified, Renamed};
+
+    int                         m_iType;
+    QString                     m_qstrName;
+
+    // New name of the entry if it was renamed within the directory
+    QString                     m_qstrNewName;
+
+public:
+    ISysDirChange() : m_iType(Created) {}
+    ISysDirChange(const int kiType, const QString & krqstrName) : m_iType(kiType), m_qstrName(krqstrName) {}
+};
+
+typedef QVector<ISysDirChange> ISysDirChangeList;
+
+
+/* Watches the open directory for changes.  Only the directory itself is watched, rather than every file in it, so large directories don't
+ * use up the inotify watch limit on Linux.  Change notifications are coalesced: ChangesReady() is sent once no further changes have been
+ * seen for the coalesce window, or once a burst has lasted several windows, so a file manager copying thousands of files into the directory
+ * causes a handful of refreshes rather than one per file.
+ * On Linux the directory can be watched with inotify directly, which reports the name of each entry that was created, deleted, written or
+ * moved, with the two halves of a rename matched by cookie.  The changes are collected over the burst and taken with TakeChanges() so the
+ * file list can update just those rows.  QFileSystemWatcher only reports that something changed, so the directory must be re-read. */
+class ISysDirWatcher : public QObject
+{
+    Q_OBJECT
+
+private:
+    // Watcher for the directory and the path being watched
+    QFileSystemWatcher          m_qfswFSWatcher;
+    QString                     m_qstrDirectory;
+
+    // Restarted on each change so ChangesReady() is sent when the burst of changes ends
+    QTimer                      m_qtimCoalesceTimer;
+
+    // Time since the first change in the current burst, so a continuous stream of changes still refreshes periodically
+    QElapsedTimer               m_qetBurstTimer;
+
+    // Length of the coalesce window in milliseconds
+    int                         m_iCoalesceWindowMS;
+
+    // Maximum length of a burst, in coalesce windows, before ChangesReady() is sent regardless
+    const int                   m_kiMaxBurstWindows = 4;
+
+    // Changes collected during the current burst, and whether they're incomplete so the directory needs to be re-read instead
+    ISysDirChangeList           m_qvecdcChanges;
+    bool                        m_bFullRefreshNeeded;
+
+    #ifdef Q_OS_LINUX
+    // inotify instance and the watch descriptor of the directory, which is -1 if the directory is watched with QFileSystemWatcher
+    int                         m_iInotifyFD;
+    int                         m_iWatchDescriptor;
+    QSocketNotifier*            m_pqsnInotifyNotifier;
+
+    // Index into m_qvecdcChanges of the change recorded for each move out of the directory, so it can be turned into a rename if the
+    // matching move into the directory arrives
+    QHash<quint32, int>         m_qhashMoveFromChange;
+    #endif
+
+public:
+    ISysDirWatcher(QObject* pqobjParent, const int kiCoalesceWindowMS, const bool kbUseNativeWatcher);
+    ~ISysDirWatcher();
+
+    // Starts watching the passed directory in place of the current one
+    void WatchDirectory(const QString & krqstrDirectory);
+
+    // Stops watching the directory and discards any pending changes
+    void Clear();
+
+    // Moves the changes from the last burst into rqvecdcChanges.  Returns false if the changes aren't known, because QFileSystemWatcher is
+    // being used or inotify's queue overflowed, in which case the directory must be re-read
+    bool TakeChanges(ISysDirChangeList & rqvecdcChanges);
+
+    // Returns the directory being watched, which is empty if nothing is being watched
+    const QString & GetDirectory() const                    {return m_qstrDirectory;}
+
+    // Get and set the coalesce window
+    int GetCoalesceWindow() const                           {return m_iCoalesceWindowMS;}
+    void SetCoalesceWindow(const int kiCoalesceWindowMS)    {m_iCoalesceWindowMS = kiCoalesceWindowMS;}
+
+private:
+    // Starts or extends the current burst
+    void ChangeDetected();
+
+private slots:
+    // Called by QFileSystemWatcher when the directory changes
+    void DirectoryChanged(const QString & krqstrDirectory);
+
+    #ifdef Q_OS_LINUX
+    // Called when inotify has events to read
+    void ReadInotifyEvents();
+    #endif
+
+    // Called when the coalesce timer expires to end the burst
+    void SendChanges();
+
+signals:
+    // Sent once per burst of changes.  The changes can then be taken with TakeChanges()
+    void ChangesReady();
+};
+
+#endif // ISysDirWatcher_h
@@ -1,11 +1,12 @@
 #include "ISysFileInfoSort.h"
 #include "IUIFileList.h"
 #include "IUIMainWindow.h"
+#include "ISysDirEnumerator.h"
 
 
-ISysFileInfoSort::ISysFileInfoSort(IUIFileList* puifmFileList) : m_compFIName(m_qcolCollator),
-                                                                 m_compFIModified(m_qcolCollator),
-                                                                 m_compFIExtension(m_qcolCollator),
+ISysFileInfoSort::ISysFileInfoSort(IUIFileList* puifmFileList) : m_compDEName(m_qcolCollator),
+                                                                 m_compDEModified(m_qcolCollator),
+                                                                 m_compDEExtension(m_qcolCollator),
                                                                  m_compTWIName(m_qcolCollator),
                                                                  m_compTWIModified(m_qcolCollator),
                                                                  m_compTWIExtension(m_qcolCollator)
@@ -25,89 +26,87 @@ ISysFileInfoSort::~ISysFileInfoSort()
 }
 
 
-QFileInfoList ISysFileInfoSort::GetSortedFileList()
+void ISysFileInfoSort::SortEntryList(ISysDirEntryList & rqvecdeEntryList)
 {
+    ISysDirEntryList qvecdeDirList;
+    ISysDirEntryList qvecdeFileList;
+    qvecdeFileList.reserve(rqvecdeEntryList.size());
+
+    ISysDirEntryList::const_iterator kitEntry;
+    for (kitEntry = rqvecdeEntryList.constBegin() ; kitEntry != rqvecdeEntryList.constEnd() ; ++kitEntry)
+    {
+        if (kitEntry->m_bIsDir)
+            qvecdeDirList.append(*kitEntry);
+        else
+            qvecdeFileList.append(*kitEntry);
+    }
+
     switch (m_iSortOrder)
     {
-    case Name       : return GetSortedFileListName();
-    case Type       : return GetSortedFileListType();
-    case Modified   : return GetSortedFileListModified();
-    case Extension  : return GetSortedFileListExtension();
+    case Type       :   SortEntryListType(qvecdeDirList, qvecdeFileList);
+                        break;
+    case Modified   :   SortEntryListModified(qvecdeDirList, qvecdeFileList);
+                        break;
+    case Extension  :   SortEntryListExtension(qvecdeDirList, qvecdeFileList);
+                        break;
+    default         :   SortEntryListName(qvecdeDirList, qvecdeFileList);
     }
-    return GetSortedFileListName();
+
+    qvecdeDirList.append(qvecdeFileList);
+    rqvecdeEntryList = qvecdeDirList;
 }
 
 
-QFileInfoList ISysFileInfoSort::GetSortedFileListName()
+int ISysFileInfoSort::GetRequiredAttributes() const
 {
-    QFileInfoList qfilDirList = m_puifmFileList->GetDirectoryFileList(QDir::Dirs);
-    std::sort(qfilDirList.begin(), qfilDirList.end(), m_compFIName);
-
-    QFileInfoList qfilFileList = m_puifmFileList->GetDirectoryFileList(QDir::Files);
-    std::sort(qfilFileList.begin(), qfilFileList.end(), m_compFIName);
-
-    qfilDirList.append(qfilFileList);
-    return qfilDirList;
+    if (m_iSortOrder == Modified)
+        return ISysDirEnumerator::AttribModified;
+    return ISysDirEnumerator::AttribNone;
 }
 
 
-QFileInfoList ISysFileInfoSort::GetSortedFileListModified()
+void ISysFileInfoSort::SortEntryListName(ISysDirEntryList & rqvecdeDirList, ISysDirEntryList & rqvecdeFileList)
 {
-    QFileInfoList qfilDirList = m_puifmFileList->GetDirectoryFileList(QDir::Dirs);
-    std::sort(qfilDirList.begin(), qfilDirList.end(), m_compFIModified);
-
-    QFileInfoList qfilFileList = m_puifmFileList->GetDirectoryFileList(QDir::Files);
-    std::sort(qfilFileList.begin(), qfilFileList.end(), m_compFIModified);
-
-    qfilDirList.append(qfilFileList);
-    return qfilDirList;
+    std::sort(rqvecdeDirList.begin(), rqvecdeDirList.end(), m_compDEName);
+    std::sort(rqvecdeFileList.begin(), rqvecdeFileList.end(), m_compDEName);
 }
 
 
-QFileInfoList ISysFileInfoSort::GetSortedFileListExtension()
+void ISysFileInfoSort::SortEntryListModified(ISysDirEntryList & rqvecdeDirList, ISysDirEntryList & rqvecdeFileList)
 {
-    return GetSortedFileListExtension(true);
+    std::sort(rqvecdeDirList.begin(), rqvecdeDirList.end(), m_compDEModified);
+    std::sort(rqvecdeFileList.begin(), rqvecdeFileList.end(), m_compDEModified);
 }
 
 
-QFileInfoList ISysFileInfoSort::GetSortedFileListType()
+void ISysFileInfoSort::SortEntryListExtension(ISysDirEntryList & rqvecdeDirList, ISysDirEntryList & rqvecdeFileList)
 {
-    return GetSortedFileListExtension(false);
+    SortEntryListExtension(rqvecdeDirList, rqvecdeFileList, true);
 }
 
 
-QFileInfoList ISysFileInfoSort::GetSortedFileListExtension(const bool kbUseMIMEExtension)
+void ISysFileInfoSort::SortEntryListType(ISysDirEntryList & rqvecdeDirList, ISysDirEntryList & rqvecdeFileList)
 {
-    QFileInfoList qfilDirList = m_puifmFileList->GetDirectoryFileList(QDir::Dirs);
-    std::sort(qfilDirList.begin(), qfilDirList.end(), m_compFIName);
+    SortEntryListExtension(rqvecdeDirList, rqvecdeFileList, false);
+}
 
-    QFileInfoList qfilFileList = m_puifmFileList->GetDirectoryFileList(QDir::Files);
-    qfilDirList.reserve(qfilDirList.size() + qfilFileList.size());
 
-    QList<IFileExtension*> qlstFileExtensionList;
-    qlstFileExtensionList.reserve(qfilFileList.size());
+void ISysFileInfoSort::SortEntryListExtension(ISysDirEntryList & rqvecdeDirList, ISysDirEntryList & rqvecdeFileList, const bool kbUseMIMEExtension)
+{
+    std::sort(rqvecdeDirList.begin(), rqvecdeDirList.end(), m_compDEName);
 
-    QFileInfoList::iterator itFile;
+    ISysDirEntryList::iterator itFile;
     if (kbUseMIMEExtension)
     {
-        for (itFile = qfilFileList.begin() ; itFile < qfilFileList.end() ; ++itFile)
-            qlstFileExtensionList.append(new IFileExtension(*itFile, GetMIMEExtension(*itFile)));
+        for (itFile = rqvecdeFileList.begin() ; itFile < rqvecdeFileList.end() ; ++itFile)
+            itFile->m_qstrExtension = GetMIMEExtension(itFile->m_qfiFileInfo);
     }
     else
     {
-        for (itFile = qfilFileList.begin() ; itFile < qfilFileList.end() ; ++itFile)
-            qlstFileExtensionList.append(new IFileExtension(*itFile, GetExtension(*itFile)));
+        for (itFile = rqvecdeFileList.begin() ; itFile < rqvecdeFileList.end() ; ++itFile)
+            itFile->m_qstrExtension = GetExtension(itFile->m_qfiFileInfo);
     }
-    std::sort(qlstFileExtensionList.begin(), qlstFileExtensionList.end(), m_compFIExtension);
-
-    QList<IFileExtension*>::iterator itFileExten;
-    for (itFileExten = qlstFileExtensionList.begin() ; itFileExten < qlstFileExtensionList.end() ; ++itFileExten)
-    {
-        qfilDirList.append((*itFileExten)->m_rqfinfFile);
-        delete *itFileExten;
-    }
-
-    return qfilDirList;
+    std::sort(rqvecdeFileList.begin(), rqvecdeFileList.end(), m_compDEExtension);
 }
 
 
@@ -142,7 +141,7 @@ void ISysFileInfoSort::ResortRowsFileListExtension(QList<ITableRow*> & rqlstRowL
 {
     QList<ITableRow*>::iterator itTableRow;
     for (itTableRow = rqlstRowList.begin() ; itTableRow < rqlstRowList.end() ; ++itTableRow)
-        (*itTableRow)->m_qstrExtension = GetExtension((*itTableRow)->m_pqtwiCurrent->data(IUIFileList::FileInfo).value<QFileInfo>());
+        (*itTableRow)->m_qstrExtension = GetExtension((*itTableRow)->m_qfiFileInfo);
 
     std::sort(rqlstRowList.begin(), rqlstRowList.end(), m_compTWIExtension);
 }
@@ -152,7 +151,7 @@ void ISysFileInfoSort::ResortRowsFileListType(QList<ITableRow*> & rqlstRowList)
 {
     QList<ITableRow*>::iterator itTableRow;
     for (itTableRow = rqlstRowList.begin() ; itTableRow < rqlstRowList.end() ; ++itTableRow)
-        (*itTableRow)->m_qstrExtension = GetMIMEExtension((*itTableRow)->m_pqtwiCurrent->data(IUIFileList::FileInfo).value<QFileInfo>());
+        (*itTableRow)->m_qstrExtension = GetMIMEExtension((*itTableRow)->m_qfiFileInfo);
 
     std::sort(rqlstRowList.begin(), rqlstRowList.end(), m_compTWIExtension);
 }
@@ -5,6 +5,7 @@
 #include <QFileInfoList>
 #include <QMimeDatabase>
 #include "ISysFileInfoSortClasses.h"
+#include "ISysDirEntry.h"
 class IUIFileList;
 
 
@@ -21,9 +22,9 @@ private:
     QMimeDatabase           m_qmidbMimeDB;
 
     // Comparison classes for std::sort
-    IFICompareName          m_compFIName;
-    IFICompareModified      m_compFIModified;
-    IFICompareExtension     m_compFIExtension;
+    IDECompareName          m_compDEName;
+    IDECompareModified      m_compDEModified;
+    IDECompareExtension     m_compDEExtension;
     ITWICompareName         m_compTWIName;
     ITWICompareModified     m_compTWIModified;
     ITWICompareExtension    m_compTWIExtension;
@@ -41,18 +42,21 @@ public:
     ISysFileInfoSort(IUIFileList* puifmFileList);
     ~ISysFileInfoSort();
 
-    // Returns a sorted file list with directories first and natural number sorting
-    QFileInfoList GetSortedFileList();
+    // Sorts the passed directory listing with directories first and natural number sorting
+    void SortEntryList(ISysDirEntryList & rqvecdeEntryList);
+
+    // Returns the ISysDirEnumerator attributes that must be read for the current sort order
+    int GetRequiredAttributes() const;
 
 private:
-    // Returns file list sorted in specified order
-    QFileInfoList GetSortedFileListName();
-    QFileInfoList GetSortedFileListModified();
-    QFileInfoList GetSortedFileListExtension();
-    QFileInfoList GetSortedFileListType();
-
-    // Called by GetSortedFileListExtension() and GetSortedFileListType() to get sorted file list by extension
-    QFileInfoList GetSortedFileListExtension(const bool kbUseMIMEExtension);
+    // Sort the directory and file lists in the specified order
+    void SortEntryListName(ISysDirEntryList & rqvecdeDirList, ISysDirEntryList & rqvecdeFileList);
+    void SortEntryListModified(ISysDirEntryList & rqvecdeDirList, ISysDirEntryList & rqvecdeFileList);
+    void SortEntryListExtension(ISysDirEntryList & rqvecdeDirList, ISysDirEntryList & rqvecdeFileList);
+    void SortEntryListType(ISysDirEntryList & rqvecdeDirList, ISysDirEntryList & rqvecdeFileList);
+
+    // Called by SortEntryListExtension() and SortEntryListType() to sort the file list by extension
+    void SortEntryListExtension(ISysDirEntryList & rqvecdeDirList, ISysDirEntryList & rqvecdeFileList, const bool kbUseMIMEExtension);
 
 public:
     // Resorts passed table row list into the specified order
@@ -3,68 +3,57 @@
 
 #include <QCollator>
 #include <QFileInfo>
-#include <QTableWidgetItem>
+#include "ISysDirEntry.h"
 
 
-// Used to sort file by extension.  Stores extension to avoid repeatedly having to look up MIME type
-class IFileExtension
-{
-public:
-    QFileInfo &             m_rqfinfFile;
-    QString                 m_qstrExtension;
-
-public:
-    IFileExtension(QFileInfo & rqfinfFile, QString qstrExtension) : m_rqfinfFile(rqfinfFile), m_qstrExtension(qstrExtension) {}
-};
-
-
-// Used when resorting the table
+// Used when resorting the table.  Stores the row the entry was taken from so the model can be reordered once the list is sorted
 class ITableRow
 {
 public:
-    QTableWidgetItem*       m_pqtwiCurrent;
-    QTableWidgetItem*       m_pqtwiPreview;
+    int                     m_iRow;
+    QString                 m_qstrName;
+    QFileInfo               m_qfiFileInfo;
     QString                 m_qstrExtension;
 
 public:
-    ITableRow(QTableWidgetItem* pqtwiCurrent, QTableWidgetItem* pqtwiPreview) : m_pqtwiCurrent(pqtwiCurrent), m_pqtwiPreview(pqtwiPreview) {}
+    ITableRow(const int kiRow, const QString & krqstrName, const QFileInfo & krqfiFileInfo) : m_iRow(kiRow), m_qstrName(krqstrName), m_qfiFileInfo(krqfiFileInfo) {}
 };
 
 
-// For sorting QFileInfo objects by name
-class IFICompareName
+// For sorting directory entries by name
+class IDECompareName
 {
 private:
     QCollator &             m_rqcolCollator;
 public:
-    IFICompareName(QCollator & rqcolCollator) : m_rqcolCollator(rqcolCollator) {}
-    bool operator()(const QFileInfo & krqfiFile1, const QFileInfo & krqfiFile2) const;
+    IDECompareName(QCollator & rqcolCollator) : m_rqcolCollator(rqcolCollator) {}
+    bool operator()(const ISysDirEntry & krdeFile1, const ISysDirEntry & krdeFile2) const;
 };
 
 
-// For sorting QFileInfo objects by date modified
-class IFICompareModified
+// For sorting directory entries by date modified, which requires the entries to have been read with the modified attribute
+class IDECompareModified
 {
 private:
     QCollator &             m_rqcolCollator;
 public:
-    IFICompareModified(QCollator & rqcolCollator) : m_rqcolCollator(rqcolCollator) {}
-    bool operator()(const QFileInfo & krqfiFile1, const QFileInfo & krqfiFile2) const;
+    IDECompareModified(QCollator & rqcolCollator) : m_rqcolCollator(rqcolCollator) {}
+    bool operator()(const ISysDirEntry & krdeFile1, const ISysDirEntry & krdeFile2) const;
 };
 
 
-// For sorting QFileInfo objects by file extension
-class IFICompareExtension
+// For sorting directory entries by file extension, which must first be stored in m_qstrExtension
+class IDECompareExtension
 {
 private:
     QCollator &             m_rqcolCollator;
 public:
-    IFICompareExtension(QCollator & rqcolCollator) : m_rqcolCollator(rqcolCollator) {}
-    bool operator()(const IFileExtension * kpfieFile1, const IFileExtension * kpfieFile2) const;
+    IDECompareExtension(QCollator & rqcolCollator) : m_rqcolCollator(rqcolCollator) {}
+    bool operator()(const ISysDirEntry & krdeFile1, const ISysDirEntry & krdeFile2) const;
 };
 
 
-// For sorting QTableWidgetItem objects by name
+// For sorting table rows by name
 class ITWICompareName
 {
 private:
@@ -75,7 +64,7 @@ public:
 };
 
 
-// For sorting QTableWidgetItem objects by date modified
+// For sorting table rows by date modified
 class ITWICompareModified
 {
 private:
@@ -86,7 +75,7 @@ public:
 };
 
 
-// For sorting QTableWidgetItem objects by file extension
+// For sorting table rows by file extension
 class ITWICompareExtension
 {
 private:
@@ -0,0 +1,196 @@
+#include <QFile>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QMutexLocker>
+#include <QDebug>
+#include "ISysMetaCache.h"
+
+
+// Records are stored as the key followed by the record, which is read back in the same order
+static QDataStream & operator<<(QDataStream & rqdsStream, const ISysMetaCacheKey & krmckKey)
+{
+    rqdsStream << krmckKey.m_ui64Device << krmckKey.m_ui64Inode << krmckKey.m_qstrPath << krmckKey.m_i64Size << krmckKey.m_i64ModifiedMS;
+    return rqdsStream;
+}
+
+
+static QDataStream & operator>>(QDataStream & rqdsStream, ISysMetaCacheKey & rmckKey)
+{
+    rqdsStream >> rmckKey.m_ui64Device >> rmckKey.m_ui64Inode >> rmckKey.m_qstrPath >> rmckKey.m_i64Size >> rmckKey.m_i64ModifiedMS;
+    return rqdsStream;
+}
+
+
+static QDataStream & operator<<(QDataStream & rqdsStream, const ISysMetaCacheRecord & krmcrRecord)
+{
+    rqdsStream << krmcrRecord.m_ui32SettingsHash << krmcrRecord.m_qbtaTagsRead << krmcrRecord.m_bTagsPresent << krmcrRecord.m_qstrlTagValues;
+    return rqdsStream;
+}
+
+
+static QDataStream & operator>>(QDataStream & rqdsStream, ISysMetaCacheRecord & rmcrRecord)
+{
+    rqdsStream >> rmcrRecord.m_ui32SettingsHash >> rmcrRecord.m_qbtaTagsRead >> rmcrRecord.m_bTagsPresent >> rmcrRecord.m_qstrlTagValues;
+    return rqdsStream;
+}
+
+
+ISysMetaCache::ISysMetaCache(const QString & krqstrFilePath) : m_qstrFilePath(krqstrFilePath)
+{
+    m_bLoaded = false;
+    m_iRecordsInFile = 0;
+}
+
+
+void ISysMetaCache::Load()
+{
+    QMutexLocker qmlLocker(&m_qmtxLock);
+    if (m_bLoaded == false)
+        LoadFile();
+}
+
+
+bool ISysMetaCache::Lookup(const ISysMetaCacheKey & krmckKey, const quint32 kui32SettingsHash, const QBitArray & krqbtaRequiredTags, ISysMetaCacheRecord & rmcrRecord)
+{
+    QMutexLocker qmlLocker(&m_qmtxLock);
+    if (m_bLoaded == false)
+        LoadFile();
+
+    QHash<ISysMetaCacheKey, ISysMetaCacheRecord>::const_iterator kitRecord = m_qhashRecords.constFind(krmckKey);
+    if (kitRecord == m_qhashRecords.constEnd() || kitRecord.value().m_ui32SettingsHash != kui32SettingsHash)
+        return false;
+
+    // Files without tags are a hit whatever tags are required
+    if (kitRecord.value().m_bTagsPresent && (kitRecord.value().m_qbtaTagsRead & krqbtaRequiredTags) != krqbtaRequiredTags)
+        return false;
+
+    rmcrRecord = kitRecord.value();
+    return true;
+}
+
+
+void ISysMetaCache::Insert(const ISysMetaCacheKey & krmckKey, const ISysMetaCacheRecord & krmcrRecord)
+{
+    QMutexLocker qmlLocker(&m_qmtxLock);
+    m_qhashRecords.insert(krmckKey, krmcrRecord);
+    m_qvecqpairPending.append(qMakePair(krmckKey, krmcrRecord));
+}
+
+
+void ISysMetaCache::Flush()
+{
+    QMutexLocker qmlLocker(&m_qmtxLock);
+    if (m_qvecqpairPending.isEmpty())
+        return;
+
+    if (m_qhashRecords.size() > m_kiMaxRecords)
+    {
+        #ifdef QT_DEBUG
+        qDebug() << "Discarding Meta Cache:" << m_qstrFilePath << m_qhashRecords.size() << "Records";
+        #endif
+
+        // Only the records just read are kept, as they're the ones most likely to be needed again
+        m_qhashRecords.clear();
+        for (int iIndex = 0 ; iIndex < m_qvecqpairPending.size() ; ++iIndex)
+            m_qhashRecords.insert(m_qvecqpairPending.at(iIndex).first, m_qvecqpairPending.at(iIndex).second);
+        RewriteFile();
+    }
+    else if (m_iRecordsInFile + m_qvecqpairPending.size() > m_qhashRecords.size() * 2 + 1000)
+    {
+        RewriteFile();
+    }
+    else
+    {
+        AppendToFile(m_qvecqpairPending);
+    }
+
+    m_qvecqpairPending.clear();
+}
+
+
+void ISysMetaCache::LoadFile()
+{
+    m_bLoaded = true;
+
+    QFile qfiCacheFile(m_qstrFilePath);
+    if (qfiCacheFile.open(QIODevice::ReadOnly) == false)
+        return;
+
+    QDataStream qdsStream(&qfiCacheFile);
+    qdsStream.setVersion(QDataStream::Qt_5_6);
+
+    quint32 ui32Magic, ui32Version;
+    qdsStream >> ui32Magic >> ui32Version;
+    if (qdsStream.status() != QDataStream::Ok || ui32Magic != m_kui32FileMagic || ui32Version != m_kui32FileVersion)
+    {
+        qfiCacheFile.close();
+        qfiCacheFile.remove();
+        return;
+    }
+
+    ISysMetaCacheKey mckKey;
+    ISysMetaCacheRecord mcrRecord;
+    while (qdsStream.atEnd() == false)
+    {
+        qdsStream >> mckKey >> mcrRecord;
+        if (qdsStream.status() != QDataStream::Ok)
+            break;
+
+        m_qhashRecords.insert(mckKey, mcrRecord);
+        ++m_iRecordsInFile;
+    }
+
+    #ifdef QT_DEBUG
+    qDebug() << "Meta Cache Loaded:" << m_qstrFilePath << m_iRecordsInFile << "Records" << m_qhashRecords.size() << "Files";
+    #endif
+
+    // A record cut short by the application being closed mid-write would corrupt anything appended after it, so the file is rewritten
+    if (qdsStream.status() != QDataStream::Ok)
+    {
+        qfiCacheFile.close();
+        RewriteFile();
+    }
+}
+
+
+void ISysMetaCache::AppendToFile(const QVector<QPair<ISysMetaCacheKey, ISysMetaCacheRecord> > & krqvecqpairRecords)
+{
+    QFile qfiCacheFile(m_qstrFilePath);
+    if (qfiCacheFile.open(QIODevice::WriteOnly | QIODevice::Append) == false)
+        return;
+
+    QDataStream qdsStream(&qfiCacheFile);
+    qdsStream.setVersion(QDataStream::Qt_5_6);
+    if (qfiCacheFile.size() == 0)
+        qdsStream << m_kui32FileMagic << m_kui32FileVersion;
+
+    QVector<QPair<ISysMetaCacheKey, ISysMetaCacheRecord> >::const_iterator kitRecord;
+    for (kitRecord = krqvecqpairRecords.constBegin() ; kitRecord != krqvecqpairRecords.constEnd() ; ++kitRecord)
+        qdsStream << kitRecord->first << kitRecord->second;
+
+    m_iRecordsInFile += krqvecqpairRecords.size();
+}
+
+
+void ISysMetaCache::RewriteFile()
+{
+    #ifdef QT_DEBUG
+    qDebug() << "Rewriting Meta Cache:" << m_qstrFilePath << m_iRecordsInFile << "Records" << m_qhashRecords.size() << "Files";
+    #endif
+
+    // The new file replaces the old one only once it's been written completely
+    QSaveFile qsfCacheFile(m_qstrFilePath);
+    if (qsfCacheFile.open(QIODevice::WriteOnly) == false)
+        return;
+
+    QDataStream qdsStream(&qsfCacheFile);
+    qdsStream.setVersion(QDataStream::Qt_5_6);
+    qdsStream << m_kui32FileMagic << m_kui32FileVersion;
+
+    QHash<ISysMetaCacheKey, ISysMetaCacheRecord>::const_iterator kitRecord;
+    for (kitRecord = m_qhashRecords.constBegin() ; kitRecord != m_qhashRecords.constEnd() ; ++kitRecord)
+        qdsStream << kitRecord.key() << kitRecord.value();
+
+    if (qsfCacheFile.commit())
+        m_iRecordsInFile = m_qhashRecords.size();
+}
@@ -0,0 +1,111 @@
+#ifndef ISysMetaCache_h
+#define ISysMetaCache_h
+
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QVector>
+#include <QPair>
+#include <QMutex>
+#include <QBitArray>
+
+
+// Identifies a version of a file in the meta cache.  Files are identified by device and inode where available, so renamed files are still
+// found, and by path otherwise.  A file whose size or modified time has changed since its tags were cached won't match its record
+class ISysMetaCacheKey
+{
+public:
+    quint64                     m_ui64Device;
+    quint64                     m_ui64Inode;
+    QString                     m_qstrPath;
+    qint64                      m_i64Size;
+    qint64                      m_i64ModifiedMS;
+
+public:
+    ISysMetaCacheKey() : m_ui64Device(0), m_ui64Inode(0), m_i64Size(-1), m_i64ModifiedMS(-1) {}
+
+    bool operator==(const ISysMetaCacheKey & krmckOther) const
+    {
+        return m_ui64Inode == krmckOther.m_ui64Inode && m_ui64Device == krmckOther.m_ui64Device && m_i64Size == krmckOther.m_i64Size &&
+               m_i64ModifiedMS == krmckOther.m_i64ModifiedMS && m_qstrPath == krmckOther.m_qstrPath;
+    }
+};
+
+inline uint qHash(const ISysMetaCacheKey & krmckKey, uint uiSeed = 0)
+{
+    return qHash(krmckKey.m_ui64Inode, uiSeed) ^ qHash(krmckKey.m_i64ModifiedMS) ^ qHash(krmckKey.m_qstrPath);
+}
+
+
+// Tags cached for a file, which records files without tags too so they aren't opened again
+class ISysMetaCacheRecord
+{
+public:
+    // Hash of the settings the tag values were produced with, as the values have invalid characters and separators substituted
+    quint32                     m_ui32SettingsHash;
+
+    // Tags that were read from the file, as only the tags used by the rename at the time are read, and the values of the tags
+    QBitArray                   m_qbtaTagsRead;
+    bool                        m_bTagsPresent;
+    QStringList                 m_qstrlTagValues;
+
+public:
+    ISysMetaCacheRecord() : m_ui32SettingsHash(0), m_bTagsPresent(false) {}
+};
+
+
+/* Persistent cache of the tags read from files, so revisiting a directory doesn't open every file again.  The cache is held in memory as a
+ * hash and stored in an append-only file in the settings directory, with one cache per type of meta data.  Records added while reading a
+ * directory are appended to the file in one write by Flush(), and when the file is loaded later records replace earlier ones for the same
+ * key.  The file is rewritten without the replaced records once they make up most of it.  Lookups and inserts are made from the threads
+ * of the meta reader's pool, so every public function is thread safe. */
+class ISysMetaCache
+{
+private:
+    // Path of the cache file
+    QString                     m_qstrFilePath;
+
+    // Serialises access from the reader threads
+    QMutex                      m_qmtxLock;
+
+    // Indicates if the cache file has been loaded, which happens the first time the cache is used
+    bool                        m_bLoaded;
+
+    // Cached records, and records inserted since the last flush
+    QHash<ISysMetaCacheKey, ISysMetaCacheRecord>                    m_qhashRecords;
+    QVector<QPair<ISysMetaCacheKey, ISysMetaCacheRecord> >         m_qvecqpairPending;
+
+    // Number of records in the cache file, including records that have since been replaced
+    int                         m_iRecordsInFile;
+
+    // The cache is discarded once it holds this many records, which mostly happens once it's full of records for files that no longer exist
+    const int                   m_kiMaxRecords = 500000;
+
+    // Identifies the file format so a file written by a different version is discarded
+    const quint32               m_kui32FileMagic = 0x494D4331;
+    const quint32               m_kui32FileVersion = 2;
+
+public:
+    ISysMetaCache(const QString & krqstrFilePath);
+
+    // Loads the cache file if it hasn't been loaded yet
+    void Load();
+
+    // Sets rmcrRecord to the record for the passed key and returns true if there is one that was produced with the passed settings and
+    // includes all of the required tags
+    bool Lookup(const ISysMetaCacheKey & krmckKey, const quint32 kui32SettingsHash, const QBitArray & krqbtaRequiredTags, ISysMetaCacheRecord & rmcrRecord);
+
+    // Adds or replaces the record for the passed key.  The record isn't written to the cache file until Flush() is called
+    void Insert(const ISysMetaCacheKey & krmckKey, const ISysMetaCacheRecord & krmcrRecord);
+
+    // Appends the records inserted since the last flush to the cache file
+    void Flush();
+
+private:
+    // Loads, writes and rewrites the cache file, which must be called with m_qmtxLock locked
+    void LoadFile();
+    void AppendToFile(const QVector<QPair<ISysMetaCacheKey, ISysMetaCacheRecord> > & krqvecqpairRecords);
+    void RewriteFile();
+};
+
+#endif // ISysMetaCache_h
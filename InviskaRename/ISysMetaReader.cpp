@@ -0,0 +1,261 @@
+#include <QThreadPool>
+#include <QRunnable>
+#include <QMutexLocker>
+#include <QFileInfo>
+#include <QDateTime>
+#include <algorithm>
+#include "ISysMetaReader.h"
+#include "IComMetaMusic.h"
+#include "IComMetaExif.h"
+
+
+// Orders files by their distance from the visible rows in bands, and by inode within each band so they're read in roughly the order they're
+// stored on disk
+class ISysMetaReadItemOrderLessThan
+{
+private:
+    int                             m_iFirstRow;
+    int                             m_iLastRow;
+    int                             m_iBandSize;
+
+public:
+    ISysMetaReadItemOrderLessThan(const int kiFirstRow, const int kiLastRow, const int kiBandSize) :
+                                  m_iFirstRow(kiFirstRow), m_iLastRow(kiLastRow), m_iBandSize(kiBandSize) {}
+
+    bool operator()(const ISysMetaReadItem & krmriItemA, const ISysMetaReadItem & krmriItemB) const
+    {
+        const int kiBandA = GetBand(krmriItemA.m_iRow);
+        const int kiBandB = GetBand(krmriItemB.m_iRow);
+        if (kiBandA != kiBandB)
+            return kiBandA < kiBandB;
+        return krmriItemA.m_ui64Inode < krmriItemB.m_ui64Inode;
+    }
+
+    // Visible rows are in band 0
+    int GetBand(const int kiRow) const
+    {
+        if (kiRow < m_iFirstRow)
+            return 1 + (m_iFirstRow - kiRow) / m_iBandSize;
+        if (kiRow > m_iLastRow)
+            return 1 + (kiRow - m_iLastRow) / m_iBandSize;
+        return 0;
+    }
+};
+
+
+// Reads the tags of one file on a pool thread, writing them into the file's item, which nothing else touches until the pool is done
+class ISysMetaReadTask : public QRunnable
+{
+private:
+    const ISysMetaReader*           m_kpmrdReader;
+    ISysMetaReadItem &              m_rmriItem;
+
+public:
+    ISysMetaReadTask(const ISysMetaReader* kpmrdReader, ISysMetaReadItem & rmriItem) : m_kpmrdReader(kpmrdReader), m_rmriItem(rmriItem) {}
+
+    void run()                      {m_kpmrdReader->ReadItem(m_rmriItem);}
+};
+
+
+ISysMetaReader::ISysMetaReader(const int kiMetaType, const ISysMetaReadList & krqvecmriItems, const IRenameInvalidCharSub & kricsInvalidCharSub, const bool kbExifAdvancedMode,
+                               const QBitArray & krqbtaRequiredTags, const QSharedPointer<ISysMetaCache> & krqspmchMetaCache, const int kiReadID) :
+                               m_qbtaRequiredTags(krqbtaRequiredTags), m_qvecmriItems(krqvecmriItems), m_icsInvalidCharSub(kricsInvalidCharSub), m_qspmchMetaCache(krqspmchMetaCache)
+{
+    m_iMetaType = kiMetaType;
+    m_bExifAdvancedMode = kbExifAdvancedMode;
+    m_ui32SettingsHash = GetSettingsHash(kiMetaType, kricsInvalidCharSub, kbExifAdvancedMode);
+    m_iMusicReadStyle = IMetaMusic::GetReadStyle(krqbtaRequiredTags);
+    m_iReadID = kiReadID;
+    m_iPriorityFirstRow = 0;
+    m_iPriorityLastRow = -1;
+    m_bPriorityChanged = false;
+
+    connect(this, SIGNAL(finished()), this, SLOT(deleteLater()));
+}
+
+
+void ISysMetaReader::ReadItem(ISysMetaReadItem & rmriItem) const
+{
+    const QFileInfo kqfiFileInfo(rmriItem.m_qstrPath);
+    rmriItem.m_i64ModifiedMS = kqfiFileInfo.lastModified().toMSecsSinceEpoch();
+
+    // The path is only needed to identify the file where inodes aren't available
+    ISysMetaCacheKey mckKey;
+    mckKey.m_ui64Device = rmriItem.m_ui64Device;
+    mckKey.m_ui64Inode = rmriItem.m_ui64Inode;
+    if (rmriItem.m_ui64Inode == 0)
+        mckKey.m_qstrPath = rmriItem.m_qstrPath;
+    mckKey.m_i64Size = kqfiFileInfo.size();
+    mckKey.m_i64ModifiedMS = rmriItem.m_i64ModifiedMS;
+
+    ISysMetaCacheRecord mcrRecord;
+    if (m_qspmchMetaCache->Lookup(mckKey, m_ui32SettingsHash, m_qbtaRequiredTags, mcrRecord))
+    {
+        rmriItem.m_bTagsPresent = mcrRecord.m_bTagsPresent;
+        if (rmriItem.m_bTagsPresent == false)
+            return;
+
+        if (m_iMetaType == Music)
+            rmriItem.m_mmuMusicMeta.SetTagValues(mcrRecord.m_qstrlTagValues);
+        else
+            rmriItem.m_mexExifMeta.SetTagValues(mcrRecord.m_qstrlTagValues);
+        return;
+    }
+
+    if (m_iMetaType == Music)
+    {
+        IComMetaMusic mmuMusicMeta(rmriItem.m_qstrPath, m_iMusicReadStyle);
+        rmriItem.m_bTagsPresent = mmuMusicMeta.TagDataPresent();
+        if (rmriItem.m_bTagsPresent)
+        {
+            rmriItem.m_mmuMusicMeta = IMetaMusic(&mmuMusicMeta, m_icsInvalidCharSub, m_qbtaRequiredTags);
+            mcrRecord.m_qstrlTagValues = rmriItem.m_mmuMusicMeta.GetTagValues();
+        }
+    }
+    else
+    {
+        // Only the Exif segment at the start of the file is read, so each pool thread reads a few KB rather than the whole image
+        IComMetaExif mexExifMeta(rmriItem.m_qstrPath);
+        rmriItem.m_bTagsPresent = mexExifMeta.ExifDataPresent();
+        if (rmriItem.m_bTagsPresent)
+        {
+            rmriItem.m_mexExifMeta = IMetaExif(&mexExifMeta, m_icsInvalidCharSub, m_bExifAdvancedMode, m_qbtaRequiredTags);
+            mcrRecord.m_qstrlTagValues = rmriItem.m_mexExifMeta.GetTagValues();
+        }
+    }
+
+    mcrRecord.m_ui32SettingsHash = m_ui32SettingsHash;
+    mcrRecord.m_qbtaTagsRead = m_qbtaRequiredTags;
+    mcrRecord.m_bTagsPresent = rmriItem.m_bTagsPresent;
+    m_qspmchMetaCache->Insert(mckKey, mcrRecord);
+}
+
+
+void ISysMetaReader::PrioritiseRows(const int kiFirstRow, const int kiLastRow)
+{
+    QMutexLocker qmlLocker(&m_qmtxPriorityLock);
+    m_iPriorityFirstRow = kiFirstRow;
+    m_iPriorityLastRow = kiLastRow;
+    m_bPriorityChanged = true;
+}
+
+
+quint32 ISysMetaReader::GetSettingsHash(const int kiMetaType, const IRenameInvalidCharSub & kricsInvalidCharSub, const bool kbExifAdvancedMode)
+{
+    // Date, time and fraction separators are substituted into the values, and advanced mode reads more Exif tags
+    QString qstrSeparators;
+    qstrSeparators += IMetaBase::GetSeparatorDate();
+    qstrSeparators += IMetaBase::GetSeparatorTime();
+    qstrSeparators += IMetaBase::GetSeparatorFraction();
+    if (kiMetaType == Exif && kbExifAdvancedMode)
+        qstrSeparators += 'A';
+
+    return kricsInvalidCharSub.GetSettingsHash() ^ qHash(qstrSeparators);
+}
+
+
+void ISysMetaReader::run()
+{
+    int iFirstRow, iLastRow;
+    m_qmtxPriorityLock.lock();
+    iFirstRow = m_iPriorityFirstRow;
+    iLastRow = m_iPriorityLastRow;
+    m_bPriorityChanged = false;
+    m_qmtxPriorityLock.unlock();
+
+    std::stable_sort(m_qvecmriItems.begin(), m_qvecmriItems.end(), ISysMetaReadItemOrderLessThan(iFirstRow, iLastRow, m_kiBandSize));
+    m_qspmchMetaCache->Load();
+
+    const int kiNumItems = m_qvecmriItems.size();
+    QVector<bool> qvecbRead(kiNumItems, false);
+    QHash<int, int> qhashItemByRow;
+    qhashItemByRow.reserve(kiNumItems);
+    for (int iItem = 0 ; iItem < kiNumItems ; ++iItem)
+        qhashItemByRow.insert(m_qvecmriItems.at(iItem).m_iRow, iItem);
+
+    QThreadPool qtpReaderPool;
+    qtpReaderPool.setMaxThreadCount(qBound(1, QThread::idealThreadCount(), m_kiMaxOpenFiles));
+
+    QElapsedTimer qetBatchTimer;
+    qetBatchTimer.start();
+
+    ISysMetaReadList qvecmriBatch;
+    QVector<int> qveciBlock;
+    int iNextItem = 0;
+    int iNumRead = 0;
+    while (iNumRead < kiNumItems)
+    {
+        if (isInterruptionRequested())
+        {
+            m_qspmchMetaCache->Flush();
+            return;
+        }
+
+        // Tasks are started in read order and the pool runs them in the order they're started
+        GetNextBlock(qveciBlock, iNextItem, qvecbRead, qhashItemByRow);
+        QVector<int>::const_iterator kitItem;
+        for (kitItem = qveciBlock.constBegin() ; kitItem != qveciBlock.constEnd() ; ++kitItem)
+            qtpReaderPool.start(new ISysMetaReadTask(this, m_qvecmriItems[*kitItem]));
+        qtpReaderPool.waitForDone();
+
+        for (kitItem = qveciBlock.constBegin() ; kitItem != qveciBlock.constEnd() ; ++kitItem)
+        {
+            qvecbRead[*kitItem] = true;
+            qvecmriBatch.append(m_qvecmriItems.at(*kitItem));
+        }
+        iNumRead += qveciBlock.size();
+
+        // Newly read tags are written to the cache file with each batch, so little is lost if the application is closed mid-read
+        if (qetBatchTimer.elapsed() >= m_kiBatchIntervalMS || iNumRead == kiNumItems)
+        {
+            m_qspmchMetaCache->Flush();
+            emit TagsRead(m_iMetaType, m_iReadID, qvecmriBatch);
+            qvecmriBatch.clear();
+            qetBatchTimer.restart();
+        }
+    }
+
+    if (isInterruptionRequested() == false)
+        emit ReadComplete(m_iMetaType, m_iReadID);
+}
+
+
+void ISysMetaReader::GetNextBlock(QVector<int> & rqveciBlock, int & riNextItem, const QVector<bool> & krqvecbRead, const QHash<int, int> & krqhashItemByRow)
+{
+    rqveciBlock.clear();
+
+    // Rows scrolled into view are read first.  Rows are only looked up while the priority range still has unread rows
+    m_qmtxPriorityLock.lock();
+    const bool kbPriorityChanged = m_bPriorityChanged;
+    const int kiFirstRow = m_iPriorityFirstRow;
+    const int kiLastRow = m_iPriorityLastRow;
+    m_qmtxPriorityLock.unlock();
+
+    if (kbPriorityChanged)
+    {
+        QHash<int, int>::const_iterator kitItem;
+        for (int iRow = kiFirstRow ; iRow <= kiLastRow && rqveciBlock.size() < m_kiBlockSize ; ++iRow)
+        {
+            kitItem = krqhashItemByRow.constFind(iRow);
+            if (kitItem != krqhashItemByRow.constEnd() && krqvecbRead.at(kitItem.value()) == false)
+                rqveciBlock.append(kitItem.value());
+        }
+
+        // Once every row in the range has been handed out there's no need to check it again until it changes
+        if (rqveciBlock.size() < m_kiBlockSize)
+        {
+            QMutexLocker qmlLocker(&m_qmtxPriorityLock);
+            if (m_iPriorityFirstRow == kiFirstRow && m_iPriorityLastRow == kiLastRow)
+                m_bPriorityChanged = false;
+        }
+    }
+
+    // The rest of the block continues in read order, skipping items already read because they were prioritised
+    const int kiNumItems = m_qvecmriItems.size();
+    while (rqveciBlock.size() < m_kiBlockSize && riNextItem < kiNumItems)
+    {
+        if (krqvecbRead.at(riNextItem) == false && rqveciBlock.contains(riNextItem) == false)
+            rqveciBlock.append(riNextItem);
+        ++riNextItem;
+    }
+}
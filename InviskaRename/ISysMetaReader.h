@@ -0,0 +1,132 @@
+#ifndef ISysMetaReader_h
+#define ISysMetaReader_h
+
+#include <QThread>
+#include <QElapsedTimer>
+#include <QVector>
+#include <QHash>
+#include <QMetaType>
+#include <QSharedPointer>
+#include <QMutex>
+#include "IMetaMusic.h"
+#include "IMetaExif.h"
+#include "IRenameInvalidCharSub.h"
+#include "ISysMetaCache.h"
+
+
+// A file whose tags are to be read by ISysMetaReader, and the tags read from it
+class ISysMetaReadItem
+{
+public:
+    // Row of the file when the read was started and its name, so the row can be found again if the list has changed since
+    int                         m_iRow;
+    QString                     m_qstrName;
+
+    // Native path of the file and its inode and device, which are 0 if they aren't available on the current platform
+    QString                     m_qstrPath;
+    quint64                     m_ui64Inode;
+    quint64                     m_ui64Device;
+
+    // Modified time of the file when its tags were read, in milliseconds since the epoch
+    qint64                      m_i64ModifiedMS;
+
+    // Indicates if the file contained tags, and the tags read, where only the member for the reader's meta type is set
+    bool                        m_bTagsPresent;
+    IMetaMusic                  m_mmuMusicMeta;
+    IMetaExif                   m_mexExifMeta;
+
+public:
+    ISysMetaReadItem() : m_iRow(-1), m_ui64Inode(0), m_ui64Device(0), m_i64ModifiedMS(-1), m_bTagsPresent(false) {}
+};
+
+typedef QVector<ISysMetaReadItem> ISysMetaReadList;
+Q_DECLARE_METATYPE(ISysMetaReadList)
+
+
+/* Reads the music or Exif tags of a list of files on a worker thread so the UI isn't blocked while a large library is read.  Files are read
+ * by a small pool of threads, starting with the rows visible in the file list and spreading outward in bands, with the files in each band
+ * read in order of inode, which roughly follows their position on disk.  When the list is scrolled the file list calls PrioritiseRows()
+ * and any unread rows in the new viewport are read next.  Each pool thread only has one file open at a
+ * time, so the number of open files is bounded by the size of the pool.  Tags are passed back in batches via TagsRead() so the preview can
+ * be updated as the files are read.  Tags are looked up in the meta cache before a file is opened and tags read from files are added to
+ * it, so a directory that has been read before only needs its files stat'd.  The file list cancels the read with requestInterruption(), which is checked between batches, and the
+ * object deletes itself when the thread finishes. */
+class ISysMetaReader : public QThread
+{
+    Q_OBJECT
+
+public:
+    // Types of meta data that can be read, which the file list also uses to index its readers
+    enum MetaType               {Music, Exif, NumMetaTypes};
+
+private:
+    // Type of meta data being read, whether all Exif tags are read or just the basic subset, and the tags used by the rename, which are
+    // the only tags read
+    int                         m_iMetaType;
+    bool                        m_bExifAdvancedMode;
+    QBitArray                   m_qbtaRequiredTags;
+
+    // IComMetaMusic::ReadStyle for the required tags, so audio properties are only worked out if an audio property tag is used
+    int                         m_iMusicReadStyle;
+
+    // Files to read, which are sorted into read order when the thread starts
+    ISysMetaReadList            m_qvecmriItems;
+
+    // Rows to read first, which PrioritiseRows() sets from the GUI thread, and whether they've changed since the reader last checked
+    QMutex                      m_qmtxPriorityLock;
+    int                         m_iPriorityFirstRow;
+    int                         m_iPriorityLastRow;
+    bool                        m_bPriorityChanged;
+
+    // Copy of the invalid character substitutions so the Preferences dialog can't change them while files are being read
+    IRenameInvalidCharSub       m_icsInvalidCharSub;
+
+    // Cache for this type of meta data, which is shared with the file list, and the hash of the settings that tag values depend on
+    QSharedPointer<ISysMetaCache>   m_qspmchMetaCache;
+    quint32                     m_ui32SettingsHash;
+
+    // ID passed with each signal so the file list can ignore queued batches from a read it has since cancelled
+    int                         m_iReadID;
+
+    // Maximum number of threads reading files, and so maximum number of open files.  More threads than this just cause more seeking on
+    // spinning disks without reading any faster
+    const int                   m_kiMaxOpenFiles = 8;
+
+    // Files are handed to the pool in blocks of this size, with interruption checked between blocks.  Read files are sent once this much
+    // time has passed since the last batch, so fast disks don't cause the preview to be regenerated for every block
+    const int                   m_kiBlockSize = 64;
+    const int                   m_kiBatchIntervalMS = 250;
+
+    // Number of rows in each band spreading outward from the visible rows
+    const int                   m_kiBandSize = 256;
+
+public:
+    ISysMetaReader(const int kiMetaType, const ISysMetaReadList & krqvecmriItems, const IRenameInvalidCharSub & kricsInvalidCharSub, const bool kbExifAdvancedMode,
+                   const QBitArray & krqbtaRequiredTags, const QSharedPointer<ISysMetaCache> & krqspmchMetaCache, const int kiReadID);
+
+    // Reads the tags of a single file on the calling thread, from the meta cache if the file hasn't changed since it was cached
+    void ReadItem(ISysMetaReadItem & rmriItem) const;
+
+    // Sets the range of rows to read next, which is the viewport of the file list.  Can be called from any thread while the reader runs
+    void PrioritiseRows(const int kiFirstRow, const int kiLastRow);
+
+    // Returns the hash of the settings that the values of the passed type of meta data depend on
+    static quint32 GetSettingsHash(const int kiMetaType, const IRenameInvalidCharSub & kricsInvalidCharSub, const bool kbExifAdvancedMode);
+
+protected:
+    // Reads the files in batches until all files have been read or interruption is requested
+    void run();
+
+private:
+    // Fills rqveciBlock with the indexes of the next unread items, starting with any unread items in the priority rows
+    void GetNextBlock(QVector<int> & rqveciBlock, int & riNextItem, const QVector<bool> & krqvecbRead, const QHash<int, int> & krqhashItemByRow);
+
+signals:
+    // Sends the next batch of files with the tags read from them
+    void TagsRead(const int kiMetaType, const int kiReadID, const ISysMetaReadList & krqvecmriItems);
+
+    // Sent after the last batch if the read wasn't interrupted
+    void ReadComplete(const int kiMetaType, const int kiReadID);
+};
+
+#endif // ISysMetaReader_h
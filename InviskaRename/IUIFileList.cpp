@@ -1,5 +1,7 @@
 ﻿#include <QtWidgets>
+#include <QtConcurrent>
 #include "IUIFileList.h"
+#include "IUIFileListModel.h"
 #include "IUIMainWindow.h"
 #include "IUIMenuBar.h"
 #include "IUIMenuTags.h"
@@ -21,7 +23,26 @@
 #include "IMetaMusic.h"
 #include "IMetaExif.h"
 #include "ISysFileInfoSortClasses.h"
+#include "ISysDirEnumerator.h"
+#include "ISysMetaReader.h"
 #include "IRenameLegacySave.h"
+#include "IRenamePlan.h"
+
+
+// Functor for QtConcurrent which generates the preview name of a row using the shared plan
+class IPreviewRowGenerator
+{
+private:
+    const IRenamePlan &         m_krplPlan;
+    const IUIFileListModel*     m_kpflmFileModel;
+    const int                   m_kiChangedStage;
+
+public:
+    IPreviewRowGenerator(const IRenamePlan & krplPlan, const IUIFileListModel* kpflmFileModel, const int kiChangedStage) :
+                            m_krplPlan(krplPlan), m_kpflmFileModel(kpflmFileModel), m_kiChangedStage(kiChangedStage) {}
+
+    void operator()(IRenamePreviewRow & rrprRow) const      {m_krplPlan.GeneratePreview(rrprRow, m_kpflmFileModel, m_kiChangedStage);}
+};
 
 
 IUIFileList::IUIFileList(IUIMainWindow* pmwMainWindow) : QSplitter(Qt::Horizontal, pmwMainWindow),
@@ -34,14 +55,29 @@ IUIFileList::IUIFileList(IUIMainWindow* pmwMainWindow) : QSplitter(Qt::Horizonta
 {
     setChildrenCollapsible(false);
     m_bSyncSelection = true;
+    m_iNumFilesToRename = 0;
+    m_iPreviewNumFilesToRename = -1;
+    m_bPreviewStagesStale = false;
     m_qstrMyComputerPath = "Computer";
     m_pmwMainWindow = pmwMainWindow;
     m_bMetaTagsReadMusic = false;
     m_bMetaTagsReadExif = false;
-
-    // Loading embeded executable and folder icons is slow, so use generic icons
-    m_qicnExeIcon = m_qfipIconProvider.icon(QFileInfo("NonExistant.exe"));
-    m_qfipIconProvider.setOptions(QFileIconProvider::DontUseCustomDirectoryIcons);
+    m_pdenDirEnumerator = nullptr;
+    m_iEnumerationID = 0;
+    m_bDirChangedDuringRead = false;
+    m_bUndoPending = false;
+    for (int iType = 0 ; iType < ISysMetaReader::NumMetaTypes ; ++iType)
+    {
+        m_rgpmrdMetaReader[iType] = nullptr;
+        m_rgpdprgMetaProgress[iType] = nullptr;
+        m_rgiMetaReadID[iType] = 0;
+        m_rgiMetaFilesRead[iType] = 0;
+    }
+    const QString kqstrSettingsDir = QFileInfo(m_rqsetSettings.fileName()).absolutePath();
+    m_rgqspmchMetaCache[ISysMetaReader::Music] = QSharedPointer<ISysMetaCache>(new ISysMetaCache(kqstrSettingsDir + "/MusicTagCache.dat"));
+    m_rgqspmchMetaCache[ISysMetaReader::Exif]  = QSharedPointer<ISysMetaCache>(new ISysMetaCache(kqstrSettingsDir + "/ExifTagCache.dat"));
+    qRegisterMetaType<ISysDirEntryList>("ISysDirEntryList");
+    qRegisterMetaType<ISysMetaReadList>("ISysMetaReadList");
 
     m_rqsetSettings.beginGroup("FileList");
     m_bAutoRefresh = m_rqsetSettings.value("AutoRefreshDirectories", true).toBool();
@@ -55,6 +91,7 @@ IUIFileList::IUIFileList(IUIMainWindow* pmwMainWindow) : QSplitter(Qt::Horizonta
     m_iUserDefinedRowHeight = m_rqsetSettings.value("UserDefinedRowHeight", 0).toInt();
     m_bUseAlternativeFont = m_rqsetSettings.value("UseAlternativeFont", false).toBool();
     QString qstrFileListFont = m_rqsetSettings.value("FileListFont", "").toString();
+    m_pdwDirWatcher = new ISysDirWatcher(this, m_rqsetSettings.value("AutoRefreshWindowMS", 250).toInt(), m_rqsetSettings.value("NativeDirWatcher", true).toBool());
     m_rqsetSettings.endGroup();
 
     m_rqsetSettings.beginGroup("Rename");
@@ -72,15 +109,21 @@ IUIFileList::IUIFileList(IUIMainWindow* pmwMainWindow) : QSplitter(Qt::Horizonta
     m_qdirDirReader.setSorting(QDir::NoSort);
     SetHiddenFileFilter();
 
-    ItitialiseTable(m_pqtwNameCurrent, tr("Current Name"));
-    ItitialiseTable(m_pqtwNamePreview, tr("Preview"));
-    m_pqtwNameCurrent->setItemDelegateForColumn(0, new CurrentTableHighlightDelegate(this));
-    m_pqtwNamePreview->setItemDelegateForColumn(0, new PreviewTableHighlightDelegate(this));
+    m_pflmFileModel = new IUIFileListModel(this);
+    ItitialiseTable(m_pqtvNameCurrent, IUIFileListModel::ColumnCurrent);
+    ItitialiseTable(m_pqtvNamePreview, IUIFileListModel::ColumnPreview);
+    m_pqtvNameCurrent->setItemDelegateForColumn(IUIFileListModel::ColumnCurrent, new CurrentTableHighlightDelegate(this));
+    m_pqtvNamePreview->setItemDelegateForColumn(IUIFileListModel::ColumnPreview, new PreviewTableHighlightDelegate(this));
+
+    // Both tables share one selection model, so a selection made in either table is shown in both without syncing
+    QItemSelectionModel* pqismPreviewSelection = m_pqtvNamePreview->selectionModel();
+    m_pqtvNamePreview->setSelectionModel(m_pqtvNameCurrent->selectionModel());
+    delete pqismPreviewSelection;
 
-    m_pqtwNameCurrent->setContextMenuPolicy(Qt::CustomContextMenu);
+    m_pqtvNameCurrent->setContextMenuPolicy(Qt::CustomContextMenu);
     CreateContextMenus();
 
-    m_qfntDefaultFont = m_pqtwNameCurrent->font();
+    m_qfntDefaultFont = m_pqtvNameCurrent->font();
     if (m_bUseAlternativeFont && qstrFileListFont.isEmpty() == false)
     {
         QFont qfntFileListFont;
@@ -89,42 +132,59 @@ IUIFileList::IUIFileList(IUIMainWindow* pmwMainWindow) : QSplitter(Qt::Horizonta
     }
     SetRowHeightAndIconSize();
 
-    QScrollBar *pqsbScrollBarCurrent = m_pqtwNameCurrent->verticalScrollBar();
-    QScrollBar *pqsbScrollBarPreview = m_pqtwNamePreview->verticalScrollBar();
+    QScrollBar *pqsbScrollBarCurrent = m_pqtvNameCurrent->verticalScrollBar();
+    QScrollBar *pqsbScrollBarPreview = m_pqtvNamePreview->verticalScrollBar();
     connect(pqsbScrollBarCurrent,   SIGNAL(valueChanged(int)),                  this, SLOT(SyncScrollPreviewToCurrent()));
     connect(pqsbScrollBarPreview,   SIGNAL(valueChanged(int)),                  this, SLOT(SyncScrollCurrentToPreview()));
+    connect(pqsbScrollBarCurrent,   SIGNAL(valueChanged(int)),                  this, SLOT(PrioritiseVisibleRows()));
 
-    connect(m_pqtwNameCurrent,      SIGNAL(itemSelectionChanged()),             this, SLOT(SelectionChanged()));
-    connect(m_pqtwNamePreview,      SIGNAL(itemSelectionChanged()),             this, SLOT(SelectionChanged()));
+    connect(m_pqtvNameCurrent->selectionModel(), SIGNAL(selectionChanged(const QItemSelection &, const QItemSelection &)), this, SLOT(SelectionChanged()));
 
-    connect(m_pqtwNameCurrent,      SIGNAL(cellDoubleClicked(int, int)),        this, SLOT(OpenItemAtRow(int)));
-    connect(m_pqtwNamePreview,      SIGNAL(cellDoubleClicked(int, int)),        this, SLOT(OpenItemAtRow(int)));
+    connect(m_pqtvNameCurrent,      SIGNAL(doubleClicked(const QModelIndex &)), this, SLOT(OpenItemAtIndex(const QModelIndex &)));
+    connect(m_pqtvNamePreview,      SIGNAL(doubleClicked(const QModelIndex &)), this, SLOT(OpenItemAtIndex(const QModelIndex &)));
 
-    connect(m_pqtwNameCurrent,      SIGNAL(customContextMenuRequested(QPoint)), this, SLOT(ShowContextMenu(QPoint)));
+    connect(m_pqtvNameCurrent,      SIGNAL(customContextMenuRequested(QPoint)), this, SLOT(ShowContextMenu(QPoint)));
 
-    connect(&m_qfswFSWatcher,       SIGNAL(directoryChanged(const QString &)),  this, SLOT(DirectoryChanged(const QString &)));
-    connect(&m_qfswFSWatcher,       SIGNAL(fileChanged(const QString &)),       this, SLOT(FileChanged(const QString &)));
+    connect(m_pdwDirWatcher,        SIGNAL(ChangesReady()),                     this, SLOT(DirectoryChanged()));
+}
+
+
+IUIFileList::~IUIFileList()
+{
+    // Make sure every read thread has stopped before the file list it reports to is destroyed.  This includes cancelled reads, which may
+    // still be reading files and writing to the meta caches.  All threads are interrupted before waiting so they can finish in parallel
+    QList<QPointer<QThread> >::const_iterator kitThread;
+    for (kitThread = m_qlstpqthrWorkerThreads.constBegin() ; kitThread != m_qlstpqthrWorkerThreads.constEnd() ; ++kitThread)
+    {
+        if (kitThread->isNull() == false)
+            (*kitThread)->requestInterruption();
+    }
+    for (kitThread = m_qlstpqthrWorkerThreads.constBegin() ; kitThread != m_qlstpqthrWorkerThreads.constEnd() ; ++kitThread)
+    {
+        if (kitThread->isNull() == false)
+            (*kitThread)->wait();
+    }
 }
 
 
-void IUIFileList::ItitialiseTable(QTableWidget* & rpqtwTable, const QString & krqstrTitle)
+void IUIFileList::ItitialiseTable(QTableView* & rpqtvTable, const int kiColumn)
 {
-    rpqtwTable = new QTableWidget(this);
-    rpqtwTable->setColumnCount(1);
+    rpqtvTable = new QTableView(this);
+    rpqtvTable->setModel(m_pflmFileModel);
+    rpqtvTable->setColumnHidden(kiColumn == IUIFileListModel::ColumnCurrent ? IUIFileListModel::ColumnPreview : IUIFileListModel::ColumnCurrent, true);
 
-    QTableWidgetItem* pqtwiHeader = new QTableWidgetItem;
-    pqtwiHeader->setText(krqstrTitle);
-    rpqtwTable->setHorizontalHeaderItem(0, pqtwiHeader);
-    rpqtwTable->setStyleSheet("QTableWidget::item { padding: 0px; }");
-    rpqtwTable->verticalHeader()->setMinimumSectionSize(16);
+    rpqtvTable->setStyleSheet("QTableView::item { padding: 0px; }");
+    rpqtvTable->verticalHeader()->setMinimumSectionSize(16);
 
-    rpqtwTable->setEditTriggers(QAbstractItemView::NoEditTriggers);                     // Items not editable
-    rpqtwTable->setWordWrap(false);                                                     // Disable word wrapping when contents won't fit in cell.
-    rpqtwTable->verticalHeader()->hide();                                               // No row lables
-    rpqtwTable->horizontalHeader()->setSectionsClickable(false);                        // Column headers not clickable
-    rpqtwTable->horizontalHeader()->setStretchLastSection(true);                        // Expand last column to fill full space (there's only one column)
+    rpqtvTable->setSelectionBehavior(QAbstractItemView::SelectRows);                    // Select whole rows, as the selection model is shared by both tables
+    rpqtvTable->setSelectionMode(QAbstractItemView::ExtendedSelection);                 // Allow multiple rows to be selected
+    rpqtvTable->setEditTriggers(QAbstractItemView::NoEditTriggers);                     // Items not editable
+    rpqtvTable->setWordWrap(false);                                                     // Disable word wrapping when contents won't fit in cell.
+    rpqtvTable->verticalHeader()->hide();                                               // No row lables
+    rpqtvTable->horizontalHeader()->setSectionsClickable(false);                        // Column headers not clickable
+    rpqtvTable->horizontalHeader()->setStretchLastSection(true);                        // Expand last column to fill full space (there's only one visible column)
 
-    addWidget(rpqtwTable);
+    addWidget(rpqtvTable);
 }
 
 
@@ -231,13 +291,6 @@ void IUIFileList::SaveSessionSettings()
 }
 
 
-QFileInfoList IUIFileList::GetDirectoryFileList(QDir::Filters m_qdirfFileFilter)
-{
-    m_qdirDirReader.setFilter(m_qdirfFileFilter | m_qdirfHiddenFileFilter);
-    return m_qdirDirReader.entryInfoList();
-}
-
-
 void IUIFileList::OpenDirectory(QString qstrPath)
 {
     QString qstrCurrentDir = m_bDisplayingMyComputer ? m_qstrMyComputerPath : m_qdirDirReader.path();
@@ -294,7 +347,6 @@ bool IUIFileList::SetDirectory(QString qstrPath)
 
     m_qdirDirReader.setPath(qstrPath);
     PopulateTablesDirectory();
-    GeneratePreviewNameAndExtension();
     return true;
 }
 
@@ -304,49 +356,102 @@ void IUIFileList::PopulateTablesDirectory()
     m_bDisplayingMyComputer = false;
 
     ClearTableContents();
-    QFileInfoList qfilFileList = m_ifisFileSort.GetSortedFileList();
-    m_pqtwNameCurrent->setRowCount(qfilFileList.size());
-    m_pqtwNamePreview->setRowCount(qfilFileList.size());
 
-    int iRow = 0;
-    QIcon qicnFileIcon;
-    QTableWidgetItem* pqtwiCurrentItem;
-    QTableWidgetItem* pqtwiPreviewItem;
-    QFileInfoList::const_iterator kitFile;
-    for (kitFile = qfilFileList.constBegin() ; kitFile != qfilFileList.constEnd() ; ++kitFile)
-    {
-        pqtwiCurrentItem = new QTableWidgetItem;
-        pqtwiCurrentItem->setText(kitFile->fileName());
-        pqtwiCurrentItem->setData(FileInfo, QVariant::fromValue(*kitFile));
-        m_pqtwNameCurrent->setItem(iRow, 0, pqtwiCurrentItem);
+    m_rpuitbToolBar->SetAddressBarText(QDir::toNativeSeparators(m_qdirDirReader.path()));
+    #ifdef Q_OS_WIN
+    m_rpuimbMenuBar->EnableUpAction(true);
+    #else
+    m_rpuimbMenuBar->EnableUpAction(!m_qdirDirReader.isRoot());
+    #endif
 
-        pqtwiPreviewItem = new QTableWidgetItem;
-        m_pqtwNamePreview->setItem(iRow, 0, pqtwiPreviewItem);
+    // Nothing can be renamed until the read completes and the preview has been generated for the sorted list
+    m_rpuirRenameUI->EnableRenameButton(false);
+    StartDirectoryRead();
+}
 
-        #ifdef Q_OS_WIN
-        qicnFileIcon = (kitFile->suffix().toLower() == "exe" ? m_qicnExeIcon : m_qfipIconProvider.icon(*kitFile));
-        #else
-        qicnFileIcon = m_qfipIconProvider.icon(*kitFile);
-        #endif
-        pqtwiCurrentItem->setIcon(qicnFileIcon);
-        pqtwiPreviewItem->setIcon(qicnFileIcon);
 
-        if (kitFile->isFile())
-            m_qfswFSWatcher.addPath(kitFile->filePath());
+void IUIFileList::StartDirectoryRead()
+{
+    CancelDirectoryRead();
 
-        ++iRow;
-    }
+    m_pdwDirWatcher->WatchDirectory(m_qdirDirReader.path());
+    m_bDirChangedDuringRead = false;
 
-    const QString kqstrCurrentPath = m_qdirDirReader.path();
-    m_qfswFSWatcher.addPath(kqstrCurrentPath);
-    m_rpuitbToolBar->SetAddressBarText(QDir::toNativeSeparators(kqstrCurrentPath));
-    #ifdef Q_OS_WIN
-    m_rpuimbMenuBar->EnableUpAction(true);
-    #else
-    m_rpuimbMenuBar->EnableUpAction(!m_qdirDirReader.isRoot());
+    m_pdenDirEnumerator = new ISysDirEnumerator(m_qdirDirReader.path(), QDir::Dirs | QDir::Files | m_qdirfHiddenFileFilter, m_ifisFileSort.GetRequiredAttributes(), ++m_iEnumerationID);
+    connect(m_pdenDirEnumerator, SIGNAL(EntriesRead(const int, const ISysDirEntryList &)),  this, SLOT(AddEnumeratedEntries(const int, const ISysDirEntryList &)));
+    connect(m_pdenDirEnumerator, SIGNAL(EnumerationComplete(const int)),                    this, SLOT(DirectoryReadComplete(const int)));
+    StartWorkerThread(m_pdenDirEnumerator);
+}
+
+
+void IUIFileList::CancelDirectoryRead()
+{
+    m_qvecdeEnumeratedEntries.clear();
+
+    if (m_pdenDirEnumerator == nullptr)
+        return;
+
+    #ifdef QT_DEBUG
+    qDebug() << "Cancelling Directory Read:" << m_iEnumerationID;
     #endif
 
+    // Batches that have already been queued will still be delivered, but they're ignored as the enumeration ID no longer matches
+    m_pdenDirEnumerator->requestInterruption();
+    m_pdenDirEnumerator = nullptr;
+}
+
+
+void IUIFileList::AddEnumeratedEntries(const int kiEnumerationID, const ISysDirEntryList & krqvecdeEntryList)
+{
+    if (kiEnumerationID != m_iEnumerationID || m_pdenDirEnumerator == nullptr)
+        return;
+
+    m_qvecdeEnumeratedEntries.append(krqvecdeEntryList);
+    m_pflmFileModel->AppendEntries(krqvecdeEntryList);
+}
+
+
+void IUIFileList::DirectoryReadComplete(const int kiEnumerationID)
+{
+    if (kiEnumerationID != m_iEnumerationID || m_pdenDirEnumerator == nullptr)
+        return;
+
+    m_pdenDirEnumerator = nullptr;
+
+    #ifdef QT_DEBUG
+    qDebug() << "Directory Read Complete:" << m_qvecdeEnumeratedEntries.size() << "Entries";
+    #endif
+
+    ISysDirEntryList qvecdeEntryList;
+    qvecdeEntryList.swap(m_qvecdeEnumeratedEntries);
+    m_ifisFileSort.SortEntryList(qvecdeEntryList);
+
+    m_bSyncSelection = false;
+    m_pflmFileModel->SetEntryList(qvecdeEntryList);
+    m_bSyncSelection = true;
+
+    // An undo requested during the read is performed now, unless a different directory has been opened since, in which case the undo is
+    // left available.  The undo re-reads the directory, so the tags are read and the preview generated when that read completes
+    if (m_bUndoPending)
+    {
+        m_bUndoPending = false;
+        if (m_qdirDirReader.path() == m_qstrUndoDirectory)
+        {
+            PerformUndo();
+            return;
+        }
+        m_rpuirRenameUI->EnableUndoButton(true);
+    }
+
+    // Changes made during the read are applied now that every row they could refer to is in the model
+    if (m_bDirChangedDuringRead)
+    {
+        m_bDirChangedDuringRead = false;
+        DirectoryChanged();
+    }
+
     ReadMetaTags();
+    GeneratePreviewNameAndExtension();
 }
 
 
@@ -355,146 +460,72 @@ void IUIFileList::PopulateTablesComputer()
     m_bDisplayingMyComputer = true;
 
     ClearTableContents();
+
+    // No read will complete to perform an undo that was waiting for the last directory, so it's left available instead
+    if (m_bUndoPending)
+    {
+        m_bUndoPending = false;
+        m_rpuirRenameUI->EnableUndoButton(true);
+    }
     QFileInfoList qfilFileList = m_qdirDirReader.drives();
-    m_pqtwNameCurrent->setRowCount(qfilFileList.size());
-    m_pqtwNamePreview->setRowCount(qfilFileList.size());
 
-    int iRow = 0;
-    QIcon qicnFileIcon;
-    QString qstrDriveName;
+    QStringList qstrlDriveNames;
+    qstrlDriveNames.reserve(qfilFileList.size());
     QStorageInfo qsiDriveInfo;
-    QTableWidgetItem* pqtwiCurrentItem;
-    QTableWidgetItem* pqtwiPreviewItem;
     QFileInfoList::const_iterator kitFile;
-
     for (kitFile = qfilFileList.constBegin() ; kitFile != qfilFileList.constEnd() ; ++kitFile)
     {
         qsiDriveInfo.setPath(kitFile->path());
         if (qsiDriveInfo.isValid() && qsiDriveInfo.isReady())
-            qstrDriveName = qsiDriveInfo.displayName() + " (" + kitFile->path().at(0) + ":)";
+            qstrlDriveNames.append(qsiDriveInfo.displayName() + " (" + kitFile->path().at(0) + ":)");
         else
-            qstrDriveName = tr("Removable Disk") + " (" + kitFile->path().at(0) + ":)";
-
-        qicnFileIcon = m_qfipIconProvider.icon(*kitFile);
-
-        pqtwiCurrentItem = new QTableWidgetItem;
-        pqtwiCurrentItem->setText(qstrDriveName);
-        pqtwiCurrentItem->setIcon(qicnFileIcon);
-        pqtwiCurrentItem->setData(FileInfo, QVariant::fromValue(*kitFile));
-        m_pqtwNameCurrent->setItem(iRow, 0, pqtwiCurrentItem);
-
-        pqtwiPreviewItem = new QTableWidgetItem;
-        pqtwiPreviewItem->setText(qstrDriveName);
-        pqtwiPreviewItem->setIcon(qicnFileIcon);
-        m_pqtwNamePreview->setItem(iRow, 0, pqtwiPreviewItem);
-
-        ++iRow;
+            qstrlDriveNames.append(tr("Removable Disk") + " (" + kitFile->path().at(0) + ":)");
     }
 
+    m_pflmFileModel->SetDriveList(qfilFileList, qstrlDriveNames);
+
     m_rpuitbToolBar->SetAddressBarText(m_qstrMyComputerPath);
     m_rpuimbMenuBar->EnableUpAction(false);
     m_rpuimbMenuBar->EnableBackAction(!m_qsqstrBackStack.isEmpty());
     m_rpuimbMenuBar->EnableForwardAction(!m_qsqstrForwardStack.isEmpty());
 
-    // Here we should add the directory to the QFileSystemWatcher list, but you can't put a QFileSystemWatcher on Computer or  m_qdirDirReader.drives().
+    // Here we should add the directory to the directory watcher, but you can't put a QFileSystemWatcher on Computer or  m_qdirDirReader.drives().
     // This means the Computer view won't update when drives are added/removed.  Not sure how to handle this.
 }
 
 
 void IUIFileList::ClearTableContents()
 {
+    CancelDirectoryRead();
+    CancelMetaTagsRead(ISysMetaReader::Music);
+    CancelMetaTagsRead(ISysMetaReader::Exif);
+
     m_bMetaTagsReadMusic = false;
     m_bMetaTagsReadExif = false;
+    m_rgqbtaTagsRead[ISysMetaReader::Music].clear();
+    m_rgqbtaTagsRead[ISysMetaReader::Exif].clear();
 
     ClearFSWatcher();
 
     m_bSyncSelection = false;
-    m_pqtwNameCurrent->clearContents();
-    m_pqtwNamePreview->clearContents();
+    m_pflmFileModel->Clear();
     m_bSyncSelection = true;
 }
 
 
 void IUIFileList::ClearFSWatcher()
 {
-    #ifdef QT_DEBUG
-    if (m_qfswFSWatcher.directories().isEmpty() == false)
-    {
-        QStringList qstrlList = m_qfswFSWatcher.directories();
-        QStringList::const_iterator itItem;
-        for (itItem = qstrlList.constBegin() ; itItem != qstrlList.constEnd() ; ++itItem)
-        {
-            if (m_qfswFSWatcher.removePath(*itItem) == false)
-                qDebug() << "Failed to remove directory: " << *itItem;
-        }
-    }
-    if (m_qfswFSWatcher.files().isEmpty() == false)
-    {
-        QStringList qstrlList = m_qfswFSWatcher.files();
-        QStringList::const_iterator itItem;
-        for (itItem = qstrlList.constBegin() ; itItem != qstrlList.constEnd() ; ++itItem)
-        {
-            if (m_qfswFSWatcher.removePath(*itItem) == false)
-                 qDebug() << "Failed to remove file: " << *itItem;
-        }
-    }
-    #else
-    if (m_qfswFSWatcher.directories().isEmpty() == false)
-        m_qfswFSWatcher.removePaths(m_qfswFSWatcher.directories());
-    if (m_qfswFSWatcher.files().isEmpty() == false)
-        m_qfswFSWatcher.removePaths(m_qfswFSWatcher.files());
-    #endif
+    m_pdwDirWatcher->Clear();
 }
 
 
 void IUIFileList::RefreshDirectoryPostRename()
 {
-    m_qdirDirReader.refresh();
-    QFileInfoList qfilFileList = GetDirectoryFileList(QDir::AllEntries);
-    m_qfswFSWatcher.addPath(m_qdirDirReader.path());
-
-    int iIndex;
-    QList<int> qlstRowsToValidate;
-    int iSize = m_pqtwNameCurrent->rowCount();
-    qlstRowsToValidate.reserve(iSize);
-    for (iIndex = 0 ; iIndex < iSize ; ++iIndex)
-        qlstRowsToValidate.append(iIndex);
-
-    QString qstrFileName;
-    QFileInfo qfiFile;
-    QTableWidgetItem* pqtwiRowItem;
-    const int kiFileCount = qfilFileList.size();
-    for (int iFileListIndex = 0 ; iFileListIndex < kiFileCount ; ++iFileListIndex)
-    {
-        qfiFile = qfilFileList.at(iFileListIndex);
-        qstrFileName = qfiFile.fileName();
-        if (qfiFile.isFile())
-            m_qfswFSWatcher.addPath(qfiFile.filePath());
-
-        iSize = qlstRowsToValidate.size();
-        for (iIndex = 0 ; iIndex < iSize ; ++iIndex)
-        {
-            pqtwiRowItem = m_pqtwNameCurrent->item(qlstRowsToValidate.at(iIndex), 0);
-            if (pqtwiRowItem->text() == qstrFileName)
-            {
-                if (qstrFileName != pqtwiRowItem->data(FileInfo).value<QFileInfo>().fileName())
-                {
-                    #ifdef QT_DEBUG
-                    qDebug() << "File Renamed From:" << pqtwiRowItem->data(FileInfo).value<QFileInfo>().fileName() <<  "To:" << qstrFileName;
-                    #endif
-
-                    pqtwiRowItem->setData(FileInfo, QVariant::fromValue(qfiFile));
-                    pqtwiRowItem->setIcon(m_qfipIconProvider.icon(qfiFile));
-                    m_pqtwNamePreview->item(qlstRowsToValidate.at(iIndex), 0)->setIcon(m_qfipIconProvider.icon(qfiFile));
-                }
-
-                qlstRowsToValidate.removeAt(iIndex);
-                break;
-            }
-        }
-    }
+    // The rename loop updates the name and file info of each row as it's renamed, so the directory doesn't need to be re-read and matched
+    // against the table.  The watcher is cleared before renaming so the rename doesn't trigger a refresh of its own.
+    m_pdwDirWatcher->WatchDirectory(m_qdirDirReader.path());
 
-    GeneratePreviewNameAndExtension();
+    GeneratePreview(IUIRename::NoTab);
 }
 
 
@@ -512,151 +543,381 @@ void IUIFileList::RefreshDirectoryHard()
         m_qdirDirReader.refresh();
         PopulateTablesDirectory();
         m_bSyncSelection = true;
-
-        GeneratePreviewNameAndExtension();
     }
 }
 
 
 void IUIFileList::RefreshDirectorySoft()
 {
-    if (m_bDisplayingMyComputer)
+    // If the directory is still being read there's no complete listing to compare against, so the read is restarted
+    if (m_bDisplayingMyComputer || m_pdenDirEnumerator != nullptr)
     {
         RefreshDirectoryHard();
         return;
     }
 
-    m_qdirDirReader.refresh();
-    QFileInfoList qfilFileList = m_ifisFileSort.GetSortedFileList();
+    // Only the directory is watched, so files modified in place are found by comparing modified times, which are only needed if the meta
+    // data read from the files may have changed
+    int iAttributes = m_ifisFileSort.GetRequiredAttributes();
+    if (m_bMetaTagsReadMusic || m_bMetaTagsReadExif || ReadingMetaTags())
+        iAttributes |= ISysDirEnumerator::AttribModified;
 
-    QList<int> qlstRowsToRemove;
-    QList<int> qlstFilesToAdd;
-
-    int iIndex;
-    int iSize = m_pqtwNameCurrent->rowCount();
-    qlstRowsToRemove.reserve(iSize);
-    for (iIndex = 0 ; iIndex < iSize ; ++iIndex)
-        qlstRowsToRemove.append(iIndex);
+    ISysDirEnumerator idenDirReader(m_qdirDirReader.path(), QDir::Dirs | QDir::Files | m_qdirfHiddenFileFilter, iAttributes);
+    ISysDirEntryList qvecdeEntryList = idenDirReader.ReadAll();
+    m_ifisFileSort.SortEntryList(qvecdeEntryList);
 
-    QString qstrFileName;
-    QTableWidgetItem* pqtwiRowItem;
-    const int kiFileCount = qfilFileList.size();
-    for (int iFileListIndex = 0 ; iFileListIndex < kiFileCount ; ++iFileListIndex)
-    {
-        qstrFileName = qfilFileList.at(iFileListIndex).fileName();
-
-        iSize = qlstRowsToRemove.size();
-        for (iIndex = 0 ; iIndex < iSize ; ++iIndex)
-        {
-            pqtwiRowItem = m_pqtwNameCurrent->item(qlstRowsToRemove.at(iIndex), 0);
-            if (pqtwiRowItem->text() == qstrFileName)
-            {
-                qlstRowsToRemove.removeAt(iIndex);
-                break;
-            }
-        }
-        if (iIndex == iSize)
-            qlstFilesToAdd.push_back(iFileListIndex);
-    }
+    QStringList qstrlRemovedPaths;
+    QVector<int> qveciChangedRows;
+    QVector<int> qveciModifiedRows;
+    m_bSyncSelection = false;
+    m_pflmFileModel->MergeEntryList(qvecdeEntryList, qstrlRemovedPaths, qveciChangedRows, qveciModifiedRows);
+    m_bSyncSelection = true;
 
-    if (qlstRowsToRemove.isEmpty() == false)
-        RemoveRows(qlstRowsToRemove);
+    #ifdef QT_DEBUG
+    qDebug() << "-=Files Removed=-";
+    for (int iIndex = 0 ; iIndex < qstrlRemovedPaths.size() ; ++iIndex)
+         qDebug() << qstrlRemovedPaths.at(iIndex);
+    #endif
 
-    if (qlstFilesToAdd.isEmpty() == false)
-        AddFiles(qlstFilesToAdd, qfilFileList);
+    qveciChangedRows += qveciModifiedRows;
+    if (qveciChangedRows.isEmpty() == false)
+        ReReadChangedRows(qveciChangedRows);
 
-    if (qlstFilesToAdd.isEmpty() == false || qlstRowsToRemove.isEmpty() == false)
+    if (qveciChangedRows.isEmpty() == false || qstrlRemovedPaths.isEmpty() == false)
     {
         #ifdef QT_DEBUG
         qDebug() << "Regenerating Names After Directory Change";
         #endif
 
-        GeneratePreviewNameAndExtension();
+        GeneratePreview(IUIRename::NoTab);
     }
 }
 
 
-void IUIFileList::RemoveRows(const QList<int> & krqlstRemoveRows)
+void IUIFileList::ReReadChangedRows(const QVector<int> & krqveciChangedRows)
 {
     #ifdef QT_DEBUG
-    qDebug() << "-=Files To Remove=-";
-    for (int iIndex = 0 ; iIndex < krqlstRemoveRows.size() ; ++iIndex)
-         qDebug() << m_pqtwNameCurrent->item(krqlstRemoveRows.at(iIndex), 0)->text();
+    qDebug() << "-=Files Added Or Modified=-";
+    for (int iIndex = 0 ; iIndex < krqveciChangedRows.size() ; ++iIndex)
+        qDebug() << m_pflmFileModel->GetNameCurrent(krqveciChangedRows.at(iIndex));
     #endif
 
-    QList<int>::const_reverse_iterator ritRowNum;
-    for (ritRowNum = krqlstRemoveRows.rbegin() ; ritRowNum != krqlstRemoveRows.rend() ; ++ritRowNum)
+    const bool kbReadMusic = m_bMetaTagsReadMusic || ReadingMetaTags(ISysMetaReader::Music);
+    const bool kbReadExif  = m_bMetaTagsReadExif  || ReadingMetaTags(ISysMetaReader::Exif);
+    if (kbReadMusic == false && kbReadExif == false)
+        return;
+
+    QVector<int>::const_iterator kitRow;
+    for (kitRow = krqveciChangedRows.constBegin() ; kitRow != krqveciChangedRows.constEnd() ; ++kitRow)
     {
-        // Deleted files are automatically be removed, but this is still necessary for changing between show/hide hidden fils
-        m_qfswFSWatcher.removePath(m_pqtwNameCurrent->item(*ritRowNum, 0)->data(FileInfo).value<QFileInfo>().filePath());
-        m_pqtwNameCurrent->removeRow(*ritRowNum);
-        m_pqtwNamePreview->removeRow(*ritRowNum);
+        if (m_pflmFileModel->IsFile(*kitRow) == false)
+            continue;
+
+        if (kbReadMusic)
+            ReadFileMetaTagsMusic(*kitRow);
+        if (kbReadExif)
+            ReadFileMetaTagsExif(*kitRow);
     }
 }
 
 
-void IUIFileList::AddFiles(const QList<int> & krqlstAddIndexes, const QFileInfoList & krqfilFileList)
+bool IUIFileList::ApplyDirectoryChanges(const ISysDirChangeList & krqvecdcChanges)
 {
+    if (m_bDisplayingMyComputer || m_pdenDirEnumerator != nullptr || krqvecdcChanges.size() > m_kiMaxIncrementalChanges)
+        return false;
+
+    // New entries are inserted by name, or at the end of their section when sorting by date as they're the newest, but finding their place
+    // in the extension and type orders would mean working out the extension of every row.  Renamed rows are moved the same way, and
+    // modified rows are moved to the end of their section when sorting by date
+    const int kiSortOrder = m_ifisFileSort.GetSortOrder();
+    const bool kbCanInsert = (kiSortOrder == ISysFileInfoSort::Name || kiSortOrder == ISysFileInfoSort::Modified);
+
+    // The changes are reduced to the final state of each name, so entries created and deleted within the burst are never read and a chain
+    // of renames maps the final name to the row's original name.  Entries created within the burst have no row, so renaming them just
+    // moves them to their new name.  Whatever was at the destination of a rename or deletion is removed
+    QHash<QString, QString> qhashRenamedFrom;
+    QSet<QString> qsetRemovedNames;
+    QSet<QString> qsetUpdatedNames;
+    QSet<QString> qsetCreatedNames;
+    ISysDirChangeList::const_iterator kitChange;
+    for (kitChange = krqvecdcChanges.constBegin() ; kitChange != krqvecdcChanges.constEnd() ; ++kitChange)
+    {
+        const QString & krqstrName = kitChange->m_qstrName;
+        if (kitChange->m_iType == ISysDirChange::Created || kitChange->m_iType == ISysDirChange::Modified)
+        {
+            if (kitChange->m_iType == ISysDirChange::Created)
+            {
+                if (kbCanInsert == false)
+                    return false;
+                qsetCreatedNames.insert(krqstrName);
+            }
+            if (qhashRenamedFrom.contains(krqstrName) == false)
+                qsetUpdatedNames.insert(krqstrName);
+        }
+        else if (kitChange->m_iType == ISysDirChange::Deleted)
+        {
+            qsetUpdatedNames.remove(krqstrName);
+            qsetCreatedNames.remove(krqstrName);
+            qsetRemovedNames.insert(qhashRenamedFrom.contains(krqstrName) ? qhashRenamedFrom.take(krqstrName) : krqstrName);
+        }
+        else if (kitChange->m_iType == ISysDirChange::Renamed)
+        {
+            const QString & krqstrNewName = kitChange->m_qstrNewName;
+            qsetRemovedNames.insert(qhashRenamedFrom.contains(krqstrNewName) ? qhashRenamedFrom.take(krqstrNewName) : krqstrNewName);
+            qsetUpdatedNames.remove(krqstrNewName);
+            qsetUpdatedNames.remove(krqstrName);
+            qsetCreatedNames.remove(krqstrNewName);
+
+            if (qsetCreatedNames.remove(krqstrName))
+            {
+                qsetCreatedNames.insert(krqstrNewName);
+                qsetUpdatedNames.insert(krqstrNewName);
+            }
+            else
+            {
+                qhashRenamedFrom.insert(krqstrNewName, qhashRenamedFrom.contains(krqstrName) ? qhashRenamedFrom.take(krqstrName) : krqstrName);
+            }
+        }
+    }
+
+    if (kbCanInsert == false && qhashRenamedFrom.isEmpty() == false)
+        return false;
+
     #ifdef QT_DEBUG
-    qDebug() << "-=Files To Add=-";
-    for (int iIndex = 0 ; iIndex < krqlstAddIndexes.size() ; ++iIndex)
-        qDebug() << krqfilFileList.at(krqlstAddIndexes.at(iIndex)).fileName();
+    qDebug() << "Applying Directory Changes:" << qhashRenamedFrom.size() << "Renamed," << qsetRemovedNames.size() << "Removed," << qsetUpdatedNames.size() << "Added Or Modified";
     #endif
 
-    int iNextToAddIndex = 0;
-    const int kiNumFilesToAdd = krqlstAddIndexes.size();
-    while (iNextToAddIndex < kiNumFilesToAdd)
+    // Rows are looked up by the names they had before any of the changes were applied.  Rows that have been renamed away from a name are
+    // excluded when looking up that name
+    QHash<QString, int> qhashRowByName;
+    const int kiNumRows = m_pflmFileModel->RowCount();
+    qhashRowByName.reserve(kiNumRows);
+    for (int iRow = 0 ; iRow < kiNumRows ; ++iRow)
+        qhashRowByName.insert(m_pflmFileModel->GetNameCurrent(iRow), iRow);
+
+    QSet<QString> qsetRenameSources;
+    QHash<QString, QString>::const_iterator kitRename;
+    for (kitRename = qhashRenamedFrom.constBegin() ; kitRename != qhashRenamedFrom.constEnd() ; ++kitRename)
+        qsetRenameSources.insert(kitRename.value());
+
+    int iAttributes = m_ifisFileSort.GetRequiredAttributes();
+    if (m_bMetaTagsReadMusic || m_bMetaTagsReadExif || ReadingMetaTags())
+        iAttributes |= ISysDirEnumerator::AttribModified;
+    ISysDirEnumerator idenEntryReader(m_qdirDirReader.path(), QDir::Dirs | QDir::Files | m_qdirfHiddenFileFilter, iAttributes);
+    ISysDirEntry deEntry;
+
+    QSet<int> qsetRemoveRows;
+    QVector<int> qveciChangedRows;
+    QVector<int> qveciMoveRows;
+    ISysDirEntryList qvecdeNewEntries;
+    m_bSyncSelection = false;
+
+    // Renamed rows are updated in place.  A rename over an existing file replaces that file's row, unless it was also renamed away
+    for (kitRename = qhashRenamedFrom.constBegin() ; kitRename != qhashRenamedFrom.constEnd() ; ++kitRename)
+    {
+        const QString & krqstrNewName = kitRename.key();
+        const int kiRow = qhashRowByName.value(kitRename.value(), -1);
+        const bool kbEntryRead = idenEntryReader.ReadEntry(krqstrNewName, deEntry);
+        if (kiRow == -1)
+        {
+            if (kbEntryRead)
+                qsetUpdatedNames.insert(krqstrNewName);
+        }
+        else if (kbEntryRead)
+        {
+            const int kiOverwrittenRow = qhashRowByName.value(krqstrNewName, -1);
+            if (kiOverwrittenRow != -1 && qsetRenameSources.contains(krqstrNewName) == false)
+                qsetRemoveRows.insert(kiOverwrittenRow);
+
+            m_pflmFileModel->SetEntry(kiRow, deEntry);
+            qveciChangedRows.append(kiRow);
+            if (kiSortOrder == ISysFileInfoSort::Name)
+                qveciMoveRows.append(kiRow);
+        }
+        else
+        {
+            qsetRemoveRows.insert(kiRow);
+        }
+    }
+
+    QSet<QString>::const_iterator kitName;
+    for (kitName = qsetRemovedNames.constBegin() ; kitName != qsetRemovedNames.constEnd() ; ++kitName)
+    {
+        if (qsetRenameSources.contains(*kitName) || qsetUpdatedNames.contains(*kitName))
+            continue;
+
+        const int kiRow = qhashRowByName.value(*kitName, -1);
+        if (kiRow != -1)
+            qsetRemoveRows.insert(kiRow);
+    }
+
+    for (kitName = qsetUpdatedNames.constBegin() ; kitName != qsetUpdatedNames.constEnd() ; ++kitName)
     {
-       AddFile(krqfilFileList.at(krqlstAddIndexes.at(iNextToAddIndex)), krqlstAddIndexes.at(iNextToAddIndex));
-       ++iNextToAddIndex;
+        const int kiRow = qsetRenameSources.contains(*kitName) ? -1 : qhashRowByName.value(*kitName, -1);
+        if (idenEntryReader.ReadEntry(*kitName, deEntry))
+        {
+            if (kiRow == -1)
+            {
+                qvecdeNewEntries.append(deEntry);
+            }
+            else
+            {
+                m_pflmFileModel->SetEntry(kiRow, deEntry);
+                qveciChangedRows.append(kiRow);
+                qsetRemoveRows.remove(kiRow);
+                if (kiSortOrder == ISysFileInfoSort::Modified)
+                    qveciMoveRows.append(kiRow);
+            }
+        }
+        else if (kiRow != -1)
+        {
+            qsetRemoveRows.insert(kiRow);
+        }
     }
+
+    // Meta data is read before rows are removed or inserted, while the changed row numbers are still valid
+    QVector<int> qveciReReadRows;
+    QVector<int>::const_iterator kitRow;
+    for (kitRow = qveciChangedRows.constBegin() ; kitRow != qveciChangedRows.constEnd() ; ++kitRow)
+    {
+        if (qsetRemoveRows.contains(*kitRow) == false)
+            qveciReReadRows.append(*kitRow);
+    }
+    ReReadChangedRows(qveciReReadRows);
+
+    QVector<int> qveciRemoveRows = qsetRemoveRows.values().toVector();
+    std::sort(qveciRemoveRows.begin(), qveciRemoveRows.end());
+    if (qveciRemoveRows.isEmpty() == false)
+        m_pflmFileModel->RemoveRows(qveciRemoveRows);
+
+    // Rows are moved once the removed rows are gone, so each row number is reduced by the number of rows removed above it, and before
+    // new entries are inserted, as finding their place relies on the other rows being in order
+    if (qveciMoveRows.isEmpty() == false)
+    {
+        QVector<int> qveciMovedRows;
+        for (kitRow = qveciMoveRows.constBegin() ; kitRow != qveciMoveRows.constEnd() ; ++kitRow)
+        {
+            if (qsetRemoveRows.contains(*kitRow) == false)
+                qveciMovedRows.append(*kitRow - (std::lower_bound(qveciRemoveRows.constBegin(), qveciRemoveRows.constEnd(), *kitRow) - qveciRemoveRows.constBegin()));
+        }
+        MoveRowsToSortedPositions(qveciMovedRows);
+    }
+
+    // New entries are inserted in order, so each is inserted after the ones before it and their rows remain valid
+    if (qvecdeNewEntries.isEmpty() == false)
+    {
+        m_ifisFileSort.SortEntryList(qvecdeNewEntries);
+
+        int iNumFolders = GetNumFolders();
+        QVector<int> qveciNewRows;
+        ISysDirEntryList::const_iterator kitEntry;
+        for (kitEntry = qvecdeNewEntries.constBegin() ; kitEntry != qvecdeNewEntries.constEnd() ; ++kitEntry)
+        {
+            const int kiRow = GetInsertionRow(kitEntry->m_qstrName, kitEntry->m_bIsDir, iNumFolders);
+            m_pflmFileModel->InsertEntry(kiRow, *kitEntry);
+            qveciNewRows.append(kiRow);
+            if (kitEntry->m_bIsDir)
+                ++iNumFolders;
+        }
+        ReReadChangedRows(qveciNewRows);
+    }
+
+    m_bSyncSelection = true;
+
+    if (qveciChangedRows.isEmpty() == false || qsetRemoveRows.isEmpty() == false || qvecdeNewEntries.isEmpty() == false)
+        GeneratePreview(IUIRename::NoTab);
+
+    return true;
 }
 
 
-void IUIFileList::AddFile(const QFileInfo & krqfiNewFile, const int kiRow)
+int IUIFileList::GetInsertionRow(const QString & krqstrName, const bool kbIsDir, const int kiNumFolders, const QVector<int>* kpqveciRowOrder)
 {
-    QTableWidgetItem* pqtwiCurrentItem = new QTableWidgetItem;
-    pqtwiCurrentItem->setText(krqfiNewFile.fileName());
-    pqtwiCurrentItem->setIcon(m_qfipIconProvider.icon(krqfiNewFile));
-    m_pqtwNameCurrent->insertRow(kiRow);
-    m_pqtwNameCurrent->setItem(kiRow, 0, pqtwiCurrentItem);
+    int iFirst = kbIsDir ? 0 : kiNumFolders;
+    int iLast = kbIsDir ? kiNumFolders : (kpqveciRowOrder == nullptr ? m_pflmFileModel->RowCount() : kpqveciRowOrder->size());
+
+    if (m_ifisFileSort.GetSortOrder() == ISysFileInfoSort::Modified)
+        return iLast;
+
+    while (iFirst < iLast)
+    {
+        const int kiMiddle = iFirst + (iLast-iFirst) / 2;
+        const int kiMiddleRow = (kpqveciRowOrder == nullptr ? kiMiddle : kpqveciRowOrder->at(kiMiddle));
+        if (m_ifisFileSort.ComesAfter(krqstrName, m_pflmFileModel->GetNameCurrent(kiMiddleRow)))
+            iFirst = kiMiddle + 1;
+        else
+            iLast = kiMiddle;
+    }
+    return iFirst;
+}
+
+
+void IUIFileList::MoveRowsToSortedPositions(const QVector<int> & krqveciRows)
+{
+    const int kiNumRows = m_pflmFileModel->RowCount();
+    QVector<bool> qvecbMoving(kiNumRows, false);
+    QList<ITableRow*> qlstRowList;
+    QVector<int>::const_iterator kitRow;
+    for (kitRow = krqveciRows.constBegin() ; kitRow != krqveciRows.constEnd() ; ++kitRow)
+    {
+        if (qvecbMoving.at(*kitRow))
+            continue;
+        qvecbMoving[*kitRow] = true;
+        qlstRowList.append(new ITableRow(*kitRow, m_pflmFileModel->GetNameCurrent(*kitRow), m_pflmFileModel->GetFileInfo(*kitRow)));
+    }
+
+    // The rows that aren't moving are still in order, so the moving rows are placed among them in sorted order, which keeps the
+    // rows placed at the end of a section in date order when sorting by date
+    QVector<int> qveciNewOrder;
+    qveciNewOrder.reserve(kiNumRows);
+    int iNumFolders = 0;
+    for (int iRow = 0 ; iRow < kiNumRows ; ++iRow)
+    {
+        if (qvecbMoving.at(iRow) == false)
+        {
+            qveciNewOrder.append(iRow);
+            if (m_pflmFileModel->IsDir(iRow))
+                ++iNumFolders;
+        }
+    }
 
-    QTableWidgetItem* pqtwiPreviewItem = new QTableWidgetItem;
-    pqtwiPreviewItem->setIcon(m_qfipIconProvider.icon(krqfiNewFile));
-    m_pqtwNamePreview->insertRow(kiRow);
-    m_pqtwNamePreview->setItem(kiRow, 0, pqtwiPreviewItem);
+    m_ifisFileSort.ResortRows(qlstRowList, m_ifisFileSort.GetSortOrder());
 
-    pqtwiCurrentItem->setData(FileInfo, QVariant::fromValue(krqfiNewFile));
-    if (krqfiNewFile.isFile())
-        m_qfswFSWatcher.addPath(krqfiNewFile.filePath());
+    QList<ITableRow*>::const_iterator kitTableRow;
+    for (kitTableRow = qlstRowList.constBegin() ; kitTableRow != qlstRowList.constEnd() ; ++kitTableRow)
+    {
+        const int kiRow = (*kitTableRow)->m_iRow;
+        const bool kbIsDir = m_pflmFileModel->IsDir(kiRow);
+        qveciNewOrder.insert(GetInsertionRow((*kitTableRow)->m_qstrName, kbIsDir, iNumFolders, &qveciNewOrder), kiRow);
+        if (kbIsDir)
+            ++iNumFolders;
+        delete *kitTableRow;
+    }
 
-    if (m_bMetaTagsReadMusic)
-        ReadFileMetaTagsMusic(pqtwiCurrentItem);
-    if (m_bMetaTagsReadExif)
-        ReadFileMetaTagsExif(pqtwiCurrentItem);
+    m_pflmFileModel->ReorderRows(0, qveciNewOrder);
 }
 
 
 void IUIFileList::FlagItemsForRenaming()
 {
     int iRow = 0;
-    int iNumRows = m_pqtwNameCurrent->rowCount();
+    int iNumRows = m_pflmFileModel->RowCount();
     int iRenameElements = m_rpuirRenameUI->GetRenameUIFilter()->RenameElements();
 
     if (iRenameElements == IUIRenameFilter::RenameFilesOnly)
     {
         for (iRow = 0 ; iRow < iNumRows ; ++iRow)
-            m_pqtwNameCurrent->item(iRow, 0)->setData(FlaggedForRenme, m_pqtwNameCurrent->item(iRow, 0)->data(FileInfo).value<QFileInfo>().isFile());
+            m_pflmFileModel->SetFlaggedForRename(iRow, m_pflmFileModel->IsFile(iRow));
     }
     else if (iRenameElements == IUIRenameFilter::RenameFoldersOnly)
     {
         for (iRow = 0 ; iRow < iNumRows ; ++iRow)
-            m_pqtwNameCurrent->item(iRow, 0)->setData(FlaggedForRenme, m_pqtwNameCurrent->item(iRow, 0)->data(FileInfo).value<QFileInfo>().isDir());
+            m_pflmFileModel->SetFlaggedForRename(iRow, m_pflmFileModel->IsDir(iRow));
     }
     else if (iRenameElements == IUIRenameFilter::RenameFilesAndFolders)
     {
         for (iRow = 0 ; iRow < iNumRows ; ++iRow)
-            m_pqtwNameCurrent->item(iRow, 0)->setData(FlaggedForRenme, true);
+            m_pflmFileModel->SetFlaggedForRename(iRow, true);
     }
     else if (iRenameElements == IUIRenameFilter::RenameSelectedItems)
     {
@@ -673,7 +934,7 @@ void IUIFileList::FlagItemsForRenaming()
     m_iNumFilesToRename = 0;
     for (iRow = 0 ; iRow < iNumRows ; ++iRow)
     {
-        if (m_pqtwNameCurrent->item(iRow, 0)->data(FlaggedForRenme).toBool())
+        if (m_pflmFileModel->FlaggedForRename(iRow))
             ++m_iNumFilesToRename;
     }
 }
@@ -682,21 +943,21 @@ void IUIFileList::FlagItemsForRenaming()
 void IUIFileList::FlagSelectedItemsForRenaming()
 {
     int iRow;
-    const int kiNumRows = m_pqtwNameCurrent->rowCount();
+    const int kiNumRows = m_pflmFileModel->RowCount();
     for (iRow = 0 ; iRow < kiNumRows ; ++iRow)
-        m_pqtwNameCurrent->item(iRow, 0)->setData(FlaggedForRenme, false);
+        m_pflmFileModel->SetFlaggedForRename(iRow, false);
 
     int iRowBottom;
     m_iNumFilesToRename = 0;
-    QList<QTableWidgetSelectionRange> qlqtwsrSelections = m_pqtwNameCurrent->selectedRanges();
-    QList<QTableWidgetSelectionRange>::const_iterator kitSelection;
-    for (kitSelection = qlqtwsrSelections.constBegin() ; kitSelection != qlqtwsrSelections.constEnd() ; ++kitSelection)
+    const QItemSelection kqisSelections = m_pqtvNameCurrent->selectionModel()->selection();
+    QItemSelection::const_iterator kitSelection;
+    for (kitSelection = kqisSelections.constBegin() ; kitSelection != kqisSelections.constEnd() ; ++kitSelection)
     {
-        iRowBottom = kitSelection->bottomRow();
-        for (iRow = kitSelection->topRow() ; iRow <= iRowBottom ; ++iRow)
+        iRowBottom = kitSelection->bottom();
+        for (iRow = kitSelection->top() ; iRow <= iRowBottom ; ++iRow)
         {
             ++m_iNumFilesToRename;
-            m_pqtwNameCurrent->item(iRow, 0)->setData(FlaggedForRenme, true);
+            m_pflmFileModel->SetFlaggedForRename(iRow, true);
         }
     }
 }
@@ -705,30 +966,27 @@ void IUIFileList::FlagSelectedItemsForRenaming()
 void IUIFileList::FlagItemsForRenamingByExtension()
 {
     int iRow;
-    const int kiNumRows = m_pqtwNameCurrent->rowCount();
+    const int kiNumRows = m_pflmFileModel->RowCount();
     for (iRow = 0 ; iRow < kiNumRows ; ++iRow)
-        m_pqtwNameCurrent->item(iRow, 0)->setData(FlaggedForRenme, false);
+        m_pflmFileModel->SetFlaggedForRename(iRow, false);
 
-    QString qstrExtension;
-    QStringList krqstrlExtensionList = m_rpuirRenameUI->GetRenameUIFilter()->GetRenameExtensions();
-    QStringList::const_iterator kitExtension;
-    for (iRow = 0 ; iRow < kiNumRows ; ++iRow)
+    // Extensions are interned when rows are added, so each distinct extension is checked against the filter once and each row is then
+    // flagged by testing the bit for its extension ID
+    const QSet<QString> kqsetExtensions = m_rpuirRenameUI->GetRenameUIFilter()->GetRenameExtensions().toSet();
+    const bool kbCaseSensitive = m_rpuirRenameUI->CaseSensitive();
+    const int kiNumExtensionIDs = m_pflmFileModel->NumExtensionIDs();
+    QBitArray qbtaExtensionMatch(kiNumExtensionIDs);
+    for (int iExtensionID = 0 ; iExtensionID < kiNumExtensionIDs ; ++iExtensionID)
     {
-        if (m_pqtwNameCurrent->item(iRow, 0)->data(FileInfo).value<QFileInfo>().isFile())
-        {
-            qstrExtension = m_pqtwNameCurrent->item(iRow, 0)->text().mid(m_pqtwNameCurrent->item(iRow, 0)->text().lastIndexOf('.')+1);
-            if (m_rpuirRenameUI->CaseSensitive() == false)
-                qstrExtension = qstrExtension.toLower();
+        const QString & krqstrExtension = m_pflmFileModel->GetExtension(iExtensionID);
+        if (kqsetExtensions.contains(kbCaseSensitive ? krqstrExtension : krqstrExtension.toLower()))
+            qbtaExtensionMatch.setBit(iExtensionID);
+    }
 
-            for (kitExtension = krqstrlExtensionList.constBegin() ; kitExtension != krqstrlExtensionList.constEnd() ; ++kitExtension)
-            {
-                if (qstrExtension == *kitExtension)
-                {
-                    m_pqtwNameCurrent->item(iRow, 0)->setData(FlaggedForRenme, true);
-                    break;
-                }
-            }
-        }
+    for (iRow = 0 ; iRow < kiNumRows ; ++iRow)
+    {
+        if (m_pflmFileModel->IsFile(iRow) && qbtaExtensionMatch.testBit(m_pflmFileModel->GetExtensionID(iRow)))
+            m_pflmFileModel->SetFlaggedForRename(iRow, true);
     }
 }
 
@@ -739,161 +997,358 @@ void IUIFileList::UnflagItemsForRenamingIfNoMeta()
     bool bExifMetaReq = false;
     m_rpuirRenameUI->CheckForMetaTags(bMusicMetaReq, bExifMetaReq);
 
-    bMusicMetaReq = bMusicMetaReq && m_bMetaTagsReadMusic;
-    bExifMetaReq  = bExifMetaReq  && m_bMetaTagsReadExif;
+    bMusicMetaReq = bMusicMetaReq && (m_bMetaTagsReadMusic || ReadingMetaTags(ISysMetaReader::Music));
+    bExifMetaReq  = bExifMetaReq  && (m_bMetaTagsReadExif  || ReadingMetaTags(ISysMetaReader::Exif));
 
     if (bMusicMetaReq == false && bExifMetaReq == false)
         return;
 
-    const int kiNumRows = m_pqtwNameCurrent->rowCount();
+    // Rows whose tags haven't been read yet stay flagged, which keeps renaming disabled until they're resolved
+    const int kiNumRows = m_pflmFileModel->RowCount();
     for (int iRow = 0 ; iRow < kiNumRows ; ++iRow)
     {
-        if (bMusicMetaReq && m_pqtwNameCurrent->item(iRow, 0)->data(IUIFileList::MusicMeta).isNull())
-            m_pqtwNameCurrent->item(iRow, 0)->setData(FlaggedForRenme, false);
-        if (bExifMetaReq && m_pqtwNameCurrent->item(iRow, 0)->data(IUIFileList::ExifMeta).isNull())
-            m_pqtwNameCurrent->item(iRow, 0)->setData(FlaggedForRenme, false);
+        if (bMusicMetaReq && m_pflmFileModel->HasMusicMeta(iRow) == false && m_pflmFileModel->MetaPending(iRow, IUIFileListModel::RowMusicPending) == false)
+            m_pflmFileModel->SetFlaggedForRename(iRow, false);
+        if (bExifMetaReq && m_pflmFileModel->HasExifMeta(iRow) == false && m_pflmFileModel->MetaPending(iRow, IUIFileListModel::RowExifPending) == false)
+            m_pflmFileModel->SetFlaggedForRename(iRow, false);
     }
 }
 
 
 void IUIFileList::ReadMetaTags()
 {
+    // Tags are read for the whole list when the directory read completes
+    if (m_pdenDirEnumerator != nullptr)
+        return;
+
     bool bMusicTags = false;
     bool bExifTags = false;
     m_rpuirRenameUI->CheckForMetaTags(bMusicTags, bExifTags);
 
-    if (m_bMetaTagsReadMusic == false && bMusicTags == true)
+    if (bMusicTags == true)
         ReadMetaTagsMusic();
 
-    if (m_bMetaTagsReadExif == false && bExifTags == true)
+    if (bExifTags == true)
         ReadMetaTagsExif();
 }
 
 
 void IUIFileList::ReadMetaTagsMusic(const bool kbForceReRead)
 {
-    if (m_bMetaTagsReadMusic == true && kbForceReRead == false)
+    QBitArray qbtaMusicTags, qbtaExifTags;
+    m_rpuirRenameUI->GetRequiredMetaTags(qbtaMusicTags, qbtaExifTags);
+    const QBitArray & krqbtaRequiredTags = qbtaMusicTags;
+
+    // Tags already read (or being read) don't need to be read again as long as every tag that's now used is among them
+    QBitArray & rqbtaTagsRead = m_rgqbtaTagsRead[ISysMetaReader::Music];
+    if ((m_bMetaTagsReadMusic == true || ReadingMetaTags(ISysMetaReader::Music)) && kbForceReRead == false && (rqbtaTagsRead & krqbtaRequiredTags) == krqbtaRequiredTags)
         return;
 
     #ifdef QT_DEBUG
     qDebug() << "Reading Music Meta For:" << QDir::toNativeSeparators(m_qdirDirReader.path());
     #endif
 
-    int iRow = 0;
-    const int kiNumRows = m_pqtwNameCurrent->rowCount();
+    CancelMetaTagsRead(ISysMetaReader::Music);
+    m_bMetaTagsReadMusic = false;
+    m_pflmFileModel->ClearMusicMeta();
+    rqbtaTagsRead = krqbtaRequiredTags;
 
-    while (iRow < kiNumRows && m_pqtwNameCurrent->item(iRow, 0)->data(FileInfo).value<QFileInfo>().isDir())
-        ++iRow;  
-    const int kiStartRow = iRow;
+    StartMetaTagsRead(ISysMetaReader::Music);
+}
+
+
+void IUIFileList::ReadFileMetaTagsMusic(const int kiRow)
+{
+    RecordModifiedTime(kiRow);
+
+    const QBitArray & krqbtaRequiredTags = m_rgqbtaTagsRead[ISysMetaReader::Music];
+    IComMetaMusic mmuMusicMeta(QDir::toNativeSeparators(m_pflmFileModel->GetFileInfo(kiRow).absoluteFilePath()), IMetaMusic::GetReadStyle(krqbtaRequiredTags));
+    if (mmuMusicMeta.TagDataPresent())
+        m_pflmFileModel->SetMusicMeta(kiRow, IMetaMusic(&mmuMusicMeta, m_icsInvalidCharSub, krqbtaRequiredTags));
+}
 
-    IComDlgProgress idprgRenameProgress(m_pmwMainWindow, tr("Reading Music Tags"), "Reading file: ", kiNumRows-iRow, false, true, 1000);
 
-    QTableWidgetItem* pqtwiFileItem;
-    const QString kqstrCurrentPath = m_qdirDirReader.path();
-    while (iRow < kiNumRows)
+void IUIFileList::ReadMetaTagsExif(const bool kbForceReRead)
+{
+    QBitArray qbtaMusicTags, qbtaExifTags;
+    m_rpuirRenameUI->GetRequiredMetaTags(qbtaMusicTags, qbtaExifTags);
+    const QBitArray & krqbtaRequiredTags = qbtaExifTags;
+
+    // Tags already read (or being read) don't need to be read again as long as every tag that's now used is among them
+    QBitArray & rqbtaTagsRead = m_rgqbtaTagsRead[ISysMetaReader::Exif];
+    if ((m_bMetaTagsReadExif == true || ReadingMetaTags(ISysMetaReader::Exif)) && kbForceReRead == false && (rqbtaTagsRead & krqbtaRequiredTags) == krqbtaRequiredTags)
+        return;
+
+    #ifdef QT_DEBUG
+    qDebug() << "Reading Exif For:" << QDir::toNativeSeparators(m_qdirDirReader.path());
+    #endif
+
+    CancelMetaTagsRead(ISysMetaReader::Exif);
+    m_bMetaTagsReadExif = false;
+    m_pflmFileModel->ClearExifMeta();
+    rqbtaTagsRead = krqbtaRequiredTags;
+
+    StartMetaTagsRead(ISysMetaReader::Exif);
+}
+
+
+void IUIFileList::ReadFileMetaTagsExif(const int kiRow)
+{
+    const QFileInfo & krqfiFileInfo = m_pflmFileModel->GetFileInfo(kiRow);
+
+    if (IComMetaExif::FileCanContainExif(krqfiFileInfo.suffix()) == false)
+        return;
+
+    RecordModifiedTime(kiRow);
+
+    IComMetaExif mexExifMeta(QDir::toNativeSeparators(krqfiFileInfo.absoluteFilePath()));
+    if (mexExifMeta.ExifDataPresent())
+        m_pflmFileModel->SetExifMeta(kiRow, IMetaExif(&mexExifMeta, m_icsInvalidCharSub, m_bExifAdvancedMode, m_rgqbtaTagsRead[ISysMetaReader::Exif]));
+}
+
+
+void IUIFileList::StartMetaTagsRead(const int kiMetaType)
+{
+    ISysMetaReadList qvecmriItems;
+    const int kiNumRows = m_pflmFileModel->RowCount();
+    qvecmriItems.reserve(kiNumRows);
+    for (int iRow = 0 ; iRow < kiNumRows ; ++iRow)
     {
-        pqtwiFileItem = m_pqtwNameCurrent->item(iRow, 0);
-        idprgRenameProgress.UpdateMessage(tr("Reading file: %1").arg(pqtwiFileItem->text()));
-        idprgRenameProgress.UpdateProgress(iRow-kiStartRow+1);
+        if (m_pflmFileModel->IsDir(iRow))
+            continue;
 
-        ReadFileMetaTagsMusic(pqtwiFileItem);
+        const QFileInfo & krqfiFileInfo = m_pflmFileModel->GetFileInfo(iRow);
+        if (kiMetaType == ISysMetaReader::Exif && IComMetaExif::FileCanContainExif(krqfiFileInfo.suffix()) == false)
+            continue;
 
-        if (idprgRenameProgress.Aborted())
-        {
-            m_rpuirRenameUI->ClearAll();
-            RefreshDirectoryHard();
-            return;
-        }
+        ISysMetaReadItem mriItem;
+        mriItem.m_iRow = iRow;
+        mriItem.m_qstrName = m_pflmFileModel->GetNameCurrent(iRow);
+        mriItem.m_qstrPath = QDir::toNativeSeparators(krqfiFileInfo.absoluteFilePath());
+        mriItem.m_ui64Inode = m_pflmFileModel->GetInode(iRow);
+        mriItem.m_ui64Device = m_pflmFileModel->GetDevice(iRow);
+        qvecmriItems.append(mriItem);
+        m_pflmFileModel->SetMetaPending(iRow, GetMetaPendingFlag(kiMetaType), true);
+    }
 
-        ++iRow;
+    // The progress window isn't modal so the list can be used while the tags are read, and its progress is updated as batches arrive
+    const QString kqstrTitle = (kiMetaType == ISysMetaReader::Music ? tr("Reading Music Tags") : tr("Reading Exif Data"));
+    m_rgiMetaFilesRead[kiMetaType] = 0;
+    m_rgpdprgMetaProgress[kiMetaType] = new IComDlgProgress(m_pmwMainWindow, kqstrTitle, "Reading file: ", qvecmriItems.size(), false, true, 1000);
+    m_rgpdprgMetaProgress[kiMetaType]->setModal(false);
+    connect(m_rgpdprgMetaProgress[kiMetaType], SIGNAL(AbortRequested()), this, SLOT(AbortMetaTagsRead()));
+
+    m_rgpmrdMetaReader[kiMetaType] = new ISysMetaReader(kiMetaType, qvecmriItems, m_icsInvalidCharSub, m_bExifAdvancedMode, m_rgqbtaTagsRead[kiMetaType],
+                                                        m_rgqspmchMetaCache[kiMetaType], ++m_rgiMetaReadID[kiMetaType]);
+    connect(m_rgpmrdMetaReader[kiMetaType], SIGNAL(TagsRead(const int, const int, const ISysMetaReadList &)),  this, SLOT(AddMetaTags(const int, const int, const ISysMetaReadList &)));
+    connect(m_rgpmrdMetaReader[kiMetaType], SIGNAL(ReadComplete(const int, const int)),                        this, SLOT(MetaTagsReadComplete(const int, const int)));
+
+    int iFirstRow, iLastRow;
+    GetVisibleRows(iFirstRow, iLastRow);
+    m_rgpmrdMetaReader[kiMetaType]->PrioritiseRows(iFirstRow, iLastRow);
+    StartWorkerThread(m_rgpmrdMetaReader[kiMetaType]);
+
+    // Nothing can be renamed until the tags of every flagged row have been read
+    m_rpuirRenameUI->EnableRenameButton(false);
+}
+
+
+void IUIFileList::CancelMetaTagsRead(const int kiMetaType)
+{
+    if (m_rgpdprgMetaProgress[kiMetaType] != nullptr)
+    {
+        // The window may be the sender of the signal that led here, so it's deleted once control returns to the event loop
+        m_rgpdprgMetaProgress[kiMetaType]->deleteLater();
+        m_rgpdprgMetaProgress[kiMetaType] = nullptr;
     }
 
-    m_bMetaTagsReadMusic = true;
+    if (m_rgpmrdMetaReader[kiMetaType] == nullptr)
+        return;
+
+    m_pflmFileModel->ClearMetaPending(GetMetaPendingFlag(kiMetaType));
+    m_pflmFileModel->PreviewNamesChanged();
+
+    #ifdef QT_DEBUG
+    qDebug() << "Cancelling Meta Tag Read:" << kiMetaType << m_rgiMetaReadID[kiMetaType];
+    #endif
+
+    // Batches that have already been queued will still be delivered, but they're ignored as the read ID no longer matches
+    m_rgpmrdMetaReader[kiMetaType]->requestInterruption();
+    m_rgpmrdMetaReader[kiMetaType] = nullptr;
 }
 
 
-void IUIFileList::ReadFileMetaTagsMusic(QTableWidgetItem* pqtwiFileItem)
+void IUIFileList::AddMetaTags(const int kiMetaType, const int kiReadID, const ISysMetaReadList & krqvecmriItems)
 {
-    IComMetaMusic mmuMusicMeta(QDir::toNativeSeparators(pqtwiFileItem->data(FileInfo).value<QFileInfo>().absoluteFilePath()));
-    if (mmuMusicMeta.TagDataPresent())
-        pqtwiFileItem->setData(MusicMeta, QVariant::fromValue(IMetaMusic(&mmuMusicMeta, m_icsInvalidCharSub)));
+    if (kiReadID != m_rgiMetaReadID[kiMetaType] || m_rgpmrdMetaReader[kiMetaType] == nullptr)
+        return;
+
+    QHash<QString, int> qhashRowByName;
+    ISysMetaReadList::const_iterator kitItem;
+    for (kitItem = krqvecmriItems.constBegin() ; kitItem != krqvecmriItems.constEnd() ; ++kitItem)
+    {
+        const int kiRow = FindMetaReadRow(*kitItem, qhashRowByName);
+        if (kiRow == -1)
+            continue;
+        m_pflmFileModel->SetMetaPending(kiRow, GetMetaPendingFlag(kiMetaType), false);
+
+        // If the file has been modified since it was read it will have been re-read when the change was picked up
+        if (m_pflmFileModel->GetModified(kiRow) > kitItem->m_i64ModifiedMS)
+            continue;
+
+        if (m_pflmFileModel->GetModified(kiRow) == -1)
+            m_pflmFileModel->SetModified(kiRow, kitItem->m_i64ModifiedMS);
+        if (kitItem->m_bTagsPresent == false)
+            continue;
+
+        if (kiMetaType == ISysMetaReader::Music)
+            m_pflmFileModel->SetMusicMeta(kiRow, kitItem->m_mmuMusicMeta);
+        else
+            m_pflmFileModel->SetExifMeta(kiRow, kitItem->m_mexExifMeta);
+    }
+
+    m_rgiMetaFilesRead[kiMetaType] += krqvecmriItems.size();
+    m_rgpdprgMetaProgress[kiMetaType]->UpdateMessage(tr("Reading file: %1").arg(krqvecmriItems.last().m_qstrName));
+    m_rgpdprgMetaProgress[kiMetaType]->SetProgress(m_rgiMetaFilesRead[kiMetaType]);
+
+    // Setting a row's tags clears its cached stage outputs, so only the rows in this batch are regenerated
+    GeneratePreview(IUIRename::NoTab);
 }
 
 
-void IUIFileList::ReadMetaTagsExif(const bool kbForceReRead)
+void IUIFileList::MetaTagsReadComplete(const int kiMetaType, const int kiReadID)
 {
-    if (m_bMetaTagsReadExif == true && kbForceReRead == false)
+    if (kiReadID != m_rgiMetaReadID[kiMetaType] || m_rgpmrdMetaReader[kiMetaType] == nullptr)
         return;
 
     #ifdef QT_DEBUG
-    qDebug() << "Reading Exif For:" << QDir::toNativeSeparators(m_qdirDirReader.path());
+    qDebug() << "Meta Tag Read Complete:" << kiMetaType << m_rgiMetaFilesRead[kiMetaType] << "Files";
     #endif
 
-    int iRow = 0;
-    const int kiNumRows = m_pqtwNameCurrent->rowCount();
+    // Rows that moved out of the list's reach, such as ones renamed by another application, can be left pending
+    m_pflmFileModel->ClearMetaPending(GetMetaPendingFlag(kiMetaType));
+    m_rgpmrdMetaReader[kiMetaType] = nullptr;
+    delete m_rgpdprgMetaProgress[kiMetaType];
+    m_rgpdprgMetaProgress[kiMetaType] = nullptr;
+    if (kiMetaType == ISysMetaReader::Music)
+        m_bMetaTagsReadMusic = true;
+    else
+        m_bMetaTagsReadExif = true;
 
-    while (iRow < kiNumRows && m_pqtwNameCurrent->item(iRow, 0)->data(FileInfo).value<QFileInfo>().isDir())
-        ++iRow;
-    const int kiStartRow = iRow;
+    // Files without tags are unflagged now that every file has been read, which also re-enables renaming
+    GeneratePreview(IUIRename::NoTab);
+}
 
-    IComDlgProgress idprgRenameProgress(m_pmwMainWindow, tr("Reading Exif Data"), "Reading file: ", kiNumRows-iRow, false, true, 1000);
 
-    QTableWidgetItem* pqtwiFileItem;
-    const QString kqstrCurrentPath = m_qdirDirReader.path();
-    while (iRow < kiNumRows)
+void IUIFileList::AbortMetaTagsRead()
+{
+    CancelMetaTagsRead(ISysMetaReader::Music);
+    CancelMetaTagsRead(ISysMetaReader::Exif);
+    m_rpuirRenameUI->ClearAll();
+    RefreshDirectoryHard();
+}
+
+
+void IUIFileList::PrioritiseVisibleRows()
+{
+    if (ReadingMetaTags() == false)
+        return;
+
+    int iFirstRow, iLastRow;
+    GetVisibleRows(iFirstRow, iLastRow);
+    for (int iType = 0 ; iType < ISysMetaReader::NumMetaTypes ; ++iType)
     {
-        pqtwiFileItem = m_pqtwNameCurrent->item(iRow, 0);
-        idprgRenameProgress.UpdateMessage(tr("Reading file: %1").arg(pqtwiFileItem->text()));
-        idprgRenameProgress.UpdateProgress(iRow-kiStartRow+1);
+        if (m_rgpmrdMetaReader[iType] != nullptr)
+            m_rgpmrdMetaReader[iType]->PrioritiseRows(iFirstRow, iLastRow);
+    }
+}
 
-        ReadFileMetaTagsExif(pqtwiFileItem);
 
-        if (idprgRenameProgress.Aborted())
-        {
-            m_rpuirRenameUI->ClearAll();
-            RefreshDirectoryHard();
-            return;
-        }
+quint8 IUIFileList::GetMetaPendingFlag(const int kiMetaType)
+{
+    return (kiMetaType == ISysMetaReader::Music ? IUIFileListModel::RowMusicPending : IUIFileListModel::RowExifPending);
+}
+
+
+bool IUIFileList::FlaggedRowsPending() const
+{
+    if (ReadingMetaTags() == false)
+        return false;
 
-        ++iRow;
+    const int kiNumRows = m_pflmFileModel->RowCount();
+    for (int iRow = 0 ; iRow < kiNumRows ; ++iRow)
+    {
+        if (m_pflmFileModel->FlaggedForRename(iRow) && m_pflmFileModel->MetaPending(iRow))
+            return true;
     }
+    return false;
+}
 
-    m_bMetaTagsReadExif = true;
+
+void IUIFileList::GetVisibleRows(int & riFirstRow, int & riLastRow) const
+{
+    // rowAt() returns -1 below the last row, in which case the list ends within the viewport
+    riFirstRow = qMax(m_pqtvNameCurrent->rowAt(0), 0);
+    riLastRow = m_pqtvNameCurrent->rowAt(m_pqtvNameCurrent->viewport()->height() - 1);
+    if (riLastRow == -1)
+        riLastRow = m_pflmFileModel->RowCount() - 1;
 }
 
 
-void IUIFileList::ReadFileMetaTagsExif(QTableWidgetItem* pqtwiFileItem)
+void IUIFileList::StartWorkerThread(QThread* pqthrThread)
 {
-    QFileInfo qfiFileInfo = pqtwiFileItem->data(FileInfo).value<QFileInfo>();
+    // Entries of threads that have finished and deleted themselves are dropped so the list only grows with the number of running threads
+    m_qlstpqthrWorkerThreads.removeAll(QPointer<QThread>());
+    m_qlstpqthrWorkerThreads.append(pqthrThread);
+    pqthrThread->start();
+}
 
-    if (IComMetaExif::FileCanContainExif(qfiFileInfo.suffix()) == false)
-        return;
 
-    IComMetaExif mexExifMeta(QDir::toNativeSeparators(qfiFileInfo.absoluteFilePath()));
-    if (mexExifMeta.ExifDataPresent())
-        pqtwiFileItem->setData(ExifMeta, QVariant::fromValue(IMetaExif(&mexExifMeta, m_icsInvalidCharSub, m_bExifAdvancedMode)));
+int IUIFileList::FindMetaReadRow(const ISysMetaReadItem & krmriItem, QHash<QString, int> & rqhashRowByName) const
+{
+    // Rows only move if the list is sorted or changed while the tags are being read
+    const int kiNumRows = m_pflmFileModel->RowCount();
+    if (krmriItem.m_iRow < kiNumRows && m_pflmFileModel->GetNameCurrent(krmriItem.m_iRow) == krmriItem.m_qstrName)
+        return krmriItem.m_iRow;
+
+    // Once rows have moved most items in the batch will miss, so the rows are indexed by name the first time one does
+    if (rqhashRowByName.isEmpty())
+    {
+        rqhashRowByName.reserve(kiNumRows);
+        for (int iRow = 0 ; iRow < kiNumRows ; ++iRow)
+            rqhashRowByName.insert(m_pflmFileModel->GetNameCurrent(iRow), iRow);
+    }
+
+    return rqhashRowByName.value(krmriItem.m_qstrName, -1);
+}
+
+
+void IUIFileList::RecordModifiedTime(const int kiRow)
+{
+    if (m_pflmFileModel->GetModified(kiRow) == -1)
+        m_pflmFileModel->SetModified(kiRow, m_pflmFileModel->GetFileInfo(kiRow).lastModified().toMSecsSinceEpoch());
 }
 
 
 void IUIFileList::ReReadMetaTags()
 {
-    if (m_bMetaTagsReadMusic)
+    if (m_bMetaTagsReadMusic || ReadingMetaTags(ISysMetaReader::Music))
         ReadMetaTagsMusic(true);
-    if (m_bMetaTagsReadExif)
+    if (m_bMetaTagsReadExif || ReadingMetaTags(ISysMetaReader::Exif))
         ReadMetaTagsExif(true);
 }
 
 
 void IUIFileList::ReReadMusicTags()
 {
-    if (m_bMetaTagsReadMusic)
+    if (m_bMetaTagsReadMusic || ReadingMetaTags(ISysMetaReader::Music))
         ReadMetaTagsMusic(true);
 }
 
 
 void IUIFileList::ReReadExifTags()
 {
-    if (m_bMetaTagsReadExif)
+    if (m_bMetaTagsReadExif || ReadingMetaTags(ISysMetaReader::Exif))
         ReadMetaTagsExif(true);
 }
 
@@ -928,35 +1383,20 @@ void IUIFileList::SelectionChanged()
             return;
     m_bSyncSelection = false;
 
-    if (sender() == m_pqtwNameCurrent)
-        SyncSelectionXToY(m_pqtwNameCurrent, m_pqtwNamePreview);
-    else
-        SyncSelectionXToY(m_pqtwNamePreview, m_pqtwNameCurrent);
-
     if (m_rpuirRenameUI->GetRenameUIFilter()->RenameElements() == IUIRenameFilter::RenameSelectedItems)
     {
         FlagSelectedItemsForRenaming();
-        GeneratePreviewNameAndExtension();
+        GeneratePreview(IUIRename::NoTab);
     }
 
     m_bSyncSelection = true;
 }
 
 
-void IUIFileList::SyncSelectionXToY(QTableWidget* pqtwSyncFrom, QTableWidget* pqtwSyncTo)
-{
-    pqtwSyncTo->clearSelection();
-    QList<QTableWidgetSelectionRange> qlqtwslSelections = pqtwSyncFrom->selectedRanges();
-    QList<QTableWidgetSelectionRange>::const_iterator kitSelection;
-    for (kitSelection = qlqtwslSelections.constBegin() ; kitSelection != qlqtwslSelections.constEnd() ; ++kitSelection)
-        pqtwSyncTo->QTableWidget::setRangeSelected(*kitSelection, true);
-}
-
-
 void IUIFileList::SyncScrollPreviewToCurrent()
 {
-    QScrollBar *pqsbScrollBarCurrent = m_pqtwNameCurrent->verticalScrollBar();
-    QScrollBar *pqsbScrollBarPreview = m_pqtwNamePreview->verticalScrollBar();
+    QScrollBar *pqsbScrollBarCurrent = m_pqtvNameCurrent->verticalScrollBar();
+    QScrollBar *pqsbScrollBarPreview = m_pqtvNamePreview->verticalScrollBar();
 
     pqsbScrollBarPreview->setValue(pqsbScrollBarCurrent->value());
 }
@@ -964,8 +1404,8 @@ void IUIFileList::SyncScrollPreviewToCurrent()
 
 void IUIFileList::SyncScrollCurrentToPreview()
 {
-    QScrollBar *pqsbScrollBarCurrent = m_pqtwNameCurrent->verticalScrollBar();
-    QScrollBar *pqsbScrollBarPreview = m_pqtwNamePreview->verticalScrollBar();
+    QScrollBar *pqsbScrollBarCurrent = m_pqtvNameCurrent->verticalScrollBar();
+    QScrollBar *pqsbScrollBarPreview = m_pqtvNamePreview->verticalScrollBar();
 
     pqsbScrollBarCurrent->setValue(pqsbScrollBarPreview->value());
 }
@@ -1046,10 +1486,10 @@ void IUIFileList::SetDirectoryFromAddressBar()
     {
         //PrintWatchList();
 
-        const int kiNumRows = m_pqtwNameCurrent->rowCount();
+        const int kiNumRows = m_pflmFileModel->RowCount();
         for (int iRow = 0 ; iRow < kiNumRows ; ++iRow)
         {
-            qDebug() << m_pqtwNameCurrent->item(iRow, 0)->data(FileInfo).value<QFileInfo>().fileName() << m_pqtwNameCurrent->item(iRow, 0)->data(FileInfo).value<QFileInfo>().suffix();
+            qDebug() << m_pflmFileModel->GetFileInfo(iRow).fileName() << m_pflmFileModel->GetFileInfo(iRow).suffix();
         }
 
         return;
@@ -1164,29 +1604,35 @@ void IUIFileList::EnableBackForwardActions()
 
 void IUIFileList::OpenItemAtRow(const int kiRow)
 {
-    if (m_pqtwNameCurrent->item(kiRow, 0)->data(FileInfo).value<QFileInfo>().isDir())
+    if (m_pflmFileModel->IsDir(kiRow))
     {
         m_qsqstrForwardStack.clear();
         m_qsqstrBackStack.push(m_bDisplayingMyComputer ? m_qstrMyComputerPath : m_qdirDirReader.path());
         EnableBackForwardActions();
-        SetDirectory(m_pqtwNameCurrent->item(kiRow, 0)->data(FileInfo).value<QFileInfo>().filePath());
+        SetDirectory(m_pflmFileModel->GetFileInfo(kiRow).filePath());
     }
-    else if (m_pqtwNameCurrent->item(kiRow, 0)->data(FileInfo).value<QFileInfo>().isFile())
+    else if (m_pflmFileModel->IsFile(kiRow))
     {
         if (m_bOpenFileWhenDblClicked)
         {
             // fromUserInput() is necessary for paths containing spaces as it replaces the space character with the %20 encoding required by QUrl
-            QDesktopServices::openUrl(QUrl(QUrl::fromUserInput(m_pqtwNameCurrent->item(kiRow, 0)->data(FileInfo).value<QFileInfo>().absoluteFilePath())));
+            QDesktopServices::openUrl(QUrl(QUrl::fromUserInput(m_pflmFileModel->GetFileInfo(kiRow).absoluteFilePath())));
         }
     }
 }
 
 
+void IUIFileList::OpenItemAtIndex(const QModelIndex & krqmiIndex)
+{
+    OpenItemAtRow(krqmiIndex.row());
+}
+
+
 void IUIFileList::OpenFilePropertiesForRow(const int kiRow)
 {
-    if (m_pqtwNameCurrent->item(kiRow, 0)->data(FileInfo).value<QFileInfo>().isFile())
+    if (m_pflmFileModel->IsFile(kiRow))
     {
-        new IComDlgFileProperties(m_pqtwNameCurrent->item(kiRow, 0)->data(FileInfo).value<QFileInfo>().filePath());
+        new IComDlgFileProperties(m_pflmFileModel->GetFileInfo(kiRow).filePath());
     }
 }
 
@@ -1199,13 +1645,17 @@ void IUIFileList::OpenRenameFileDlgForRow(const int kiRow)
         return;
     }
 
-    new IDlgRenameFile(this, m_qdirDirReader, m_pqtwNameCurrent->item(kiRow, 0)->text());
+    new IDlgRenameFile(this, m_qdirDirReader, m_pflmFileModel->GetNameCurrent(kiRow));
 }
 
 
 void IUIFileList::OpenRenameFileDlgForCurrentRow()
 {
-    OpenRenameFileDlgForRow(m_pqtwNameCurrent->selectedRanges().first().topRow());
+    const QModelIndexList kqmilSelectedRows = m_pqtvNameCurrent->selectionModel()->selectedRows();
+    if (kqmilSelectedRows.isEmpty())
+        return;
+
+    OpenRenameFileDlgForRow(kqmilSelectedRows.first().row());
 }
 
 
@@ -1218,21 +1668,21 @@ void IUIFileList::ShowContextMenu(QPoint qpntClickPoint)
         m_pqacgSortGroup->setEnabled(true);
     #endif
 
-    QModelIndex qmiIndex = m_pqtwNameCurrent->indexAt(qpntClickPoint);
+    QModelIndex qmiIndex = m_pqtvNameCurrent->indexAt(qpntClickPoint);
     if (qmiIndex.isValid() == false)
     {
-        m_pqmenuEmptyAreaContextMenu->popup(m_pqtwNameCurrent->viewport()->mapToGlobal(qpntClickPoint));
+        m_pqmenuEmptyAreaContextMenu->popup(m_pqtvNameCurrent->viewport()->mapToGlobal(qpntClickPoint));
     }
-    else if (m_pqtwNameCurrent->item(qmiIndex.row(), 0)->data(FileInfo).value<QFileInfo>().isDir())
+    else if (m_pflmFileModel->IsDir(qmiIndex.row()))
     {
         m_iContextMenuRowClicked = qmiIndex.row();
         m_pqactRenameFolder->setEnabled(!m_bDisplayingMyComputer);
-        m_pqmenuFolderContextMenu->popup(m_pqtwNameCurrent->viewport()->mapToGlobal(qpntClickPoint));
+        m_pqmenuFolderContextMenu->popup(m_pqtvNameCurrent->viewport()->mapToGlobal(qpntClickPoint));
     }
     else
     {
         m_iContextMenuRowClicked = qmiIndex.row();
-        m_pqmenuFileContextMenu->popup(m_pqtwNameCurrent->viewport()->mapToGlobal(qpntClickPoint));
+        m_pqmenuFileContextMenu->popup(m_pqtvNameCurrent->viewport()->mapToGlobal(qpntClickPoint));
     }
 }
 
@@ -1309,7 +1759,7 @@ void IUIFileList::SortByName()
     m_ifisFileSort.SetOrderName();
 
     if (m_rpuirRenameUI->GetRenameUINumber()->Numberingenabled())
-        GeneratePreviewName();
+        GeneratePreview(IUIRename::NoTab);
 }
 
 
@@ -1327,7 +1777,7 @@ void IUIFileList::SortByType()
     m_ifisFileSort.SetOrderType();
 
     if (m_rpuirRenameUI->GetRenameUINumber()->Numberingenabled())
-        GeneratePreviewName();
+        GeneratePreview(IUIRename::NoTab);
 }
 
 
@@ -1341,13 +1791,17 @@ void IUIFileList::SortByModified()
     m_ifisFileSort.SetOrderModified();
 
     if (m_rpuirRenameUI->GetRenameUINumber()->Numberingenabled())
-        GeneratePreviewName();
+        GeneratePreview(IUIRename::NoTab);
 }
 
 
 void IUIFileList::ResortTable(const int kiFolderSortOrder, const int kFileSortOrder)
 {
-    int iNumRows = m_pqtwNameCurrent->rowCount();
+    // The new sort order is applied when the directory read completes
+    if (m_pdenDirEnumerator != nullptr)
+        return;
+
+    int iNumRows = m_pflmFileModel->RowCount();
     int iNumFolders = GetNumFolders();
     int iNumFiles = iNumRows-iNumFolders;
 
@@ -1362,30 +1816,34 @@ void IUIFileList::ResortTable(const int kiFolderSortOrder, const int kFileSortOr
 void IUIFileList::ResortRows(const int kiStart, const int kiEnd, const int kiSortOrder)
 {
     QList<ITableRow*> qlstRowList;
-    qlstRowList.reserve(kiEnd-kiStart);
+    qlstRowList.reserve(kiEnd-kiStart+1);
 
     for (int iRow = kiStart ; iRow <= kiEnd ; ++iRow)
-        qlstRowList.append(new ITableRow(m_pqtwNameCurrent->takeItem(iRow, 0), m_pqtwNamePreview->takeItem(iRow, 0)));
+        qlstRowList.append(new ITableRow(iRow, m_pflmFileModel->GetNameCurrent(iRow), m_pflmFileModel->GetFileInfo(iRow)));
 
     m_ifisFileSort.ResortRows(qlstRowList, kiSortOrder);
 
-    int iIndex = 0;
-    for (int iRow = kiStart ; iRow <= kiEnd ; ++iRow, ++iIndex)
+    // The sorted list gives the row each position should be filled from, which the model applies in one pass
+    QVector<int> qveciNewOrder;
+    qveciNewOrder.reserve(qlstRowList.size());
+    QList<ITableRow*>::const_iterator kitRow;
+    for (kitRow = qlstRowList.constBegin() ; kitRow != qlstRowList.constEnd() ; ++kitRow)
     {
-        m_pqtwNameCurrent->setItem(iRow, 0, qlstRowList.at(iIndex)->m_pqtwiCurrent);
-        m_pqtwNamePreview->setItem(iRow, 0, qlstRowList.at(iIndex)->m_pqtwiPreview);
-        delete qlstRowList.at(iIndex);
+        qveciNewOrder.append((*kitRow)->m_iRow);
+        delete *kitRow;
     }
+
+    m_pflmFileModel->ReorderRows(kiStart, qveciNewOrder);
 }
 
 
 int IUIFileList::GetNumFolders()
 {
     int iNumFolders = 0;
-    int iNumRows = m_pqtwNameCurrent->rowCount();
+    int iNumRows = m_pflmFileModel->RowCount();
     while (iNumFolders < iNumRows)
     {
-        if (m_pqtwNameCurrent->item(iNumFolders, 0)->data(FileInfo).value<QFileInfo>().isDir() == false)
+        if (m_pflmFileModel->IsDir(iNumFolders) == false)
             return iNumFolders;
         ++iNumFolders;
     }
@@ -1393,62 +1851,30 @@ int IUIFileList::GetNumFolders()
 }
 
 
-void IUIFileList::DirectoryChanged(const QString & krqstrDirectory)
+void IUIFileList::DirectoryChanged()
 {
     #ifdef QT_DEBUG
-    qDebug() << "Directory Changed:" << krqstrDirectory;
+    qDebug() << "Directory Changed:" << m_pdwDirWatcher->GetDirectory();
     #endif
 
-    if (m_bAutoRefresh == false || krqstrDirectory != m_qdirDirReader.path())
+    // The changes are left with the watcher while the directory is being read, and taken when the read completes
+    if (m_pdenDirEnumerator != nullptr)
     {
-        #ifdef QT_DEBUG
-        qDebug() << "Ignoring Subdirectory Change:" << krqstrDirectory;
-        #endif
-
+        m_bDirChangedDuringRead = true;
         return;
     }
 
-    RefreshDirectorySoft();
-}
+    // The changes are always taken so they don't build up while auto refresh is disabled
+    ISysDirChangeList qvecdcChanges;
+    const bool kbChangesKnown = m_pdwDirWatcher->TakeChanges(qvecdcChanges);
 
+    if (m_bAutoRefresh == false || m_pdwDirWatcher->GetDirectory() != m_qdirDirReader.path())
+        return;
 
-void IUIFileList::FileChanged(const QString & krqstrFile)
-{
-    #ifdef QT_DEBUG
-    qDebug() << "File Changed:" << krqstrFile;
-    #endif
-
-    QFileInfo qfiModifiedFile(krqstrFile);
-    if (qfiModifiedFile.exists())
-    {
-        const QString qstrFileName = qfiModifiedFile.fileName();
-        const int kiNumRows = m_pqtwNameCurrent->rowCount();
-        for (int iRow = 0 ; iRow < kiNumRows ; ++iRow)
-        {
-            if (m_pqtwNameCurrent->item(iRow, 0)->text() == qstrFileName)
-            {
-                QTableWidgetItem* pqtwiTableItem = m_pqtwNameCurrent->item(iRow, 0);
-
-                // Sometimes it generates a signal twice for one modification, so we check it has actually been modified
-                if (qfiModifiedFile.lastModified() != pqtwiTableItem->data(FileInfo).value<QFileInfo>().lastModified())
-                {
-                    #ifdef QT_DEBUG
-                    qDebug() << "Processing Change:" << krqstrFile;
-                    #endif
-
-                    pqtwiTableItem->setData(FileInfo, QVariant::fromValue(qfiModifiedFile));
-
-                    if (m_bMetaTagsReadMusic)
-                        ReadFileMetaTagsMusic(pqtwiTableItem);
-                    if (m_bMetaTagsReadExif)
-                        ReadFileMetaTagsExif(pqtwiTableItem);
-                }
+    if (kbChangesKnown && ApplyDirectoryChanges(qvecdcChanges))
+        return;
 
-                GeneratePreviewNameAndExtension();
-                break;
-            }
-        }
-    }
+    RefreshDirectorySoft();
 }
 
 
@@ -1456,15 +1882,7 @@ void IUIFileList::PrintWatchList()
 {
     #ifdef QT_DEBUG
     qDebug() << "-=Watch List=-";
-    QStringList qstrlList = m_qfswFSWatcher.directories();
-    QStringList::const_iterator itItem;
-    for (itItem = qstrlList.begin() ; itItem != qstrlList.end() ; ++itItem)
-        qDebug() << "Dir: " << *itItem;
-
-    qstrlList = m_qfswFSWatcher.files();
-    for (itItem = qstrlList.begin() ; itItem != qstrlList.end() ; ++itItem)
-        qDebug() << "File:" << *itItem;
-
+    qDebug() << "Dir: " << m_pdwDirWatcher->GetDirectory();
     qDebug() << endl;
     #endif
 }
@@ -1472,73 +1890,63 @@ void IUIFileList::PrintWatchList()
 
 void IUIFileList::MoveSelectionUp()
 {
-    m_bSyncSelection = false;
-    m_pqtwNameCurrent->setUpdatesEnabled(false);
-    m_pqtwNamePreview->setUpdatesEnabled(false);
+    const int kiNumRows = m_pflmFileModel->RowCount();
+    QVector<int> qveciNewOrder(kiNumRows);
+    for (int iRow = 0 ; iRow < kiNumRows ; ++iRow)
+        qveciNewOrder[iRow] = iRow;
 
-    IComTableWidgetSelectionSortAsc twslSelectionSortAsc;
-    QList<QTableWidgetSelectionRange> qlitwirSelectedRange = m_pqtwNameCurrent->selectedRanges();
-    std::sort(qlitwirSelectedRange.begin(), qlitwirSelectedRange.end(), twslSelectionSortAsc);
+    IComItemSelectionSortAsc issSelectionSortAsc;
+    QItemSelection qisSelection = m_pqtvNameCurrent->selectionModel()->selection();
+    std::sort(qisSelection.begin(), qisSelection.end(), issSelectionSortAsc);
 
     int iTop = 0;
-    QList<QTableWidgetSelectionRange>::const_iterator kitSelection;
-    for (kitSelection = qlitwirSelectedRange.constBegin() ; kitSelection != qlitwirSelectedRange.constEnd() ; ++kitSelection)
-    {
-        MoveSelectionUp(m_pqtwNameCurrent, iTop, kitSelection->topRow(), kitSelection->bottomRow());
-        iTop = MoveSelectionUp(m_pqtwNamePreview, iTop, kitSelection->topRow(), kitSelection->bottomRow());
-    }
+    QItemSelection::const_iterator kitSelection;
+    for (kitSelection = qisSelection.constBegin() ; kitSelection != qisSelection.constEnd() ; ++kitSelection)
+        iTop = MoveSelectionUp(qveciNewOrder, iTop, kitSelection->top(), kitSelection->bottom());
 
-    m_pqtwNameCurrent->setUpdatesEnabled(true);
-    m_pqtwNamePreview->setUpdatesEnabled(true);
+    // The selection model follows the moved rows, so the selection doesn't need to be updated
+    m_bSyncSelection = false;
+    m_pflmFileModel->ReorderRows(0, qveciNewOrder);
     m_bSyncSelection = true;
 
     if (m_rpuirRenameUI->GetRenameUINumber()->Numberingenabled())
-        GeneratePreviewName();
+        GeneratePreview(IUIRename::NoTab);
 }
 
 
 void IUIFileList::MoveSelectionDown()
 {
-    m_bSyncSelection = false;
-    m_pqtwNameCurrent->setUpdatesEnabled(false);
-    m_pqtwNamePreview->setUpdatesEnabled(false);
+    const int kiNumRows = m_pflmFileModel->RowCount();
+    QVector<int> qveciNewOrder(kiNumRows);
+    for (int iRow = 0 ; iRow < kiNumRows ; ++iRow)
+        qveciNewOrder[iRow] = iRow;
 
-    IComTableWidgetSelectionSortDesc twslSelectionSortDesc;
-    QList<QTableWidgetSelectionRange> qlitwirSelectedRange = m_pqtwNameCurrent->selectedRanges();
-    std::sort(qlitwirSelectedRange.begin(), qlitwirSelectedRange.end(), twslSelectionSortDesc);
+    IComItemSelectionSortDesc issSelectionSortDesc;
+    QItemSelection qisSelection = m_pqtvNameCurrent->selectionModel()->selection();
+    std::sort(qisSelection.begin(), qisSelection.end(), issSelectionSortDesc);
 
-    int iBottom = m_pqtwNameCurrent->rowCount() - 1;
-    QList<QTableWidgetSelectionRange>::const_iterator kitSelection;
-    for (kitSelection = qlitwirSelectedRange.constBegin() ; kitSelection != qlitwirSelectedRange.constEnd() ; ++kitSelection)
-    {
-        MoveSelectionDown(m_pqtwNameCurrent, iBottom, kitSelection->topRow(), kitSelection->bottomRow());
-        iBottom = MoveSelectionDown(m_pqtwNamePreview, iBottom, kitSelection->topRow(), kitSelection->bottomRow());
-    }
+    int iBottom = kiNumRows - 1;
+    QItemSelection::const_iterator kitSelection;
+    for (kitSelection = qisSelection.constBegin() ; kitSelection != qisSelection.constEnd() ; ++kitSelection)
+        iBottom = MoveSelectionDown(qveciNewOrder, iBottom, kitSelection->top(), kitSelection->bottom());
 
-    m_pqtwNameCurrent->setUpdatesEnabled(true);
-    m_pqtwNamePreview->setUpdatesEnabled(true);
+    m_bSyncSelection = false;
+    m_pflmFileModel->ReorderRows(0, qveciNewOrder);
     m_bSyncSelection = true;
 
     if (m_rpuirRenameUI->GetRenameUINumber()->Numberingenabled())
-        GeneratePreviewName();
+        GeneratePreview(IUIRename::NoTab);
 }
 
 
-int IUIFileList::MoveSelectionUp(QTableWidget * pqtwTable,  const int kiTop, const int kiSelectionTop, const int kiSelectionBottom)
+int IUIFileList::MoveSelectionUp(QVector<int> & rqveciRowOrder, const int kiTop, const int kiSelectionTop, const int kiSelectionBottom)
 {
-    QTableWidgetItem* pqtwiItemAboveSelection;
-    QTableWidgetItem* pqtwiItemShiftUp;
     if (kiSelectionTop != kiTop)
     {
-        pqtwiItemAboveSelection = pqtwTable->takeItem(kiSelectionTop-1, 0);
+        const int kiRowAboveSelection = rqveciRowOrder.at(kiSelectionTop-1);
         for (int iRow = kiSelectionTop ; iRow <= kiSelectionBottom ; ++iRow)
-        {
-            pqtwiItemShiftUp = pqtwTable->takeItem(iRow, 0);
-            pqtwTable->setItem(iRow-1, 0, pqtwiItemShiftUp);
-        }
-        pqtwTable->setItem(kiSelectionBottom, 0, pqtwiItemAboveSelection);
-        pqtwTable->setRangeSelected(QTableWidgetSelectionRange(kiSelectionTop,   0, kiSelectionBottom,   0), false);
-        pqtwTable->setRangeSelected(QTableWidgetSelectionRange(kiSelectionTop-1, 0, kiSelectionBottom-1, 0), true);
+            rqveciRowOrder[iRow-1] = rqveciRowOrder.at(iRow);
+        rqveciRowOrder[kiSelectionBottom] = kiRowAboveSelection;
 
         return kiSelectionBottom;
     }
@@ -1546,21 +1954,14 @@ int IUIFileList::MoveSelectionUp(QTableWidget * pqtwTable,  const int kiTop, con
 }
 
 
-int IUIFileList::MoveSelectionDown(QTableWidget * pqtwTable,  const int kiBottom, const int kiSelectionTop, const int kiSelectionBottom)
+int IUIFileList::MoveSelectionDown(QVector<int> & rqveciRowOrder, const int kiBottom, const int kiSelectionTop, const int kiSelectionBottom)
 {
-    QTableWidgetItem* pqtwiItemBelowSelection;
-    QTableWidgetItem* pqtwiItemShiftDown;
     if (kiSelectionBottom != kiBottom)
     {
-        pqtwiItemBelowSelection = pqtwTable->takeItem(kiSelectionBottom+1, 0);
+        const int kiRowBelowSelection = rqveciRowOrder.at(kiSelectionBottom+1);
         for (int iRow = kiSelectionBottom ; iRow >= kiSelectionTop ; --iRow)
-        {
-            pqtwiItemShiftDown = pqtwTable->takeItem(iRow, 0);
-            pqtwTable->setItem(iRow+1, 0, pqtwiItemShiftDown);
-        }
-        pqtwTable->setItem(kiSelectionTop, 0, pqtwiItemBelowSelection);
-        pqtwTable->setRangeSelected(QTableWidgetSelectionRange(kiSelectionTop,   0, kiSelectionBottom,   0), false);
-        pqtwTable->setRangeSelected(QTableWidgetSelectionRange(kiSelectionTop+1, 0, kiSelectionBottom+1, 0), true);
+            rqveciRowOrder[iRow+1] = rqveciRowOrder.at(iRow);
+        rqveciRowOrder[kiSelectionTop] = kiRowBelowSelection;
 
         return kiSelectionTop;
     }
@@ -1568,191 +1969,140 @@ int IUIFileList::MoveSelectionDown(QTableWidget * pqtwTable,  const int kiBottom
 }
 
 
-void IUIFileList::GeneratePreviewName()
+void IUIFileList::GeneratePreview(const int kiChangedStage)
 {
-    if (m_rpuirRenameUI->ChangingSettings() || m_bDisplayingMyComputer)
+    if (m_rpuirRenameUI->ChangingSettings() || m_bDisplayingMyComputer || m_pdenDirEnumerator != nullptr)
+    {
+        m_bPreviewStagesStale = true;
         return;
+    }
+
+    if (m_bPreviewStagesStale)
+    {
+        m_pflmFileModel->ClearPreviewStages();
+        m_bPreviewStagesStale = false;
+    }
 
     #ifdef QT_DEBUG
-    qDebug() << "-=Generating Preview Name=-";
+    qDebug() << "-=Generating Preview From Stage" << kiChangedStage << "=-";
     #endif
 
-    QString qstrFileName;
-    QString qstrGeneratedName;
-    QString qstrPreviewName;
-    QString qstrPreviewExtension;
-    QTableWidgetItem* pqtwiFileItem;
-    int iExtensionIndexCurrent;
-    int iExtensionIndexPreview;
-
     FlagItemsForRenaming();
-    m_rpuirRenameUI->GetRenameUINumber()->InitNumberingVals(m_iNumFilesToRename);
 
-    const int kiNumRows = m_pqtwNameCurrent->rowCount();
+    const IRenamePlan krplPlan = m_rpuirRenameUI->CompileRenamePlan(m_iNumFilesToRename, m_icsInvalidCharSub);
+
+    // The zero fill depends on the number of files being renamed, so if that has changed every file is renumbered
+    const bool kbRenumberAll = (kiChangedStage == IUIRename::Numbering || m_iNumFilesToRename != m_iPreviewNumFilesToRename);
+    m_iPreviewNumFilesToRename = m_iNumFilesToRename;
+
+    // Work out which rows need generating, and each row's rename index for numbering, before handing the rows out to the threads
+    QVector<IRenamePreviewRow> qvecrprRows;
+    qvecrprRows.reserve(m_iNumFilesToRename);
+    IRenamePreviewRow rprRow;
+    int iRenameIndex = 0;
+    const int kiNumRows = m_pflmFileModel->RowCount();
     for (int iRow = 0 ; iRow < kiNumRows ; ++iRow)
     {
-        pqtwiFileItem = m_pqtwNameCurrent->item(iRow, 0);
-        qstrFileName = pqtwiFileItem->text();
-        if (pqtwiFileItem->data(FlaggedForRenme).toBool() == false)
-        {
-           m_pqtwNamePreview->item(iRow, 0)->setText(qstrFileName);
-        }
-        else if (pqtwiFileItem->data(FileInfo).value<QFileInfo>().isDir())
+        // Unflagged rows aren't updated when settings change, so their cache is discarded
+        if (m_pflmFileModel->FlaggedForRename(iRow) == false)
         {
-            m_rpuirRenameUI->GenerateName(qstrFileName, pqtwiFileItem);
-            m_pqtwNamePreview->item(iRow, 0)->setText(qstrFileName);
+            m_pflmFileModel->SetRenameIndex(iRow, -1);
+            m_pflmFileModel->ClearPreviewStages(iRow);
+            m_pflmFileModel->SetNamePreview(iRow, m_pflmFileModel->GetNameCurrent(iRow));
+            continue;
         }
-        else
-        {
-            // left() returns entire string if n is less than zero, so this works even if there's no extension
-            iExtensionIndexCurrent = qstrFileName.lastIndexOf('.');
-            qstrGeneratedName = qstrFileName.left(iExtensionIndexCurrent);
-            m_rpuirRenameUI->GenerateName(qstrGeneratedName, pqtwiFileItem);
 
-            // Use extension from Preview table rather than generate it again since no changes have been made to the extension settings
-            qstrPreviewName = m_pqtwNamePreview->item(iRow, 0)->text();
-            iExtensionIndexPreview = qstrPreviewName.lastIndexOf('.');
+        rprRow.m_iRow = iRow;
+        rprRow.m_iRenameIndex = iRenameIndex++;
+        rprRow.m_bRenumber = (kbRenumberAll || m_pflmFileModel->GetRenameIndex(iRow) != rprRow.m_iRenameIndex);
+        m_pflmFileModel->SetRenameIndex(iRow, rprRow.m_iRenameIndex);
 
-            if (iExtensionIndexPreview == -1 || iExtensionIndexCurrent == -1)
-            {
-                m_pqtwNamePreview->item(iRow, 0)->setText(qstrGeneratedName);
-            }
-            else
-            {
-                qstrPreviewExtension = qstrPreviewName.mid(iExtensionIndexPreview);
-                m_pqtwNamePreview->item(iRow, 0)->setText(qstrGeneratedName + qstrPreviewExtension);
-            }
+        QStringList & rqstrlStages = m_pflmFileModel->GetPreviewStages(iRow);
+        rprRow.m_bCached = (rqstrlStages.size() == IUIRename::NumTabs);
+        if (rprRow.m_bCached && rprRow.m_bRenumber == false && kiChangedStage == IUIRename::NoTab)
+            continue;
+
+        // The list is detached here so writing the stage outputs from the threads never needs to detach it
+        if (rprRow.m_bCached == false)
+        {
+            rqstrlStages.reserve(IUIRename::NumTabs);
+            for (int iStage = 0 ; iStage < IUIRename::NumTabs ; ++iStage)
+                rqstrlStages.append(QString());
         }
+        rqstrlStages.detach();
+        rprRow.m_pqstrlStages = &rqstrlStages;
+        qvecrprRows.append(rprRow);
+    }
+
+    // Starting threads costs more than generating a few hundred names, so small batches are generated here
+    IPreviewRowGenerator prgGenerator(krplPlan, m_pflmFileModel, kiChangedStage);
+    if (qvecrprRows.size() >= m_kiMinRowsForThreads)
+    {
+        QtConcurrent::blockingMap(qvecrprRows, prgGenerator);
+    }
+    else
+    {
+        QVector<IRenamePreviewRow>::iterator itRow;
+        for (itRow = qvecrprRows.begin() ; itRow != qvecrprRows.end() ; ++itRow)
+            prgGenerator(*itRow);
     }
+
+    QVector<IRenamePreviewRow>::const_iterator kitRow;
+    for (kitRow = qvecrprRows.constBegin() ; kitRow != qvecrprRows.constEnd() ; ++kitRow)
+        m_pflmFileModel->SetNamePreview(kitRow->m_iRow, kitRow->m_qstrPreviewName);
+
     HighlightRowsWithModifiedNames();
 }
 
 
 void IUIFileList::GeneratePreviewNameAndExtension()
 {
-    if (m_rpuirRenameUI->ChangingSettings() || m_bDisplayingMyComputer)
-        return;
-
-    #ifdef QT_DEBUG
-    qDebug() << "-=Generating Preview Name & Extension=-";
-    #endif
-
-    QString qstrFileName;
-    QString qstrGeneratedName;
-    QString qstrGeneratedExtension;
-    QTableWidgetItem* pqtwiFileItem;
-    int iExtensionIndex;
-
-    FlagItemsForRenaming();
-    m_rpuirRenameUI->GetRenameUINumber()->InitNumberingVals(m_iNumFilesToRename);
-
-    const int kiNumRows = m_pqtwNameCurrent->rowCount();
-    for (int iRow = 0 ; iRow < kiNumRows ; ++iRow)
-    {
-        pqtwiFileItem = m_pqtwNameCurrent->item(iRow, 0);
-        qstrFileName = pqtwiFileItem->text();
-        if (pqtwiFileItem->data(FlaggedForRenme).toBool() == false)
-        {
-           m_pqtwNamePreview->item(iRow, 0)->setText(qstrFileName);
-        }
-        else if (pqtwiFileItem->data(FileInfo).value<QFileInfo>().isDir())
-        {
-            m_rpuirRenameUI->GenerateName(qstrFileName, pqtwiFileItem);
-            m_pqtwNamePreview->item(iRow, 0)->setText(qstrFileName);
-        }
-        else
-        {
-            // left() returns entire string if n is less than zero, so this works even if there's no extension
-            iExtensionIndex = qstrFileName.lastIndexOf('.');
-            qstrGeneratedName = qstrFileName.left(iExtensionIndex);
-            m_rpuirRenameUI->GenerateName(qstrGeneratedName, pqtwiFileItem);
-
-            if (iExtensionIndex == -1)
-            {
-                m_pqtwNamePreview->item(iRow, 0)->setText(qstrGeneratedName);
-            }
-            else
-            {
-                qstrGeneratedExtension = qstrFileName.mid(iExtensionIndex+1);
-                m_rpuirRenameUI->GenerateExtension(qstrGeneratedExtension, pqtwiFileItem);
-                if (qstrGeneratedExtension.isEmpty())
-                {
-                    m_pqtwNamePreview->item(iRow, 0)->setText(qstrGeneratedName);
-                }
-                else if (qstrGeneratedExtension.startsWith('.'))
-                {
-                    int iIndex = 1;
-                    int iLength = qstrGeneratedExtension.length();
-                    while (iIndex < iLength && qstrGeneratedExtension.at(iIndex) == '.')
-                        ++iIndex;
-
-                    if (iIndex >= iLength)
-                        m_pqtwNamePreview->item(iRow, 0)->setText(qstrGeneratedName);
-                    else
-                        m_pqtwNamePreview->item(iRow, 0)->setText(qstrGeneratedName + qstrGeneratedExtension.mid(iIndex-1));
-                }
-                else
-                {
-                    m_pqtwNamePreview->item(iRow, 0)->setText(qstrGeneratedName + '.' + qstrGeneratedExtension);
-                }
-            }
-        }
-    }
-    HighlightRowsWithModifiedNames();
+    // Settings that affect every stage have changed (case sensitivity, tag settings, clearing all tabs), so nothing cached can be reused
+    m_pflmFileModel->ClearPreviewStages();
+    GeneratePreview(IUIRename::NoTab);
 }
 
 
 void IUIFileList::RenameElementsSettingsChanged()
 {
-    GeneratePreviewNameAndExtension();
+    GeneratePreview(IUIRename::NoTab);
 }
 
 
-void IUIFileList::HighlightRowsWithModifiedNames(const bool kbForceRedraw)
+void IUIFileList::HighlightRowsWithModifiedNames()
 {
-    bool bNameChangeColourText   = m_bNameChangeColourText || kbForceRedraw;
-    bool bNameChangeHighlightRow = m_bNameChangeHighlightRow || kbForceRedraw;
-
-    QColor qcolDefaultForeground    = (QApplication::palette().text().color());
-    QColor qcolDefaultBackground    = (QApplication::palette().base().color());
-    QColor qcolHighlightForeground = m_bNameChangeColourText ? m_qcolNameChangeTextColour : qcolDefaultForeground;
-    QColor qcolHighlightBackground = m_bNameChangeHighlightRow ? m_qcolNameChangeHighlightColour : qcolDefaultBackground;
-
-    bool bRowChanged;
+    // Highlight colours are applied by the model when rows are painted from the row's name changed flag, so we only need to check if there's
+    // anything to rename and repaint the rows whose preview changed
     bool bFilesToRename = false;
-    int iNumFiles = m_pqtwNameCurrent->rowCount();
-    for (int iRow = 0 ; iRow < iNumFiles ; ++iRow)
+    const int kiNumFiles = m_pflmFileModel->RowCount();
+    for (int iRow = 0 ; iRow < kiNumFiles ; ++iRow)
     {
-        bRowChanged = m_pqtwNameCurrent->item(iRow, 0)->text() != m_pqtwNamePreview->item(iRow, 0)->text();
-
-        if (bNameChangeColourText)
-            m_pqtwNamePreview->item(iRow, 0)->setForeground(bRowChanged ? qcolHighlightForeground : qcolDefaultForeground);
-
-        if (bNameChangeHighlightRow)
-            m_pqtwNamePreview->item(iRow, 0)->setBackground(bRowChanged ? qcolHighlightBackground : qcolDefaultBackground);
-
-        if (bFilesToRename == false && bRowChanged == true)
+        if (m_pflmFileModel->NameChanged(iRow))
+        {
             bFilesToRename = true;
+            break;
+        }
     }
 
-    m_rpuirRenameUI->EnableRenameButton(bFilesToRename);
+    m_pflmFileModel->PreviewNamesChanged();
+    m_rpuirRenameUI->EnableRenameButton(bFilesToRename && FlaggedRowsPending() == false);
 }
 
 
 void IUIFileList::PerformRename()
 {
-    if (RenameEndResultValid() == false)
+    if (FlaggedRowsPending() || RenameEndResultValid() == false)
         return;
 
     QList<int> qlstiRows;
     QStringList qstrlCurrentName, qstrlNewName;
-    const int kiNumRows = m_pqtwNameCurrent->rowCount();
+    const int kiNumRows = m_pflmFileModel->RowCount();
     for (int iRow = 0 ; iRow < kiNumRows ; ++iRow)
     {
-        if (m_pqtwNameCurrent->item(iRow, 0)->data(FlaggedForRenme).toBool() && m_pqtwNameCurrent->item(iRow, 0)->text() != m_pqtwNamePreview->item(iRow, 0)->text())
+        if (m_pflmFileModel->FlaggedForRename(iRow) && m_pflmFileModel->NameChanged(iRow))
         {
-            qstrlCurrentName.push_back(m_pqtwNameCurrent->item(iRow, 0)->text());
-            qstrlNewName.push_back(m_pqtwNamePreview->item(iRow, 0)->text());
+            qstrlCurrentName.push_back(m_pflmFileModel->GetNameCurrent(iRow));
+            qstrlNewName.push_back(m_pflmFileModel->GetNamePreview(iRow));
             qlstiRows.push_back(iRow);
         }
     }
@@ -1781,6 +2131,21 @@ void IUIFileList::UndoRename()
         }
     }
 
+    // RenameFiles() checks the renames against the rows of the directory, so they must all have been read
+    if (m_pdenDirEnumerator != nullptr)
+    {
+        m_bUndoPending = true;
+        m_rpuirRenameUI->EnableUndoButton(false);
+        return;
+    }
+
+    PerformUndo();
+}
+
+
+void IUIFileList::PerformUndo()
+{
+    m_bUndoPending = false;
     RenameFiles(m_qstrlUndoRenameFrom, m_qstrlUndoRenameTo);
 
     m_rpuirRenameUI->EnableUndoButton(false);
@@ -1819,9 +2184,6 @@ void IUIFileList::RenameFiles(QStringList & rqstrlCurrentName, QStringList & rqs
         qstrNewName     = rqstrlNewName.at(iIndex);
         idprgRenameProgress.UpdateMessage(tr("Renaming: %1\nTo: %2").arg(qstrCurrentName).arg(qstrNewName));
 
-        if (bUndoOperation == false)
-            RemoveInvalidTrailingCharacters(qstrNewName);
-
         if (m_qdirDirReader.rename(qstrCurrentName, qstrNewName) == false)
         {
             if (preldRenameErrorsDialog == nullptr)
@@ -1829,14 +2191,14 @@ void IUIFileList::RenameFiles(QStringList & rqstrlCurrentName, QStringList & rqs
 
             QFileInfo qfiFileInfo;
             if (bUndoOperation == false)
-                qfiFileInfo = m_pqtwNameCurrent->item(pqlstiRows->at(iIndex), 0)->data(FileInfo).value<QFileInfo>();
+                qfiFileInfo = m_pflmFileModel->GetFileInfo(pqlstiRows->at(iIndex));
             preldRenameErrorsDialog->AddToErrorList(qstrCurrentName, qstrNewName, DetermineReasonForFailure(qstrCurrentName, qstrNewName, qfiFileInfo));
         }
         else
         {
             if (bUndoOperation == false)
             {
-                m_pqtwNameCurrent->item(pqlstiRows->at(iIndex), 0)->setText(qstrNewName);
+                m_pflmFileModel->SetNameCurrent(pqlstiRows->at(iIndex), qstrNewName);
                 m_qstrlUndoRenameFrom.push_back(qstrNewName);
                 m_qstrlUndoRenameTo.push_back(qstrCurrentName);
             }
@@ -1877,9 +2239,6 @@ void IUIFileList::RenameFilesIntermediate(QStringList & rqstrlCurrentName, QStri
         qstrCurrentName = rqstrlCurrentName.at(iIndex);
         qstrNewName     = rqstrlNewName.at(iIndex);
 
-        if (bUndoOperation == false)
-            RemoveInvalidTrailingCharacters(qstrNewName);
-
         qstrIntermedName = QString("INV#%1#.%2").arg(uiIntermedNum--, 8, 16, QChar('0')).arg(qstrNewName);
         if (m_qdirDirReader.rename(qstrCurrentName, qstrIntermedName) == false)
         {
@@ -1888,14 +2247,14 @@ void IUIFileList::RenameFilesIntermediate(QStringList & rqstrlCurrentName, QStri
 
             QFileInfo qfiFileInfo;
             if (bUndoOperation == false)
-                qfiFileInfo = m_pqtwNameCurrent->item(pqlstiRows->at(iIndex), 0)->data(FileInfo).value<QFileInfo>();
+                qfiFileInfo = m_pflmFileModel->GetFileInfo(pqlstiRows->at(iIndex));
             preldRenameErrorsDialog->AddToErrorList(qstrCurrentName, qstrNewName, DetermineReasonForFailure(qstrCurrentName, qstrNewName, qfiFileInfo));
         }
         else
         {
             if (bUndoOperation == false)
             {
-                m_pqtwNameCurrent->item(pqlstiRows->at(iIndex), 0)->setText(qstrNewName);
+                m_pflmFileModel->SetNameCurrent(pqlstiRows->at(iIndex), qstrNewName);
                 m_qstrlUndoRenameFrom.push_back(qstrIntermedName);
                 m_qstrlUndoRenameTo.push_back(qstrCurrentName);
             }
@@ -1967,9 +2326,6 @@ void IUIFileList::RenameFilesValidated(QStringList & rqstrlCurrentName, QStringL
         qstrCurrentName = rqstrlCurrentName.at(iIndex);
         qstrNewName     = rqstrlNewName.at(iIndex);
 
-        if (bUndoOperation == false)
-            RemoveInvalidTrailingCharacters(qstrNewName);
-
         if (bItermediateRename)
         {
             qstrIntermedName = QString("INV#%1#.%2").arg(uiIntermedNum, 8, 16, QChar('0')).arg(qstrNewName);
@@ -1983,14 +2339,14 @@ void IUIFileList::RenameFilesValidated(QStringList & rqstrlCurrentName, QStringL
 
             QFileInfo qfiFileInfo;
             if (bUndoOperation == false)
-                qfiFileInfo = m_pqtwNameCurrent->item(pqlstiRows->at(iIndex), 0)->data(FileInfo).value<QFileInfo>();
+                qfiFileInfo = m_pflmFileModel->GetFileInfo(pqlstiRows->at(iIndex));
             preldRenameErrorsDialog->AddToErrorList(qstrCurrentName, qstrNewName, DetermineReasonForFailure(qstrCurrentName, qstrNewName, qfiFileInfo));
         }
         else
         {
             if (bUndoOperation == false)
             {
-                m_pqtwNameCurrent->item(pqlstiRows->at(iIndex), 0)->setText(qstrNewName);
+                m_pflmFileModel->SetNameCurrent(pqlstiRows->at(iIndex), qstrNewName);
                 m_qstrlUndoRenameFrom.push_back(rqstrRenameName);
                 m_qstrlUndoRenameTo.push_back(qstrCurrentName);
             }
@@ -2034,28 +2390,10 @@ void IUIFileList::RenameFilesValidated(QStringList & rqstrlCurrentName, QStringL
 }
 
 
-void IUIFileList::RemoveInvalidTrailingCharacters(QString & rqstrFileName)
-{
-    // Trailing spaces can make files inaccessible on Windows.  On Linux and Mac traling spaces are allowed, but can cause problems.
-    // On macOS "file.txt" is considered a text file, while "file.txt " is treated as an executable, so it's best to remove trailing spaes on all platforms.
-    // Trailing dots are are also invlaid on Windows, and they again change the MIME type on Mac so we strip them off as well.
-    int iPos = rqstrFileName.length() - 1;
-    QChar qchLastChar = rqstrFileName.at(iPos);
-
-    if (qchLastChar == ' ' || qchLastChar == '.')
-    {
-        do
-            qchLastChar = rqstrFileName.at(--iPos);
-        while (qchLastChar == ' ' || qchLastChar == '.');
-        rqstrFileName = rqstrFileName.left(iPos+1);
-    }
-}
-
-
 bool IUIFileList::RenameEndResultValid()
 {
     int iRow;
-    int iNumRows = m_pqtwNamePreview->rowCount();
+    int iNumRows = m_pflmFileModel->RowCount();
     IDlgRenameErrorList* preldRenameErrorsDialog = nullptr;
 
     QHash<QString, int> qhshHash;
@@ -2065,16 +2403,16 @@ bool IUIFileList::RenameEndResultValid()
     for (iRow = 0 ; iRow < iNumRows ; ++iRow)
     {
         #ifdef Q_OS_WIN
-        qstrCompareName = m_pqtwNamePreview->item(iRow, 0)->text().toLower();
+        qstrCompareName = m_pflmFileModel->GetNamePreview(iRow).toLower();
         #else
-        qstrCompareName = m_pqtwNamePreview->item(iRow, 0)->text();
+        qstrCompareName = m_pflmFileModel->GetNamePreview(iRow);
         #endif
 
         if (qhshHash.contains(qstrCompareName))
         {
             if (preldRenameErrorsDialog == nullptr)
                 preldRenameErrorsDialog = new IDlgRenameErrorList(IUIMainWindow::GetMainWindow()->GetFileListUI(), false);
-            preldRenameErrorsDialog->AddToErrorList(m_pqtwNameCurrent->item(iRow, 0)->text(), m_pqtwNamePreview->item(iRow, 0)->text(), tr("Duplicate filename"));
+            preldRenameErrorsDialog->AddToErrorList(m_pflmFileModel->GetNameCurrent(iRow), m_pflmFileModel->GetNamePreview(iRow), tr("Duplicate filename"));
         }
         qhshHash.insert(qstrCompareName, 0);
     }
@@ -2095,15 +2433,15 @@ bool IUIFileList::RenameProccessValid(QStringList & rqstrlCurrentName, QStringLi
     #endif
 
     QHash<QString, int> qhshHash;
-    const int kiNumRows = m_pqtwNameCurrent->rowCount();
+    const int kiNumRows = m_pflmFileModel->RowCount();
     qhshHash.reserve(static_cast<int>(kiNumRows*1.1));
 
     for (int iRow = 0 ; iRow < kiNumRows ; ++iRow)
     {
         #ifdef Q_OS_WIN
-        qhshHash.insert(m_pqtwNameCurrent->item(iRow, 0)->text().toLower(), 0);
+        qhshHash.insert(m_pflmFileModel->GetNameCurrent(iRow).toLower(), 0);
         #else
-        qhshHash.insert(m_pqtwNameCurrent->item(iRow, 0)->text(), 0);
+        qhshHash.insert(m_pflmFileModel->GetNameCurrent(iRow), 0);
         #endif
     }
 
@@ -2172,7 +2510,7 @@ void IUIFileList::SetAutoRefreshEnabled(const bool kbAutoRefresh)
 
 int IUIFileList::GetCurrentRowHeight()
 {
-    return m_pqtwNameCurrent->verticalHeader()->defaultSectionSize();
+    return m_pqtvNameCurrent->verticalHeader()->defaultSectionSize();
 }
 
 
@@ -2203,7 +2541,7 @@ void IUIFileList::SetUserDefinedRowHeight(const bool kbUseUserDefinedRowHeight,
 
 void IUIFileList::SetUseAlternativeFont(const bool kbUseAlternativeFont, const QFont & krqfntSelectedFont)
 {
-    if (kbUseAlternativeFont != m_bUseAlternativeFont || krqfntSelectedFont != m_pqtwNameCurrent->font())
+    if (kbUseAlternativeFont != m_bUseAlternativeFont || krqfntSelectedFont != m_pqtvNameCurrent->font())
     {
         m_bUseAlternativeFont = kbUseAlternativeFont;
         if (kbUseAlternativeFont == false)
@@ -2214,16 +2552,16 @@ void IUIFileList::SetUseAlternativeFont(const bool kbUseAlternativeFont, const Q
 }
 
 
-/* There's a QTableWidget::resizeColumnsToContents() function, but it leaves a lot of padding.
+/* There's a QTableView::resizeColumnsToContents() function, but it leaves a lot of padding.
  * I've tried to remove the padding with the below, but it doesn't reduce the padding.
- *      rpqtwTable->setStyleSheet("QTableWidget::item { padding: 0px; }");
- *      rpqtwTable->setStyleSheet("QTableWidget::item { padding: 0px; border: 0px; margin: 0px; }");
+ *      rpqtvTable->setStyleSheet("QTableView::item { padding: 0px; }");
+ *      rpqtvTable->setStyleSheet("QTableView::item { padding: 0px; border: 0px; margin: 0px; }");
  * Using table->verticalHeader()->setDefaultSectionSize() seems to be the only way to remove the excessive white space in each row.
  *
  * There are similar problem with excessive padding between the icon and the file name that makes it look like there's a space at the start of the file name.
  * I tried the below, but once again it doesn't reduce the padding.
- *      rpqtwTable->setStyleSheet("QTableWidget::icon { padding: 0px; }");
- *      rpqtwTable->setStyleSheet("QTableWidget::icon { padding: 0px; border: 0px; margin: 0px; }");
+ *      rpqtvTable->setStyleSheet("QTableView::icon { padding: 0px; }");
+ *      rpqtvTable->setStyleSheet("QTableView::icon { padding: 0px; border: 0px; margin: 0px; }");
  * I hate excessive padding and white space, but Qt doesn't give you much control over it. */
 void  IUIFileList::SetRowHeightAndIconSize()
 {
@@ -2231,18 +2569,18 @@ void  IUIFileList::SetRowHeightAndIconSize()
     if (m_bUseUserDefinedRowHeight)
         iRowHeight = m_iUserDefinedRowHeight;
     else
-        iRowHeight = IComUtilityFuncs::GetTableRowHeightFitToFont(m_pqtwNameCurrent);
+        iRowHeight = IComUtilityFuncs::GetTableRowHeightFitToFont(m_pqtvNameCurrent);
 
-    if (iRowHeight == m_pqtwNameCurrent->verticalHeader()->defaultSectionSize())
+    if (iRowHeight == m_pqtvNameCurrent->verticalHeader()->defaultSectionSize())
         return;
 
-    m_pqtwNameCurrent->verticalHeader()->setDefaultSectionSize(iRowHeight);
-    m_pqtwNamePreview->verticalHeader()->setDefaultSectionSize(iRowHeight);
+    m_pqtvNameCurrent->verticalHeader()->setDefaultSectionSize(iRowHeight);
+    m_pqtvNamePreview->verticalHeader()->setDefaultSectionSize(iRowHeight);
 
     int iIconSize = iRowHeight - (iRowHeight%16);
     QSize qsizIconSize(iIconSize, iIconSize);
-    m_pqtwNameCurrent->setIconSize(qsizIconSize);
-    m_pqtwNamePreview->setIconSize(qsizIconSize);
+    m_pqtvNameCurrent->setIconSize(qsizIconSize);
+    m_pqtvNamePreview->setIconSize(qsizIconSize);
 }
 
 
@@ -2256,14 +2594,14 @@ void IUIFileList::SetHighlightSettings(const bool kbNameChangeColourText, const
         m_bNameChangeHighlightRow       = kbNameChangeHighlightRow;
         m_qcolNameChangeHighlightColour = krqcolNameChangeHighlightColour;
 
-        HighlightRowsWithModifiedNames(true);
+        m_pflmFileModel->HighlightSettingsChanged();
     }
 }
 
 
 const QFont & IUIFileList::GetCurrentFont()
 {
-    return m_pqtwNameCurrent->font();
+    return m_pqtvNameCurrent->font();
 }
 
 
@@ -2275,10 +2613,10 @@ void IUIFileList::RestoreDefaultFonts()
 
 void IUIFileList::SetTableFont(const QFont & krqfntNewFont)
 {
-    if (krqfntNewFont != m_pqtwNameCurrent->font())
+    if (krqfntNewFont != m_pqtvNameCurrent->font())
     {
-        m_pqtwNameCurrent->setFont(krqfntNewFont);
-        m_pqtwNamePreview->setFont(krqfntNewFont);
+        m_pqtvNameCurrent->setFont(krqfntNewFont);
+        m_pqtvNamePreview->setFont(krqfntNewFont);
         if (m_bUseUserDefinedRowHeight == false)
             SetRowHeightAndIconSize();
     }
@@ -2331,7 +2669,7 @@ void PreviewTableHighlightDelegate::paint(QPainter* painter, const QStyleOptionV
     {
         // Always use INACTIVE widget colour on the Preview table, even if it has focus, and override with name changed highlight colour when necessary
         QStyleOptionViewItem opt = option;
-        bool bNameChanged = m_puifmFileList->m_pqtwNameCurrent->item(index.row(), 0)->text() != m_puifmFileList->m_pqtwNamePreview->item(index.row(), 0)->text();
+        bool bNameChanged = m_puifmFileList->m_pflmFileModel->NameChanged(index.row());
 
         if (bNameChanged && m_puifmFileList->m_bNameChangeColourText)
             opt.palette.setColor(QPalette::HighlightedText, m_puifmFileList->m_qcolNameChangeTextColour);
@@ -3,20 +3,25 @@
 
 #include <QSplitter>
 #include <QDir>
-#include <QFileSystemWatcher>
-#include <QFileIconProvider>
 #include <QActionGroup>
 #include <QStack>
+#include <QPointer>
 #include <QStyledItemDelegate>
 #include "IRenameInvalidCharSub.h"
 #include "ISysFileInfoSort.h"
-class QTableWidget;
-class QTableWidgetItem;
+#include "ISysDirEntry.h"
+#include "ISysDirWatcher.h"
+#include "ISysMetaReader.h"
+class QTableView;
+class QModelIndex;
 class QMenu;
 class IUIMainWindow;
 class IUIMenuBar;
 class IUIToolBar;
 class IUIRename;
+class IUIFileListModel;
+class ISysDirEnumerator;
+class IComDlgProgress;
 
 
 class IUIFileList : public QSplitter
@@ -30,7 +35,24 @@ private:
 
     // For reading directory contents and monitoring for changes in directory
     QDir                        m_qdirDirReader;
-    QFileSystemWatcher          m_qfswFSWatcher;
+    ISysDirWatcher*             m_pdwDirWatcher;
+
+    // Worker thread reading the current directory, which is nullptr when no read is in progress
+    ISysDirEnumerator*          m_pdenDirEnumerator;
+
+    // Incremented for each directory read so batches still queued from a cancelled read can be ignored
+    int                         m_iEnumerationID;
+
+    // Every directory and meta reader thread started, including cancelled ones that are still finishing, so they can be stopped before the
+    // file list is destroyed.  The threads delete themselves when they finish, which sets their entry to nullptr
+    QList<QPointer<QThread> >   m_qlstpqthrWorkerThreads;
+
+    // Entries received from the directory read so far, which are sorted in a single pass when the read completes
+    ISysDirEntryList            m_qvecdeEnumeratedEntries;
+
+    // The directory is watched from the start of the read, so changes made behind the read aren't missed.  The watcher holds the changes
+    // until the read completes, and this is set if it reported any in the meantime
+    bool                        m_bDirChangedDuringRead;
 
     // QDir filter set to either show or hide hidden and system files depending on user preferences
     QDir::Filters               m_qdirfHiddenFileFilter;
@@ -38,10 +60,6 @@ private:
     // For sorting file list using natural numbering
     ISysFileInfoSort            m_ifisFileSort;
 
-    // For loading icons
-    QFileIconProvider           m_qfipIconProvider;
-    QIcon                       m_qicnExeIcon;
-
     // References to UI elements so we can read settings and enable/disable actions
     IUIMenuBar* &               m_rpuimbMenuBar;
     IUIToolBar* &               m_rpuitbToolBar;
@@ -50,9 +68,12 @@ private:
     // Application settings
     QSettings &                 m_rqsetSettings;
 
+    // Model holding the directory listing and preview names, which is shared by both tables
+    IUIFileListModel*           m_pflmFileModel;
+
     // Tables for showing current name and preview of current rename options
-    QTableWidget*               m_pqtwNameCurrent;
-    QTableWidget*               m_pqtwNamePreview;
+    QTableView*                 m_pqtvNameCurrent;
+    QTableView*                 m_pqtvNamePreview;
 
     // Stack of directory paths for back and forward buttons
     QStack<QString>             m_qsqstrBackStack;
@@ -63,6 +84,10 @@ private:
     QStringList                 m_qstrlUndoRenameFrom;
     QStringList                 m_qstrlUndoRenameTo;
 
+    // Set when an undo is requested while the undo directory is still being read, as the renames can only be checked for conflicts against
+    // the complete listing, so the undo is performed when the read completes
+    bool                        m_bUndoPending;
+
     // Used for substituting invalid characters with alternatives
     IRenameInvalidCharSub       m_icsInvalidCharSub;
 
@@ -92,12 +117,21 @@ private:
     QFont                       m_qfntDefaultFont;
     bool                        m_bUseAlternativeFont;
 
-    // Used to avoid circular syncing between the two tables
+    // Used to ignore selection changes while the file list is being cleared or reordered
     bool                        m_bSyncSelection;
 
     // Number of files that will be renamed with the current settings - for auto-numbering purposes
     int                         m_iNumFilesToRename;
 
+    // Number of files that were to be renamed when the preview was last generated, since the zero fill of every number can change with it
+    int                         m_iPreviewNumFilesToRename;
+
+    // Set when the preview couldn't be regenerated after a settings change, so the stage outputs cached in the model are out of date
+    bool                        m_bPreviewStagesStale;
+
+    // Minimum number of rows to regenerate before the preview names are generated on the thread pool
+    const int                   m_kiMinRowsForThreads = 2000;
+
     // Stores the string that represents "My Computer" on Windows (or "This PC" on windows 8.1, or "Computer" in Windows 10)
     QString                     m_qstrMyComputerPath;
 
@@ -108,6 +142,22 @@ private:
     bool                        m_bMetaTagsReadMusic;
     bool                        m_bMetaTagsReadExif;
 
+    // Tags read, or being read, for each type of meta data, indexed by tag ID.  Only the tags used by the rename are read, so the tags
+    // are read again if a tag that isn't in the set is added
+    QBitArray                   m_rgqbtaTagsRead[ISysMetaReader::NumMetaTypes];
+
+    // Worker threads reading each type of meta data and the progress windows shown while they run, indexed by ISysMetaReader::MetaType,
+    // which are nullptr when no read of that type is in progress
+    ISysMetaReader*             m_rgpmrdMetaReader[ISysMetaReader::NumMetaTypes];
+    IComDlgProgress*            m_rgpdprgMetaProgress[ISysMetaReader::NumMetaTypes];
+
+    // Incremented for each tag read so batches still queued from a cancelled read can be ignored, and number of files read so far
+    int                         m_rgiMetaReadID[ISysMetaReader::NumMetaTypes];
+    int                         m_rgiMetaFilesRead[ISysMetaReader::NumMetaTypes];
+
+    // Persistent caches of the tags read from files, which are shared with the readers as a read may still be finishing after it's cancelled
+    QSharedPointer<ISysMetaCache>   m_rgqspmchMetaCache[ISysMetaReader::NumMetaTypes];
+
     // Indicates if all Exif tags should be read or just the basic subset
     bool                        m_bExifAdvancedMode;
 
@@ -132,16 +182,16 @@ private:
     const int                   m_kiShowRenameProgressAfterMS = 1000;
     const int                   m_kiShowRenameProgressFileNum = 500;
 
-public:
-    // Constants for roles under which data is stored
-    enum                        DataRoles {FlaggedForRenme = Qt::UserRole, FileInfo, MusicMeta, ExifMeta};
+    // Above this many changes in one burst it's quicker to re-read and merge the directory than to update rows one at a time
+    const int                   m_kiMaxIncrementalChanges = 1000;
 
 public:
     IUIFileList(IUIMainWindow* pmwMainWindow);
+    ~IUIFileList();
 
 private:
-    // Creates and initialieses QTableWidget object
-    void ItitialiseTable(QTableWidget* & rpqtwTable, const QString & krqstrTitle);
+    // Creates and initialieses QTableView object to display the specified column of the file list model
+    void ItitialiseTable(QTableView* & rpqtvTable, const int kiColumn);
 
 public:
     // After creation of the window this is called to set initial directory and proccess command line parameters
@@ -161,9 +211,6 @@ public:
     // Saves current rename settings and directory
     void SaveSessionSettings();
 
-    // Should be passed AllEntries, Dirs, Files or Drives, and returns a list which includes/doesn't include hidden files based on current settings
-    QFileInfoList GetDirectoryFileList(QDir::Filters m_qdirfFileFilter);
-
     // Called when opening directory via address bar, bookmarks or open directory dialog.  Opens directory and manages back/forward buttons
     void OpenDirectory(QString qstrPath);
 
@@ -177,26 +224,40 @@ private:
     // Populates tables with directory listing
     void PopulateTablesDirectory();   
 
+    // Starts reading the current directory on a worker thread, or cancels the read in progress so its results are discarded
+    void StartDirectoryRead();
+    void CancelDirectoryRead();
+
     // Populates the table with a list of drives (My Computer)
     void PopulateTablesComputer();
 
     // Clears contents of both tables and cleares meta read flags
     void ClearTableContents();
 
-    // Removes all files and directories from file system watcher
+    // Stops watching the directory for changes
     void ClearFSWatcher();
 
-    // Updates file info, icons and FS watcher after rename operation
+    // Restores the directory watcher and regenerates previews after a rename operation, which has already updated the renamed rows
     void RefreshDirectoryPostRename();
 
     // Hard refresh discards all data in the table (including meta data) and reloads everything
     void RefreshDirectoryHard();
 
-    // Soft refresh compares the table contents to the current directory contents and adds/removes rows as necessary
+    // Soft refresh merges the current directory contents into the table, adding/removing rows as necessary, then re-reads meta data for
+    // rows that have been added, renamed or modified
     void RefreshDirectorySoft();
-    void RemoveRows(const QList<int> & krqlstRemoveRows);
-    void AddFiles(const QList<int> & krqlstAddIndexes, const QFileInfoList & krqfilFileList);
-    void AddFile(const QFileInfo & krqfiNewFile, const int kiRow);
+    void ReReadChangedRows(const QVector<int> & krqveciChangedRows);
+
+    // Updates only the rows named in the changes reported by the native directory watcher.  Returns false without changing anything if
+    // the changes can't be applied incrementally, in which case a soft refresh should be performed
+    bool ApplyDirectoryChanges(const ISysDirChangeList & krqvecdcChanges);
+
+    // Returns the row at which a new entry should be inserted to keep the table in order.  If a row order is passed the search is over the
+    // rows it lists, which must be in order, and the position in the list is returned
+    int GetInsertionRow(const QString & krqstrName, const bool kbIsDir, const int kiNumFolders, const QVector<int>* kpqveciRowOrder = nullptr);
+
+    // Moves the specified rows to their sorted positions, where all the other rows are already in order
+    void MoveRowsToSortedPositions(const QVector<int> & krqveciRows);
 
 public:
     // Sets flags FlaggedForRenme role based on current rename settings
@@ -210,11 +271,17 @@ public:
     // Checks for meta tags and if present initiates read of the appropriate data, returning false if read of data is cancelled by user
     void ReadMetaTags();
 
-    // These functions are responsible for reading the meta tags
+    // These functions are responsible for reading the meta tags.  Tags are read on a worker thread and the preview is updated as batches
+    // of tags arrive, with renaming disabled while any flagged row is waiting for its tags.  Single files are read directly when they change.
+    // Only the tags used by the rename are read, and the tags aren't read again unless they're forced or a tag that wasn't read is now used
     void ReadMetaTagsMusic(const bool kbForceReRead = false);
-    void ReadFileMetaTagsMusic(QTableWidgetItem* pqtwiFileItem);
+    void ReadFileMetaTagsMusic(const int kiRow);
     void ReadMetaTagsExif(const bool kbForceReRead = false);
-    void ReadFileMetaTagsExif(QTableWidgetItem* pqtwiFileItem);
+    void ReadFileMetaTagsExif(const int kiRow);
+    void CancelMetaTagsRead(const int kiMetaType);
+
+    // Records the modified time of the row when its meta data is read, so a soft refresh can tell if the file has been modified since
+    void RecordModifiedTime(const int kiRow);
 
     // Called if invalid character substitutions are changed in the preference menus as substitutions in tags must be redone
     void ReReadMetaTags();
@@ -225,13 +292,45 @@ private:
     // Sets hidden file filder based on m_bShowHiddenFiles
     void SetHiddenFileFilter();
 
+private:
+    // Starts a worker thread reading the passed type of meta data for the rows whose files could contain it.  The rows are marked pending
+    // until their tags arrive, and the visible rows are read first
+    void StartMetaTagsRead(const int kiMetaType);
+
+    // Returns the model's pending flag for the passed type of meta data
+    static quint8 GetMetaPendingFlag(const int kiMetaType);
+
+    // Indicates if any row flagged for renaming is still waiting for its tags, in which case the rename can't be performed yet
+    bool FlaggedRowsPending() const;
+
+    // Sets the passed values to the first and last rows visible in the file list, with riLastRow less than riFirstRow if no rows are visible
+    void GetVisibleRows(int & riFirstRow, int & riLastRow) const;
+
+    // Starts the passed directory or meta reader thread and adds it to the threads stopped when the file list is destroyed
+    void StartWorkerThread(QThread* pqthrThread);
+
+    // Returns the current row of a file whose tags were read on a worker thread, or -1 if it's no longer in the list.  The first time the
+    // row the file was read from no longer holds it, rqhashRowByName is filled with the row of every name, so it should be kept for a batch
+    int FindMetaReadRow(const ISysMetaReadItem & krmriItem, QHash<QString, int> & rqhashRowByName) const;
+
 private slots:
+    // Receive entries from the directory read.  Entries are displayed as they arrive and sorted when the read completes
+    void AddEnumeratedEntries(const int kiEnumerationID, const ISysDirEntryList & krqvecdeEntryList);
+    void DirectoryReadComplete(const int kiEnumerationID);
+
+    // Receive meta tags from the worker threads, and abort the reads if Abort is clicked in a progress window
+    void AddMetaTags(const int kiMetaType, const int kiReadID, const ISysMetaReadList & krqvecmriItems);
+    void MetaTagsReadComplete(const int kiMetaType, const int kiReadID);
+    void AbortMetaTagsRead();
+
+    // Passes the rows scrolled into view to the meta readers so their tags are read next
+    void PrioritiseVisibleRows();
+
     // Sets whether to show hidden file state and refreshes if necessary
     void SetHiddenFileState();
 
-    // When the selected rows in one table chage this functions sync the row selection to the other table and updates the file names
+    // Both tables share one selection model, so this only needs to update the file names when renaming selected items
     void SelectionChanged();
-    void SyncSelectionXToY(QTableWidget* pqtwSyncFrom, QTableWidget* pqtwSyncTo);
 
     // When one table scroll position changes these functions sync the other table scroll position to match
     void SyncScrollPreviewToCurrent();
@@ -252,6 +351,7 @@ private slots:
 
     // Navigates to the directory at the passed row, or does nothing if it's a file
     void OpenItemAtRow(const int kiRow);
+    void OpenItemAtIndex(const QModelIndex & krqmiIndex);
     void OpenDirectoryContext()             {OpenItemAtRow(m_iContextMenuRowClicked);}
 
     // Opens a file properties dialog for the file at the specified row
@@ -282,9 +382,8 @@ private slots:
     // Returns the number of folders in the current directory listing
     int GetNumFolders();
 
-    // Called when QFileSystemWatcher detects a change in the current directory
-    void DirectoryChanged(const QString & krqstrDirectory);
-    void FileChanged(const QString & krqstrFile);
+    // Called when the directory watcher reports a burst of changes in the current directory
+    void DirectoryChanged();
 
     // Prints watch list for debugging purposes
     void PrintWatchList();
@@ -294,21 +393,30 @@ private slots:
     void MoveSelectionDown();
 
 private:
-    // Functions for moving individual selection blocks from the selection list up and down
-    int MoveSelectionUp(QTableWidget * pqtwTable, const int kiTop, const int kiSelectionTop, const int kiSelectionBottom);
-    int MoveSelectionDown(QTableWidget * pqtwTable,  const int kiBottom, const int kiSelectionTop, const int kiSelectionBottom);
+    // Functions for moving individual selection blocks from the selection list up and down within the passed row order
+    int MoveSelectionUp(QVector<int> & rqveciRowOrder, const int kiTop, const int kiSelectionTop, const int kiSelectionBottom);
+    int MoveSelectionDown(QVector<int> & rqveciRowOrder, const int kiBottom, const int kiSelectionTop, const int kiSelectionBottom);
 
 public:
-    // Updates the preivew name only or name and extension
-    void GeneratePreviewName();
+    // Regenerates the preview names after the settings of the passed rename stage (an IUIRename::TabID) have changed.  The output of each
+    // stage is cached for each row, so only the changed stage and the stages after it are run, starting from the cached output of the stage
+    // before, and a row stops as soon as a stage gives the same output as last time.  Rows whose cache has been cleared because their name or
+    // tags changed are generated in full and rows whose position among the files being renamed has changed are renumbered.  With NoTab only
+    // those rows are regenerated, which is used after the rename flags, row order or directory contents change.  The settings are copied
+    // into an IRenamePlan first, so large batches of rows can be generated on the thread pool
+    void GeneratePreview(const int kiChangedStage);
+
+    // Discards the cached stage outputs and regenerates every preview, for settings that affect every stage
     void GeneratePreviewNameAndExtension();
 
+public:
+
     // Refreshes flags indicating which files should be renamed and regenerates previews
     void RenameElementsSettingsChanged();
 
 private:
-    // Compares the current name to the preivew name and highlights the preivew row if it's different
-    void HighlightRowsWithModifiedNames(const bool kbForceRedraw = false);
+    // Compares the current name to the preivew name to enable the rename button and redraws the preview table so changed rows are highlighted
+    void HighlightRowsWithModifiedNames();
 
 public:
     // Renames files to name shown in preview table
@@ -318,6 +426,9 @@ public:
     void UndoRename();
 
 private:
+    // Performs the undo once the rows of the undo directory have been read
+    void PerformUndo();
+
     // Called by PerformRename() and UndoRename() to rename files.  pqlstiRows is only passed by PerformRename() so can be used to determine if we're renaming or undoing
     void RenameFiles(QStringList & rqstrlCurrentName, QStringList & rqstrlNewName, QList<int>* pqlstiRows = nullptr);
 
@@ -327,9 +438,6 @@ private:
     // Combines above two functions into one, so this can rename forward, backward or intermediate.  I decided I prefer them separate so this isnt used.
     void RenameFilesValidated(QStringList & rqstrlCurrentName, QStringList & rqstrlNewName, QList<int>* pqlstiRows = nullptr);
 
-    // Strips off invalid characters from the end of the passed filename
-    void RemoveInvalidTrailingCharacters(QString & rqstrFileName);
-
     // Returns true if there will be no conflicting names in the end result of a rename operation
     bool RenameEndResultValid();
 
@@ -348,6 +456,8 @@ public:
     // Accessors for flags
     bool AutoRefreshEnabled()               {return m_bAutoRefresh;}
     void SetAutoRefreshEnabled(const bool kbAutoRefresh);
+    int GetAutoRefreshWindow()              {return m_pdwDirWatcher->GetCoalesceWindow();}
+    void SetAutoRefreshWindow(const int kiAutoRefreshWindowMS)                          {m_pdwDirWatcher->SetCoalesceWindow(kiAutoRefreshWindowMS);}
     bool SaveSortOrder()                    {return m_ifisFileSort.GetSaveSortOrder();}
     void SetSaveSortOrder(const bool kbSaveSortOrder)                                   {m_ifisFileSort.SetSaveSortOrder(kbSaveSortOrder);}
     bool OpenFileWhenDblClicked()           {return m_bOpenFileWhenDblClicked;}
@@ -388,6 +498,10 @@ public:
     QString CurrentPath()                   {return m_bDisplayingMyComputer ? m_qstrMyComputerPath : m_qdirDirReader.path();}
     QString CurrentDirectory()              {return m_bDisplayingMyComputer ? m_qstrMyComputerPath : m_qdirDirReader.dirName();}
     IRenameInvalidCharSub & GetInvCharSub() {return m_icsInvalidCharSub;}
+    IUIFileListModel* GetFileListModel()    {return m_pflmFileModel;}
+    bool ReadingDirectory()                 {return m_pdenDirEnumerator != nullptr;}
+    bool ReadingMetaTags(const int kiType) const    {return m_rgpmrdMetaReader[kiType] != nullptr;}
+    bool ReadingMetaTags() const                    {return ReadingMetaTags(ISysMetaReader::Music) || ReadingMetaTags(ISysMetaReader::Exif);}
 
 protected:
     // For handling shortcut keys
@@ -0,0 +1,686 @@
+#include <QtWidgets>
+#include <algorithm>
+#include "IUIFileListModel.h"
+#include "IUIFileList.h"
+
+
+// Reorders the elements of one row store vector starting at kiStart into the order given by krqveciNewOrder
+template <typename T>
+static void ReorderVector(QVector<T> & rqvecVector, const int kiStart, const QVector<int> & krqveciNewOrder)
+{
+    QVector<T> qvecReordered;
+    qvecReordered.reserve(krqveciNewOrder.size());
+
+    QVector<int>::const_iterator kitRow;
+    for (kitRow = krqveciNewOrder.constBegin() ; kitRow != krqveciNewOrder.constEnd() ; ++kitRow)
+        qvecReordered.append(rqvecVector.at(*kitRow));
+
+    std::copy(qvecReordered.constBegin(), qvecReordered.constEnd(), rqvecVector.begin() + kiStart);
+}
+
+
+IUIFileListModel::IUIFileListModel(IUIFileList* puifmFileList) : QAbstractTableModel(puifmFileList),
+                                                                    m_mstMusicMeta(IMetaMusic::NumTags),
+                                                                    m_mstExifMeta(IMetaExif::NumTagsAdvanced)
+{
+    m_puifmFileList = puifmFileList;
+    m_iPreviewDirtyFirst = -1;
+    m_iPreviewDirtyLast = -1;
+
+    // Loading embeded executable and folder icons is slow, so use generic icons
+    m_qicnExeIcon = m_qfipIconProvider.icon(QFileInfo("NonExistant.exe"));
+    m_qfipIconProvider.setOptions(QFileIconProvider::DontUseCustomDirectoryIcons);
+    m_qicnFolderIcon = m_qfipIconProvider.icon(QFileIconProvider::Folder);
+    m_qicnFileIcon = m_qfipIconProvider.icon(QFileIconProvider::File);
+}
+
+
+int IUIFileListModel::rowCount(const QModelIndex & krqmiParent) const
+{
+    if (krqmiParent.isValid())
+        return 0;
+    return m_qvecqstrNameCurrent.size();
+}
+
+
+int IUIFileListModel::columnCount(const QModelIndex & krqmiParent) const
+{
+    if (krqmiParent.isValid())
+        return 0;
+    return NumColumns;
+}
+
+
+QVariant IUIFileListModel::data(const QModelIndex & krqmiIndex, int iRole) const
+{
+    if (krqmiIndex.isValid() == false)
+        return QVariant();
+
+    const int kiRow = krqmiIndex.row();
+    switch (iRole)
+    {
+    case Qt::DisplayRole    :   return (krqmiIndex.column() == ColumnCurrent) ? m_qvecqstrNameCurrent.at(kiRow) : m_qvecqstrNamePreview.at(kiRow);
+
+    case Qt::DecorationRole :   return GetIcon(kiRow);
+
+    case Qt::ForegroundRole :   if (krqmiIndex.column() == ColumnPreview && MetaPending(kiRow))
+                                    return QApplication::palette().brush(QPalette::Disabled, QPalette::Text);
+                                if (krqmiIndex.column() == ColumnPreview && m_puifmFileList->GetNameChangeColourText() && NameChanged(kiRow))
+                                    return QBrush(m_puifmFileList->GetNameChangeTextColour());
+                                break;
+
+    case Qt::ToolTipRole    :   if (krqmiIndex.column() == ColumnPreview && MetaPending(kiRow))
+                                    return IUIFileList::tr("Waiting for meta tags to be read");
+                                break;
+
+    case Qt::BackgroundRole :   if (krqmiIndex.column() == ColumnPreview && m_puifmFileList->GetNameChangeHighlightRow() && NameChanged(kiRow))
+                                    return QBrush(m_puifmFileList->GetNameChangeHighlightColour());
+                                break;
+    }
+
+    return QVariant();
+}
+
+
+QVariant IUIFileListModel::headerData(int iSection, Qt::Orientation qoOrientation, int iRole) const
+{
+    if (qoOrientation != Qt::Horizontal || iRole != Qt::DisplayRole)
+        return QVariant();
+
+    // Use the IUIFileList context so existing translations of the column titles are still used
+    if (iSection == ColumnCurrent)
+        return IUIFileList::tr("Current Name");
+    return IUIFileList::tr("Preview");
+}
+
+
+void IUIFileListModel::SetEntryList(const ISysDirEntryList & krqvecdeEntryList)
+{
+    beginResetModel();
+    ClearRowStore();
+
+    const int kiNumFiles = krqvecdeEntryList.size();
+    m_qvecqstrNameCurrent.reserve(kiNumFiles);
+    m_qvecqstrNamePreview.reserve(kiNumFiles);
+    m_qvecqfiFileInfo.reserve(kiNumFiles);
+    m_qvecui8RowFlags.reserve(kiNumFiles);
+    m_qveciMusicMetaIndex.reserve(kiNumFiles);
+    m_qveciExifMetaIndex.reserve(kiNumFiles);
+    m_qvecui64Inode.reserve(kiNumFiles);
+    m_qvecui64Device.reserve(kiNumFiles);
+    m_qveci64ModifiedMS.reserve(kiNumFiles);
+    m_qveciExtensionID.reserve(kiNumFiles);
+    m_qvecqstrlPreviewStages.reserve(kiNumFiles);
+    m_qveciRenameIndex.reserve(kiNumFiles);
+
+    ISysDirEntryList::const_iterator kitEntry;
+    for (kitEntry = krqvecdeEntryList.constBegin() ; kitEntry != krqvecdeEntryList.constEnd() ; ++kitEntry)
+        AppendRow(kitEntry->m_qfiFileInfo, kitEntry->m_qstrName, GetEntryFlags(*kitEntry), kitEntry->m_ui64Inode, kitEntry->m_ui64Device, kitEntry->m_i64ModifiedMS);
+
+    endResetModel();
+}
+
+
+void IUIFileListModel::SetDriveList(const QFileInfoList & krqfilDriveList, const QStringList & krqstrlDriveNames)
+{
+    beginResetModel();
+    ClearRowStore();
+
+    const int kiNumDrives = krqfilDriveList.size();
+    for (int iIndex = 0 ; iIndex < kiNumDrives ; ++iIndex)
+        AppendRow(krqfilDriveList.at(iIndex), krqstrlDriveNames.at(iIndex), RowIsDir | RowIsDrive);
+
+    endResetModel();
+}
+
+
+void IUIFileListModel::Clear()
+{
+    beginResetModel();
+    ClearRowStore();
+    endResetModel();
+}
+
+
+void IUIFileListModel::ClearRowStore()
+{
+    m_qvecqstrNameCurrent.clear();
+    m_qvecqstrNamePreview.clear();
+    m_qvecqfiFileInfo.clear();
+    m_qvecui8RowFlags.clear();
+    m_qveciMusicMetaIndex.clear();
+    m_qveciExifMetaIndex.clear();
+    m_qvecui64Inode.clear();
+    m_qvecui64Device.clear();
+    m_qveci64ModifiedMS.clear();
+    m_qveciExtensionID.clear();
+    m_qhashExtensionID.clear();
+    m_qstrlExtensions.clear();
+    m_qvecqstrlPreviewStages.clear();
+    m_qveciRenameIndex.clear();
+    m_iPreviewDirtyFirst = -1;
+    m_iPreviewDirtyLast = -1;
+    m_mstMusicMeta.Clear();
+    m_mstExifMeta.Clear();
+}
+
+
+void IUIFileListModel::AppendRow(const QFileInfo & krqfiFileInfo, const QString & krqstrName, const quint8 kui8Flags, const quint64 kui64Inode, const quint64 kui64Device, const qint64 ki64ModifiedMS)
+{
+    m_qvecqstrNameCurrent.append(krqstrName);
+    m_qvecqstrNamePreview.append(krqstrName);
+    m_qvecqfiFileInfo.append(krqfiFileInfo);
+    m_qvecui8RowFlags.append(kui8Flags);
+    m_qveciMusicMetaIndex.append(-1);
+    m_qveciExifMetaIndex.append(-1);
+    m_qvecui64Inode.append(kui64Inode);
+    m_qvecui64Device.append(kui64Device);
+    m_qveci64ModifiedMS.append(ki64ModifiedMS);
+    m_qveciExtensionID.append(InternExtension(krqstrName));
+    m_qvecqstrlPreviewStages.append(QStringList());
+    m_qveciRenameIndex.append(-1);
+}
+
+
+void IUIFileListModel::TruncateRowStore(const int kiNumRows)
+{
+    m_qvecqstrNameCurrent.resize(kiNumRows);
+    m_qvecqstrNamePreview.resize(kiNumRows);
+    m_qvecqfiFileInfo.resize(kiNumRows);
+    m_qvecui8RowFlags.resize(kiNumRows);
+    m_qveciMusicMetaIndex.resize(kiNumRows);
+    m_qveciExifMetaIndex.resize(kiNumRows);
+    m_qvecui64Inode.resize(kiNumRows);
+    m_qvecui64Device.resize(kiNumRows);
+    m_qveci64ModifiedMS.resize(kiNumRows);
+    m_qveciExtensionID.resize(kiNumRows);
+    m_qvecqstrlPreviewStages.resize(kiNumRows);
+    m_qveciRenameIndex.resize(kiNumRows);
+}
+
+
+void IUIFileListModel::AppendEntries(const ISysDirEntryList & krqvecdeEntryList)
+{
+    if (krqvecdeEntryList.isEmpty())
+        return;
+
+    const int kiFirstRow = RowCount();
+    beginInsertRows(QModelIndex(), kiFirstRow, kiFirstRow+krqvecdeEntryList.size()-1);
+
+    ISysDirEntryList::const_iterator kitEntry;
+    for (kitEntry = krqvecdeEntryList.constBegin() ; kitEntry != krqvecdeEntryList.constEnd() ; ++kitEntry)
+        AppendRow(kitEntry->m_qfiFileInfo, kitEntry->m_qstrName, GetEntryFlags(*kitEntry), kitEntry->m_ui64Inode, kitEntry->m_ui64Device, kitEntry->m_i64ModifiedMS);
+
+    endInsertRows();
+}
+
+
+void IUIFileListModel::MergeEntryList(const ISysDirEntryList & krqvecdeEntryList, QStringList & rqstrlRemovedPaths, QVector<int> & rqveciChangedRows, QVector<int> & rqveciModifiedRows)
+{
+    const int kiNumOldRows = RowCount();
+    const int kiNumEntries = krqvecdeEntryList.size();
+
+    // Index the existing rows so each entry can be matched in constant time
+    QHash<QString, int> qhashRowByName;
+    QHash<QPair<quint64, quint64>, int> qhashRowByFileID;
+    qhashRowByName.reserve(kiNumOldRows);
+    for (int iRow = 0 ; iRow < kiNumOldRows ; ++iRow)
+    {
+        qhashRowByName.insert(m_qvecqstrNameCurrent.at(iRow), iRow);
+        if (m_qvecui64Inode.at(iRow) != 0)
+            qhashRowByFileID.insert(qMakePair(m_qvecui64Device.at(iRow), m_qvecui64Inode.at(iRow)), iRow);
+    }
+
+    QVector<int> qveciRowForEntry(kiNumEntries, -1);
+    QVector<bool> qvecbRowMatched(kiNumOldRows, false);
+    QVector<bool> qvecbRowRenamed(kiNumOldRows, false);
+    QVector<bool> qvecbRowModified(kiNumOldRows, false);
+    int iEntry;
+    for (iEntry = 0 ; iEntry < kiNumEntries ; ++iEntry)
+    {
+        const ISysDirEntry & krdeEntry = krqvecdeEntryList.at(iEntry);
+        QHash<QString, int>::const_iterator kitRow = qhashRowByName.constFind(krdeEntry.m_qstrName);
+        if (kitRow != qhashRowByName.constEnd())
+        {
+            const int kiRow = *kitRow;
+            qveciRowForEntry[iEntry] = kiRow;
+            qvecbRowMatched[kiRow] = true;
+
+            // The file info is replaced so the row doesn't keep cached attributes from before the modification
+            if (krdeEntry.m_i64ModifiedMS != -1 && m_qveci64ModifiedMS.at(kiRow) != -1 && krdeEntry.m_i64ModifiedMS != m_qveci64ModifiedMS.at(kiRow))
+            {
+                m_qvecqfiFileInfo[kiRow] = krdeEntry.m_qfiFileInfo;
+                m_qveci64ModifiedMS[kiRow] = krdeEntry.m_i64ModifiedMS;
+                m_qvecqstrlPreviewStages[kiRow].clear();
+                qvecbRowModified[kiRow] = true;
+            }
+        }
+    }
+
+    // Entries not matched by name are either files renamed by another application, which are matched by file ID and updated in place, or new files
+    ISysDirEntryList qvecdeNewEntries;
+    for (iEntry = 0 ; iEntry < kiNumEntries ; ++iEntry)
+    {
+        if (qveciRowForEntry.at(iEntry) != -1)
+            continue;
+
+        const ISysDirEntry & krdeEntry = krqvecdeEntryList.at(iEntry);
+        if (krdeEntry.m_ui64Inode != 0)
+        {
+            QHash<QPair<quint64, quint64>, int>::const_iterator kitRow = qhashRowByFileID.constFind(qMakePair(krdeEntry.m_ui64Device, krdeEntry.m_ui64Inode));
+            if (kitRow != qhashRowByFileID.constEnd() && qvecbRowMatched.at(*kitRow) == false)
+            {
+                const int kiRow = *kitRow;
+                rqstrlRemovedPaths.append(m_qvecqfiFileInfo.at(kiRow).filePath());
+                m_qvecqstrNameCurrent[kiRow] = krdeEntry.m_qstrName;
+                m_qvecqstrNamePreview[kiRow] = krdeEntry.m_qstrName;
+                m_qveciExtensionID[kiRow] = InternExtension(krdeEntry.m_qstrName);
+                m_qvecqfiFileInfo[kiRow] = krdeEntry.m_qfiFileInfo;
+                m_qvecui8RowFlags[kiRow] = (m_qvecui8RowFlags.at(kiRow) & ~RowTypeMask) | GetEntryFlags(krdeEntry);
+                m_qveci64ModifiedMS[kiRow] = krdeEntry.m_i64ModifiedMS;
+                m_qvecqstrlPreviewStages[kiRow].clear();
+                UpdateNameChanged(kiRow);
+
+                qveciRowForEntry[iEntry] = kiRow;
+                qvecbRowMatched[kiRow] = true;
+                qvecbRowRenamed[kiRow] = true;
+                continue;
+            }
+        }
+
+        qveciRowForEntry[iEntry] = kiNumOldRows + qvecdeNewEntries.size();
+        qvecdeNewEntries.append(krdeEntry);
+    }
+
+    // New rows are appended in one block, then the rows are reordered so new and renamed rows are at their position in the listing and the
+    // remaining rows keep their current relative order (which may have been set manually), with the removed rows moved to the end so they can
+    // be removed in one block.  Persistent indexes, and so the selection, follow their rows through the reorder
+    if (qvecdeNewEntries.isEmpty() == false)
+        AppendEntries(qvecdeNewEntries);
+
+    QVector<int> qveciNewOrder;
+    qveciNewOrder.reserve(RowCount());
+    int iNextOldRow = 0;
+    for (iEntry = 0 ; iEntry < kiNumEntries ; ++iEntry)
+    {
+        const int kiRowForEntry = qveciRowForEntry.at(iEntry);
+        if (kiRowForEntry >= kiNumOldRows || qvecbRowRenamed.at(kiRowForEntry))
+        {
+            rqveciChangedRows.append(iEntry);
+            qveciNewOrder.append(kiRowForEntry);
+        }
+        else
+        {
+            while (qvecbRowMatched.at(iNextOldRow) == false || qvecbRowRenamed.at(iNextOldRow))
+                ++iNextOldRow;
+            if (qvecbRowModified.at(iNextOldRow))
+                rqveciModifiedRows.append(iEntry);
+            qveciNewOrder.append(iNextOldRow++);
+        }
+    }
+
+    for (int iRow = 0 ; iRow < kiNumOldRows ; ++iRow)
+    {
+        if (qvecbRowMatched.at(iRow) == false)
+        {
+            rqstrlRemovedPaths.append(m_qvecqfiFileInfo.at(iRow).filePath());
+            qveciNewOrder.append(iRow);
+        }
+    }
+
+    bool bOrderChanged = false;
+    for (int iRow = 0 ; iRow < qveciNewOrder.size() ; ++iRow)
+    {
+        if (qveciNewOrder.at(iRow) != iRow)
+        {
+            bOrderChanged = true;
+            break;
+        }
+    }
+    if (bOrderChanged)
+        ReorderRows(0, qveciNewOrder);
+
+    if (RowCount() > kiNumEntries)
+    {
+        beginRemoveRows(QModelIndex(), kiNumEntries, RowCount()-1);
+        TruncateRowStore(kiNumEntries);
+        endRemoveRows();
+    }
+
+    // Rows renamed in place need repainting if the reorder didn't already cause a full relayout
+    if (bOrderChanged == false)
+    {
+        QVector<int>::const_iterator kitRow;
+        for (kitRow = rqveciChangedRows.constBegin() ; kitRow != rqveciChangedRows.constEnd() ; ++kitRow)
+        {
+            if (*kitRow < kiNumOldRows)
+                emit dataChanged(index(*kitRow, ColumnCurrent), index(*kitRow, ColumnPreview));
+        }
+    }
+}
+
+
+void IUIFileListModel::InsertEntry(const int kiRow, const ISysDirEntry & krdeEntry)
+{
+    beginInsertRows(QModelIndex(), kiRow, kiRow);
+
+    m_qvecqstrNameCurrent.insert(kiRow, krdeEntry.m_qstrName);
+    m_qvecqstrNamePreview.insert(kiRow, krdeEntry.m_qstrName);
+    m_qvecqfiFileInfo.insert(kiRow, krdeEntry.m_qfiFileInfo);
+    m_qvecui8RowFlags.insert(kiRow, GetEntryFlags(krdeEntry));
+    m_qveciMusicMetaIndex.insert(kiRow, -1);
+    m_qveciExifMetaIndex.insert(kiRow, -1);
+    m_qvecui64Inode.insert(kiRow, krdeEntry.m_ui64Inode);
+    m_qvecui64Device.insert(kiRow, krdeEntry.m_ui64Device);
+    m_qveci64ModifiedMS.insert(kiRow, krdeEntry.m_i64ModifiedMS);
+    m_qveciExtensionID.insert(kiRow, InternExtension(krdeEntry.m_qstrName));
+    m_qvecqstrlPreviewStages.insert(kiRow, QStringList());
+    m_qveciRenameIndex.insert(kiRow, -1);
+
+    endInsertRows();
+}
+
+
+void IUIFileListModel::RemoveRows(QVector<int> qveciRows)
+{
+    // Working from the last row back means the blocks still to be removed aren't moved by each removal
+    std::sort(qveciRows.begin(), qveciRows.end());
+
+    int iIndex = qveciRows.size()-1;
+    while (iIndex >= 0)
+    {
+        const int kiLastRow = qveciRows.at(iIndex);
+        int iFirstRow = kiLastRow;
+        while (iIndex > 0 && qveciRows.at(iIndex-1) == iFirstRow-1)
+        {
+            --iIndex;
+            --iFirstRow;
+        }
+        --iIndex;
+
+        const int kiNumRows = kiLastRow-iFirstRow+1;
+        beginRemoveRows(QModelIndex(), iFirstRow, kiLastRow);
+        m_qvecqstrNameCurrent.remove(iFirstRow, kiNumRows);
+        m_qvecqstrNamePreview.remove(iFirstRow, kiNumRows);
+        m_qvecqfiFileInfo.remove(iFirstRow, kiNumRows);
+        m_qvecui8RowFlags.remove(iFirstRow, kiNumRows);
+        m_qveciMusicMetaIndex.remove(iFirstRow, kiNumRows);
+        m_qveciExifMetaIndex.remove(iFirstRow, kiNumRows);
+        m_qvecui64Inode.remove(iFirstRow, kiNumRows);
+        m_qvecui64Device.remove(iFirstRow, kiNumRows);
+        m_qveci64ModifiedMS.remove(iFirstRow, kiNumRows);
+        m_qveciExtensionID.remove(iFirstRow, kiNumRows);
+        m_qvecqstrlPreviewStages.remove(iFirstRow, kiNumRows);
+        m_qveciRenameIndex.remove(iFirstRow, kiNumRows);
+        endRemoveRows();
+    }
+}
+
+
+void IUIFileListModel::ReorderRows(const int kiStart, const QVector<int> & krqveciNewOrder)
+{
+    const int kiNumRows = krqveciNewOrder.size();
+    if (kiNumRows == 0)
+        return;
+
+    emit layoutAboutToBeChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
+
+    ReorderVector(m_qvecqstrNameCurrent, kiStart, krqveciNewOrder);
+    ReorderVector(m_qvecqstrNamePreview, kiStart, krqveciNewOrder);
+    ReorderVector(m_qvecqfiFileInfo, kiStart, krqveciNewOrder);
+    ReorderVector(m_qvecui8RowFlags, kiStart, krqveciNewOrder);
+    ReorderVector(m_qveciMusicMetaIndex, kiStart, krqveciNewOrder);
+    ReorderVector(m_qveciExifMetaIndex, kiStart, krqveciNewOrder);
+    ReorderVector(m_qvecui64Inode, kiStart, krqveciNewOrder);
+    ReorderVector(m_qvecui64Device, kiStart, krqveciNewOrder);
+    ReorderVector(m_qveci64ModifiedMS, kiStart, krqveciNewOrder);
+    ReorderVector(m_qveciExtensionID, kiStart, krqveciNewOrder);
+    ReorderVector(m_qvecqstrlPreviewStages, kiStart, krqveciNewOrder);
+    ReorderVector(m_qveciRenameIndex, kiStart, krqveciNewOrder);
+
+    // Move persistent indexes (which includes the selection) along with the rows they refer to
+    QVector<int> qveciNewRowForOldRow(kiNumRows);
+    for (int iIndex = 0 ; iIndex < kiNumRows ; ++iIndex)
+        qveciNewRowForOldRow[krqveciNewOrder.at(iIndex) - kiStart] = kiStart + iIndex;
+
+    const QModelIndexList kqmilPersistentFrom = persistentIndexList();
+    QModelIndexList qmilPersistentTo;
+    qmilPersistentTo.reserve(kqmilPersistentFrom.size());
+
+    QModelIndexList::const_iterator kitIndex;
+    for (kitIndex = kqmilPersistentFrom.constBegin() ; kitIndex != kqmilPersistentFrom.constEnd() ; ++kitIndex)
+    {
+        if (kitIndex->row() >= kiStart && kitIndex->row() < kiStart + kiNumRows)
+            qmilPersistentTo.append(index(qveciNewRowForOldRow.at(kitIndex->row() - kiStart), kitIndex->column()));
+        else
+            qmilPersistentTo.append(*kitIndex);
+    }
+    changePersistentIndexList(kqmilPersistentFrom, qmilPersistentTo);
+
+    emit layoutChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
+}
+
+
+void IUIFileListModel::SetNameCurrent(const int kiRow, const QString & krqstrName)
+{
+    m_qvecqstrNameCurrent[kiRow] = krqstrName;
+    m_qveciExtensionID[kiRow] = InternExtension(krqstrName);
+    m_qvecqfiFileInfo[kiRow] = QFileInfo(m_qvecqfiFileInfo.at(kiRow).dir(), krqstrName);
+    m_qvecqstrlPreviewStages[kiRow].clear();
+    UpdateNameChanged(kiRow);
+    emit dataChanged(index(kiRow, ColumnCurrent), index(kiRow, ColumnPreview));
+}
+
+
+void IUIFileListModel::SetNamePreview(const int kiRow, const QString & krqstrName)
+{
+    // The highlight state can only flip if the preview name changes, so rows whose preview is regenerated unchanged aren't repainted
+    if (m_qvecqstrNamePreview.at(kiRow) == krqstrName)
+        return;
+
+    m_qvecqstrNamePreview[kiRow] = krqstrName;
+    UpdateNameChanged(kiRow);
+    MarkPreviewDirty(kiRow);
+}
+
+
+void IUIFileListModel::PreviewNamesChanged()
+{
+    // Rows may have been removed since the range was recorded
+    const int kiLastRow = qMin(m_iPreviewDirtyLast, m_qvecqstrNamePreview.size()-1);
+    if (m_iPreviewDirtyFirst != -1 && m_iPreviewDirtyFirst <= kiLastRow)
+        emit dataChanged(index(m_iPreviewDirtyFirst, ColumnPreview), index(kiLastRow, ColumnPreview));
+
+    m_iPreviewDirtyFirst = -1;
+    m_iPreviewDirtyLast = -1;
+}
+
+
+int IUIFileListModel::InternExtension(const QString & krqstrName)
+{
+    // Names without a dot are treated as all extension, as the filter has always done
+    const QString kqstrExtension = krqstrName.mid(krqstrName.lastIndexOf('.')+1);
+
+    QHash<QString, int>::const_iterator kitID = m_qhashExtensionID.constFind(kqstrExtension);
+    if (kitID != m_qhashExtensionID.constEnd())
+        return *kitID;
+
+    const int kiID = m_qstrlExtensions.size();
+    m_qstrlExtensions.append(kqstrExtension);
+    m_qhashExtensionID.insert(kqstrExtension, kiID);
+    return kiID;
+}
+
+
+void IUIFileListModel::MarkPreviewDirty(const int kiRow)
+{
+    if (m_iPreviewDirtyFirst == -1 || kiRow < m_iPreviewDirtyFirst)
+        m_iPreviewDirtyFirst = kiRow;
+    if (kiRow > m_iPreviewDirtyLast)
+        m_iPreviewDirtyLast = kiRow;
+}
+
+
+void IUIFileListModel::UpdateNameChanged(const int kiRow)
+{
+    if (m_qvecqstrNameCurrent.at(kiRow) != m_qvecqstrNamePreview.at(kiRow))
+        m_qvecui8RowFlags[kiRow] |= RowNameChanged;
+    else
+        m_qvecui8RowFlags[kiRow] &= ~RowNameChanged;
+}
+
+
+void IUIFileListModel::SetEntry(const int kiRow, const ISysDirEntry & krdeEntry)
+{
+    if (m_qvecqstrNameCurrent.at(kiRow) != krdeEntry.m_qstrName)
+    {
+        m_qvecqstrNameCurrent[kiRow] = krdeEntry.m_qstrName;
+        m_qvecqstrNamePreview[kiRow] = krdeEntry.m_qstrName;
+        m_qveciExtensionID[kiRow] = InternExtension(krdeEntry.m_qstrName);
+    }
+    m_qvecqfiFileInfo[kiRow] = krdeEntry.m_qfiFileInfo;
+    m_qvecui8RowFlags[kiRow] = (m_qvecui8RowFlags.at(kiRow) & ~RowTypeMask) | GetEntryFlags(krdeEntry);
+    m_qvecui64Inode[kiRow] = krdeEntry.m_ui64Inode;
+    m_qvecui64Device[kiRow] = krdeEntry.m_ui64Device;
+    m_qveci64ModifiedMS[kiRow] = krdeEntry.m_i64ModifiedMS;
+    m_qvecqstrlPreviewStages[kiRow].clear();
+    UpdateNameChanged(kiRow);
+    emit dataChanged(index(kiRow, ColumnCurrent), index(kiRow, ColumnPreview));
+}
+
+
+void IUIFileListModel::SetFlaggedForRename(const int kiRow, const bool kbFlagged)
+{
+    if (kbFlagged)
+        m_qvecui8RowFlags[kiRow] |= RowFlaggedForRename;
+    else
+        m_qvecui8RowFlags[kiRow] &= ~RowFlaggedForRename;
+}
+
+
+void IUIFileListModel::SetMetaPending(const int kiRow, const quint8 kui8Flag, const bool kbPending)
+{
+    const quint8 kui8OldFlags = m_qvecui8RowFlags.at(kiRow);
+    if (kbPending)
+        m_qvecui8RowFlags[kiRow] |= kui8Flag;
+    else
+        m_qvecui8RowFlags[kiRow] &= ~kui8Flag;
+
+    // Pending rows are greyed out, so the row is repainted if it has started or stopped waiting for any tags
+    if (bool(kui8OldFlags & RowMetaPending) != bool(m_qvecui8RowFlags.at(kiRow) & RowMetaPending))
+        MarkPreviewDirty(kiRow);
+}
+
+
+void IUIFileListModel::ClearMetaPending(const quint8 kui8Flag)
+{
+    const int kiNumRows = m_qvecui8RowFlags.size();
+    for (int iRow = 0 ; iRow < kiNumRows ; ++iRow)
+    {
+        if (m_qvecui8RowFlags.at(iRow) & kui8Flag)
+            SetMetaPending(iRow, kui8Flag, false);
+    }
+}
+
+
+QStringRef IUIFileListModel::GetMusicTagValue(const int kiRow, const int kiTagID) const
+{
+    const int kiMetaIndex = m_qveciMusicMetaIndex.at(kiRow);
+    if (kiMetaIndex == -1)
+        return QStringRef();
+    return m_mstMusicMeta.GetTagValue(kiMetaIndex, kiTagID);
+}
+
+
+QStringRef IUIFileListModel::GetExifTagValue(const int kiRow, const int kiTagID) const
+{
+    const int kiMetaIndex = m_qveciExifMetaIndex.at(kiRow);
+    if (kiMetaIndex == -1)
+        return QStringRef();
+    return m_mstExifMeta.GetTagValue(kiMetaIndex, kiTagID);
+}
+
+
+void IUIFileListModel::SetMusicMeta(const int kiRow, const IMetaMusic & krmmuMusicMeta)
+{
+    m_qvecqstrlPreviewStages[kiRow].clear();
+    const int kiMetaIndex = m_qveciMusicMetaIndex.at(kiRow);
+    if (kiMetaIndex != -1)
+        m_mstMusicMeta.SetRecord(kiMetaIndex, krmmuMusicMeta);
+    else
+        m_qveciMusicMetaIndex[kiRow] = m_mstMusicMeta.AddRecord(krmmuMusicMeta);
+}
+
+
+void IUIFileListModel::SetExifMeta(const int kiRow, const IMetaExif & krmexExifMeta)
+{
+    m_qvecqstrlPreviewStages[kiRow].clear();
+    const int kiMetaIndex = m_qveciExifMetaIndex.at(kiRow);
+    if (kiMetaIndex != -1)
+        m_mstExifMeta.SetRecord(kiMetaIndex, krmexExifMeta);
+    else
+        m_qveciExifMetaIndex[kiRow] = m_mstExifMeta.AddRecord(krmexExifMeta);
+}
+
+
+void IUIFileListModel::ClearMusicMeta()
+{
+    m_mstMusicMeta.Clear();
+    m_qveciMusicMetaIndex.fill(-1);
+    ClearPreviewStages();
+}
+
+
+void IUIFileListModel::ClearExifMeta()
+{
+    m_mstExifMeta.Clear();
+    m_qveciExifMetaIndex.fill(-1);
+    ClearPreviewStages();
+}
+
+
+void IUIFileListModel::ClearPreviewStages()
+{
+    QVector<QStringList>::iterator itStages;
+    for (itStages = m_qvecqstrlPreviewStages.begin() ; itStages != m_qvecqstrlPreviewStages.end() ; ++itStages)
+        itStages->clear();
+}
+
+
+void IUIFileListModel::HighlightSettingsChanged()
+{
+    // Every highlighted row changes colour, so the whole column is repainted
+    if (m_qvecqstrNamePreview.isEmpty() == false)
+        emit dataChanged(index(0, ColumnPreview), index(m_qvecqstrNamePreview.size()-1, ColumnPreview));
+}
+
+
+QIcon IUIFileListModel::GetIcon(const int kiRow) const
+{
+    const quint8 kui8RowFlags = m_qvecui8RowFlags.at(kiRow);
+    if (kui8RowFlags & RowIsDrive)
+        return m_qfipIconProvider.icon(m_qvecqfiFileInfo.at(kiRow));
+
+    if (kui8RowFlags & RowIsDir)
+        return m_qicnFolderIcon;
+
+    // Files that have no extension, or start with a '.' and have no other '.', use the generic file icon
+    const QString & krqstrName = m_qvecqstrNameCurrent.at(kiRow);
+    const int kiExtensionIndex = krqstrName.lastIndexOf('.');
+    if (kiExtensionIndex < 1)
+        return m_qicnFileIcon;
+
+    const QString kqstrExtension = krqstrName.mid(kiExtensionIndex+1).toLower();
+    QHash<QString, QIcon>::const_iterator kitIcon = m_qhashIconCache.constFind(kqstrExtension);
+    if (kitIcon != m_qhashIconCache.constEnd())
+        return *kitIcon;
+
+    #ifdef Q_OS_WIN
+    QIcon qicnFileIcon = (kqstrExtension == "exe" ? m_qicnExeIcon : m_qfipIconProvider.icon(m_qvecqfiFileInfo.at(kiRow)));
+    #else
+    QIcon qicnFileIcon = m_qfipIconProvider.icon(m_qvecqfiFileInfo.at(kiRow));
+    #endif
+
+    m_qhashIconCache.insert(kqstrExtension, qicnFileIcon);
+    return qicnFileIcon;
+}
@@ -0,0 +1,210 @@
+#ifndef IUIFileListModel_h
+#define IUIFileListModel_h
+
+#include <QAbstractTableModel>
+#include <QFileInfo>
+#include <QFileIconProvider>
+#include <QVector>
+#include <QHash>
+#include <QIcon>
+#include "IMetaMusic.h"
+#include "IMetaExif.h"
+#include "IMetaStore.h"
+#include "ISysDirEntry.h"
+class IUIFileList;
+
+
+/* Model shared by the Current Name and Preview tables.  Column 0 is shown in the Current Name table and column 1 in the Preview table.
+ * Row data is held column-wise in parallel vectors rather than as an object per cell, so populating a directory only stores the names and file info.
+ * Icons and highlight colours are worked out in data() when a row is painted, so nothing else is allocated for rows that are never scrolled into view. */
+class IUIFileListModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    // Columns of the model - each table hides the column belonging to the other table
+    enum Columns                        {ColumnCurrent, ColumnPreview, NumColumns};
+
+    // Bit flags stored for each row in m_qvecui8RowFlags.  The pending flags are set while the row's music or Exif tags are waiting to be read,
+    // and RowNameChanged is set while the preview name differs from the current name, so painting a row doesn't need to compare the names.
+    // RowTypeMask covers the flags taken from the directory entry, which are the only ones replaced when a row's entry is updated
+    enum RowFlags                       {RowIsDir = 0x01, RowIsFile = 0x02, RowIsDrive = 0x04, RowTypeMask = RowIsDir | RowIsFile | RowIsDrive,
+                                         RowFlaggedForRename = 0x08,
+                                         RowMusicPending = 0x10, RowExifPending = 0x20, RowMetaPending = RowMusicPending | RowExifPending,
+                                         RowNameChanged = 0x40};
+
+private:
+    // Pointer to file list for reading highlight settings
+    IUIFileList*                        m_puifmFileList;
+
+    // Row store - each vector holds one attribute for every row and all vectors are kept the same size
+    QVector<QString>                    m_qvecqstrNameCurrent;
+    QVector<QString>                    m_qvecqstrNamePreview;
+    QVector<QFileInfo>                  m_qvecqfiFileInfo;
+    QVector<quint8>                     m_qvecui8RowFlags;
+    QVector<int>                        m_qveciMusicMetaIndex;
+    QVector<int>                        m_qveciExifMetaIndex;
+    QVector<quint64>                    m_qvecui64Inode;
+    QVector<quint64>                    m_qvecui64Device;
+    QVector<qint64>                     m_qveci64ModifiedMS;
+    QVector<int>                        m_qveciExtensionID;
+
+    // Extensions of the rows interned to IDs, so filtering by extension only needs to check each distinct extension once and then test
+    // each row's ID.  IDs are only reset when the row store is cleared, so an ID can outlive the rows that used it
+    QHash<QString, int>                 m_qhashExtensionID;
+    QStringList                         m_qstrlExtensions;
+
+    // Output of each rename stage when the preview name was last generated, indexed by IUIRename::TabID, and the row's position among the
+    // rows being renamed at the time, which numbering is based on.  An empty list means the row's preview must be generated from scratch
+    QVector<QStringList>                m_qvecqstrlPreviewStages;
+    QVector<int>                        m_qveciRenameIndex;
+
+    // First and last rows whose preview text or highlight state has changed since the views were last notified, with -1 meaning none
+    int                                 m_iPreviewDirtyFirst;
+    int                                 m_iPreviewDirtyLast;
+
+    // Meta tag values, where the meta index vectors above give each row's record and an index of -1 means the file has no tags
+    IMetaStore                          m_mstMusicMeta;
+    IMetaStore                          m_mstExifMeta;
+
+    // Icons are looked up when a row is first painted and cached by extension so each file type is only loaded once
+    QFileIconProvider                   m_qfipIconProvider;
+    QIcon                               m_qicnFolderIcon;
+    QIcon                               m_qicnFileIcon;
+    QIcon                               m_qicnExeIcon;
+    mutable QHash<QString, QIcon>       m_qhashIconCache;
+
+public:
+    IUIFileListModel(IUIFileList* puifmFileList);
+
+    // QAbstractTableModel interface
+    int rowCount(const QModelIndex & krqmiParent = QModelIndex()) const;
+    int columnCount(const QModelIndex & krqmiParent = QModelIndex()) const;
+    QVariant data(const QModelIndex & krqmiIndex, int iRole = Qt::DisplayRole) const;
+    QVariant headerData(int iSection, Qt::Orientation qoOrientation, int iRole = Qt::DisplayRole) const;
+
+    // Replaces the contents of the model with the passed directory listing
+    void SetEntryList(const ISysDirEntryList & krqvecdeEntryList);
+
+    // Replaces the contents of the model with the passed drives, using the passed display names
+    void SetDriveList(const QFileInfoList & krqfilDriveList, const QStringList & krqstrlDriveNames);
+
+    // Appends the passed entries to the end of the model, which is used to display a directory while it's still being read
+    void AppendEntries(const ISysDirEntryList & krqvecdeEntryList);
+
+    // Removes all rows and meta data
+    void Clear();
+
+    // Merges a fresh, sorted listing of the directory into the model in linear time.  Rows are matched to entries by name and then by inode
+    // and device, so a file renamed by another application keeps its row, flags and meta data, and is moved to the position of its new name
+    // in the listing.  Rows are added, reordered and removed with one operation each.  Paths no longer in the directory (including the old
+    // paths of renamed rows) are added to rqstrlRemovedPaths and the final rows of added and renamed entries to rqveciChangedRows.  If the
+    // listing includes modified times, rows whose modified time has changed since it was recorded are added to rqveciModifiedRows
+    void MergeEntryList(const ISysDirEntryList & krqvecdeEntryList, QStringList & rqstrlRemovedPaths, QVector<int> & rqveciChangedRows, QVector<int> & rqveciModifiedRows);
+
+    // Inserts a row for the passed entry before kiRow
+    void InsertEntry(const int kiRow, const ISysDirEntry & krdeEntry);
+
+    // Removes the passed rows, which can be in any order, with one operation for each contiguous block
+    void RemoveRows(QVector<int> qveciRows);
+
+    // Reorders the rows starting at kiStart, where krqveciNewOrder[i] is the current row that should be moved to row kiStart+i
+    void ReorderRows(const int kiStart, const QVector<int> & krqveciNewOrder);
+
+    // Row accessors
+    int RowCount() const                                                {return m_qvecqstrNameCurrent.size();}
+    const QString & GetNameCurrent(const int kiRow) const               {return m_qvecqstrNameCurrent.at(kiRow);}
+    const QString & GetNamePreview(const int kiRow) const               {return m_qvecqstrNamePreview.at(kiRow);}
+    const QFileInfo & GetFileInfo(const int kiRow) const                {return m_qvecqfiFileInfo.at(kiRow);}
+    bool IsDir(const int kiRow) const                                   {return m_qvecui8RowFlags.at(kiRow) & RowIsDir;}
+    bool IsFile(const int kiRow) const                                  {return m_qvecui8RowFlags.at(kiRow) & RowIsFile;}
+    bool FlaggedForRename(const int kiRow) const                        {return m_qvecui8RowFlags.at(kiRow) & RowFlaggedForRename;}
+    bool MetaPending(const int kiRow) const                             {return m_qvecui8RowFlags.at(kiRow) & RowMetaPending;}
+    bool MetaPending(const int kiRow, const quint8 kui8Flag) const      {return m_qvecui8RowFlags.at(kiRow) & kui8Flag;}
+    bool NameChanged(const int kiRow) const                             {return m_qvecui8RowFlags.at(kiRow) & RowNameChanged;}
+
+    // Sets the current name and file info path after a file has been renamed and updates the row in both tables.  The file type and
+    // timestamps aren't changed by a rename, so the file isn't stat'd
+    void SetNameCurrent(const int kiRow, const QString & krqstrName);
+
+    // Sets the preview name without notifying the views so a full pass can be made before calling PreviewNamesChanged(), which emits a
+    // single dataChanged() covering only the rows whose preview text or highlight state actually changed
+    void SetNamePreview(const int kiRow, const QString & krqstrName);
+    void PreviewNamesChanged();
+
+    // Updates the row after the file has been modified or renamed by another application.  If the name has changed the preview name is
+    // reset to the new name until previews are regenerated
+    void SetEntry(const int kiRow, const ISysDirEntry & krdeEntry);
+
+    // Inode and device of the row's file, which are 0 if they aren't available on the current platform
+    quint64 GetInode(const int kiRow) const                             {return m_qvecui64Inode.at(kiRow);}
+    quint64 GetDevice(const int kiRow) const                            {return m_qvecui64Device.at(kiRow);}
+
+    // Modified time in milliseconds since the epoch, which is -1 if it hasn't been recorded for the row
+    qint64 GetModified(const int kiRow) const                           {return m_qveci64ModifiedMS.at(kiRow);}
+    void SetModified(const int kiRow, const qint64 ki64ModifiedMS)      {m_qveci64ModifiedMS[kiRow] = ki64ModifiedMS;}
+
+    // Interned extension of the row's current name, and the extension for each ID, where IDs run from 0 to NumExtensionIDs()-1
+    int GetExtensionID(const int kiRow) const                           {return m_qveciExtensionID.at(kiRow);}
+    int NumExtensionIDs() const                                         {return m_qstrlExtensions.size();}
+    const QString & GetExtension(const int kiExtensionID) const         {return m_qstrlExtensions.at(kiExtensionID);}
+
+    // Sets or clears the rename flag for the row
+    void SetFlaggedForRename(const int kiRow, const bool kbFlagged);
+
+    // Sets or clears the passed pending flag for one row, or clears it for every row.  Pending rows are greyed out in the Preview table, and
+    // rows that start or stop waiting are repainted by the next PreviewNamesChanged() as the preview is regenerated whenever tags arrive
+    void SetMetaPending(const int kiRow, const quint8 kui8Flag, const bool kbPending);
+    void ClearMetaPending(const quint8 kui8Flag);
+
+    // Cached rename stage outputs for the row, which IUIFileList updates as it generates the preview name
+    QStringList & GetPreviewStages(const int kiRow)                     {return m_qvecqstrlPreviewStages[kiRow];}
+    int GetRenameIndex(const int kiRow) const                           {return m_qveciRenameIndex.at(kiRow);}
+    void SetRenameIndex(const int kiRow, const int kiRenameIndex)       {m_qveciRenameIndex[kiRow] = kiRenameIndex;}
+
+    // Discards the cached stage outputs of one row, or of every row, so the preview is generated from scratch next time.  The cache of a row
+    // is cleared automatically when its name or meta data changes
+    void ClearPreviewStages(const int kiRow)                            {m_qvecqstrlPreviewStages[kiRow].clear();}
+    void ClearPreviewStages();
+
+    // Returns a reference to the value of the passed tag in the meta store, which is empty if the file has no tags of that type.  The
+    // reference is only valid until the row's tags are set again or cleared
+    QStringRef GetMusicTagValue(const int kiRow, const int kiTagID) const;
+    QStringRef GetExifTagValue(const int kiRow, const int kiTagID) const;
+    bool HasMusicMeta(const int kiRow) const                            {return m_qveciMusicMetaIndex.at(kiRow) != -1;}
+    bool HasExifMeta(const int kiRow) const                             {return m_qveciExifMetaIndex.at(kiRow) != -1;}
+    void SetMusicMeta(const int kiRow, const IMetaMusic & krmmuMusicMeta);
+    void SetExifMeta(const int kiRow, const IMetaExif & krmexExifMeta);
+    void ClearMusicMeta();
+    void ClearExifMeta();
+
+    // Called when the highlight colours change so the preview column is repainted
+    void HighlightSettingsChanged();
+
+private:
+    // Clears the row store and meta data without notifying the views, for use within a model reset
+    void ClearRowStore();
+
+    // Appends a row for the passed file to the end of each row store vector
+    void AppendRow(const QFileInfo & krqfiFileInfo, const QString & krqstrName, const quint8 kui8Flags, const quint64 kui64Inode = 0, const quint64 kui64Device = 0, const qint64 ki64ModifiedMS = -1);
+
+    // Shrinks each row store vector to the passed number of rows
+    void TruncateRowStore(const int kiNumRows);
+
+    // Returns the ID of the extension of the passed name, adding it to the intern table if it hasn't been seen before
+    int InternExtension(const QString & krqstrName);
+
+    // Extends the range of rows PreviewNamesChanged() notifies the views of to include the passed row
+    void MarkPreviewDirty(const int kiRow);
+
+    // Sets or clears RowNameChanged by comparing the current and preview names, after either has been set directly
+    void UpdateNameChanged(const int kiRow);
+
+    // Returns the row flags for the passed directory entry
+    static quint8 GetEntryFlags(const ISysDirEntry & krdeEntry)         {return krdeEntry.m_bIsDir ? RowIsDir : (krdeEntry.m_bIsFile ? RowIsFile : 0);}
+
+    // Returns the icon for the passed row, loading it into the cache if it hasn't been used before
+    QIcon GetIcon(const int kiRow) const;
+};
+
+#endif // IUIFileListModel_h
@@ -4,6 +4,9 @@
 #include "IUIRenameName.h"
 #include "IUIRenameNumber.h"
 #include "IUIRenameRegEx.h"
+#include "IRenamePlan.h"
+#include "IMetaMusic.h"
+#include "IMetaExif.h"
 #include "IUIMainWindow.h"
 #include "IUIMenuBar.h"
 #include "IUIMenuRenames.h"
@@ -240,14 +243,25 @@ void IUIRename::ClearLastActiveLineEdit()
 }
 
 
-void IUIRename::CheckForMetaTags(bool & rbMusicTags, bool & rbExifTags)
+void IUIRename::CheckForMetaTags(bool & rbMusicTags, bool & rbExifTags, QBitArray* pqbtaMusicTags, QBitArray* pqbtaExifTags)
 {
-    m_purnName->CheckForMetaTags(rbMusicTags, rbExifTags);
-    m_purnExten->CheckForMetaTags(rbMusicTags, rbExifTags);
-    m_purnRegExName1->CheckForMetaTags(rbMusicTags, rbExifTags);
-    m_purnRegExName2->CheckForMetaTags(rbMusicTags, rbExifTags);
-    m_purnRegExName3->CheckForMetaTags(rbMusicTags, rbExifTags);
-    m_purnRegExExten->CheckForMetaTags(rbMusicTags, rbExifTags);
+    m_purnName->CheckForMetaTags(rbMusicTags, rbExifTags, pqbtaMusicTags, pqbtaExifTags);
+    m_purnExten->CheckForMetaTags(rbMusicTags, rbExifTags, pqbtaMusicTags, pqbtaExifTags);
+    m_purnRegExName1->CheckForMetaTags(rbMusicTags, rbExifTags, pqbtaMusicTags, pqbtaExifTags);
+    m_purnRegExName2->CheckForMetaTags(rbMusicTags, rbExifTags, pqbtaMusicTags, pqbtaExifTags);
+    m_purnRegExName3->CheckForMetaTags(rbMusicTags, rbExifTags, pqbtaMusicTags, pqbtaExifTags);
+    m_purnRegExExten->CheckForMetaTags(rbMusicTags, rbExifTags, pqbtaMusicTags, pqbtaExifTags);
+}
+
+
+void IUIRename::GetRequiredMetaTags(QBitArray & rqbtaMusicTags, QBitArray & rqbtaExifTags)
+{
+    rqbtaMusicTags.fill(false, IMetaMusic::NumTags);
+    rqbtaExifTags.fill(false, IMetaExif::NumTagsAdvanced);
+
+    bool bMusicTags = false;
+    bool bExifTags = false;
+    CheckForMetaTags(bMusicTags, bExifTags, &rqbtaMusicTags, &rqbtaExifTags);
 }
 
 
@@ -363,20 +377,20 @@ void IUIRename::EnableUndoButton(const bool kbEnabled)
 }
 
 
-void IUIRename::GenerateName(QString & rqstrName, QTableWidgetItem* pqtwiFileItem)
+IRenamePlan IUIRename::CompileRenamePlan(const int kiNumFilesToRename, const IRenameInvalidCharSub & kricsInvalidCharSub) const
 {
-    m_purnName->GenerateName(rqstrName, pqtwiFileItem);
-    m_purnNumber->GenerateName(rqstrName);
-    m_purnRegExName1->GenerateName(rqstrName, pqtwiFileItem);
-    m_purnRegExName2->GenerateName(rqstrName, pqtwiFileItem);
-    m_purnRegExName3->GenerateName(rqstrName, pqtwiFileItem);
-}
+    IRenamePlan rplPlan(&m_mtlMetaTagLookup, &kricsInvalidCharSub, m_bCaseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive);
 
+    // Stages must be compiled in order
+    m_purnName->CompilePlan(rplPlan);
+    m_purnExten->CompilePlan(rplPlan);
+    m_purnNumber->CompilePlan(rplPlan, kiNumFilesToRename);
+    m_purnRegExName1->CompilePlan(rplPlan);
+    m_purnRegExName2->CompilePlan(rplPlan);
+    m_purnRegExName3->CompilePlan(rplPlan);
+    m_purnRegExExten->CompilePlan(rplPlan);
 
-void IUIRename::GenerateExtension(QString & rqstrExtension, QTableWidgetItem* pqtwiFileItem)
-{
-    m_purnExten->GenerateName(rqstrExtension, pqtwiFileItem);
-    m_purnRegExExten->GenerateName(rqstrExtension, pqtwiFileItem);
+    return rplPlan;
 }
 
 
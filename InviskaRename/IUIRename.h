@@ -4,6 +4,7 @@
 #include <QWidget>
 #include "IMetaTagLookup.h"
 #include "IUIRenameRegEx.h"
+#include "IRenamePlan.h"
 class QTabWidget;
 class QPushButton;
 class QLineEdit;
@@ -13,12 +14,20 @@ class IUIFileList;
 class IUIRenameFilter;
 class IUIRenameName;
 class IUIRenameNumber;
+class IRenameInvalidCharSub;
 
 
 class IUIRename : public QWidget
 {
     Q_OBJECT
 
+public:
+    // Tab IDs used to indicate order when adding tabs.  Each tab is also a stage of name generation, so the IDs are the plan's stage IDs and
+    // also identify the stage whose settings have changed when the preview is regenerated, with NoTab used when no stage settings have changed
+    enum                        TabID {NoTab = IRenamePlan::NoStage, Name = IRenamePlan::StageName, Extension = IRenamePlan::StageExtension, Numbering = IRenamePlan::StageNumbering,
+                                       RegExName1 = IRenamePlan::StageRegExName1, RegExName2 = IRenamePlan::StageRegExName2, RegExName3 = IRenamePlan::StageRegExName3,
+                                       RegExExten = IRenamePlan::StageRegExExten, NumTabs = IRenamePlan::NumStages};
+
 private:
     // Pointer to main window so menu bar can be updated with saved renames
     IUIMainWindow*              m_pmwMainWindow;
@@ -72,9 +81,6 @@ private:
     // Set during batch changes (clearing settings, loading saved renames) to avoid name being repeatedly generated
     bool                        m_bChangingSettings;
 
-    // Tab IDs used to indicate order when adding tabs
-    enum                        TabID {Name, Extension, Numbering, RegExName1, RegExName2, RegExName3, RegExExten};
-
 public:
     IUIRename(IUIMainWindow* pmwMainWindow);
     ~IUIRename();
@@ -119,7 +125,10 @@ private slots:
 
 public:
     // Checks if there are meta tags present and sets flags accordingly
-    void CheckForMetaTags(bool & rbMusicTags, bool & rbExifTags);
+    void CheckForMetaTags(bool & rbMusicTags, bool & rbExifTags, QBitArray* pqbtaMusicTags = nullptr, QBitArray* pqbtaExifTags = nullptr);
+
+    // Sets the passed bit arrays to the music and Exif tags used by the current settings, so only those tags need to be read from files
+    void GetRequiredMetaTags(QBitArray & rqbtaMusicTags, QBitArray & rqbtaExifTags);
 
     // Adds items to Action to TagCode lookup hashes
     void AddActionLookupMusic(QAction* qactAction, const QString & qstrTagCode);
@@ -147,9 +156,9 @@ public:
     void EnableRenameButton(const bool kbEnabled);
     void EnableUndoButton(const bool kbEnabled);
 
-    // Applies current rename settings to passed string
-    void GenerateName(QString & rqstrName, QTableWidgetItem* pqtwiFileItem);
-    void GenerateExtension(QString & rqstrExtension, QTableWidgetItem* pqtwiFileItem);
+    // Compiles the current settings of every tab into a plan, which can then be used to generate names on any thread.  The passed invalid
+    // character substitutions are applied to the names the plan generates
+    IRenamePlan CompileRenamePlan(const int kiNumFilesToRename, const IRenameInvalidCharSub & kricsInvalidCharSub) const;
 
 private:
     void SaveSettings(const QString & krqstrSection, QStringList & rqstrlSettings);
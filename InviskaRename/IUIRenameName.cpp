@@ -139,10 +139,7 @@ void IUIRenameName::SettingsChangedRightCrop()
 
 void IUIRenameName::SetingsChanged()
 {
-    if (m_iRenameElement == Name)
-        m_puifmFileList->GeneratePreviewName();
-    else
-        m_puifmFileList->GeneratePreviewNameAndExtension();
+    m_puifmFileList->GeneratePreview(m_iTabID);
 }
 
 
@@ -188,101 +185,46 @@ void IUIRenameName::ClearAll()
 }
 
 
-void IUIRenameName::CheckForMetaTags(bool & rbMusicTags, bool & rbExifTags)
+void IUIRenameName::CheckForMetaTags(bool & rbMusicTags, bool & rbExifTags, QBitArray* pqbtaMusicTags, QBitArray* pqbtaExifTags)
 {
-    CheckListForMetaTags(m_qlstReplaceNameTags, rbMusicTags, rbExifTags);
-    CheckListForMetaTags(m_qlstReplaceTheTextWithTags, rbMusicTags, rbExifTags);
-    CheckListForMetaTags(m_qlstInsertTheTextTags, rbMusicTags, rbExifTags);
-    CheckListForMetaTags(m_qlstInsertAtStartTags, rbMusicTags, rbExifTags);
-    CheckListForMetaTags(m_qlstInsertAtEndTags, rbMusicTags, rbExifTags);
+    CheckListForMetaTags(m_qlstReplaceNameTags, rbMusicTags, rbExifTags, pqbtaMusicTags, pqbtaExifTags);
+    CheckListForMetaTags(m_qlstReplaceTheTextWithTags, rbMusicTags, rbExifTags, pqbtaMusicTags, pqbtaExifTags);
+    CheckListForMetaTags(m_qlstInsertTheTextTags, rbMusicTags, rbExifTags, pqbtaMusicTags, pqbtaExifTags);
+    CheckListForMetaTags(m_qlstInsertAtStartTags, rbMusicTags, rbExifTags, pqbtaMusicTags, pqbtaExifTags);
+    CheckListForMetaTags(m_qlstInsertAtEndTags, rbMusicTags, rbExifTags, pqbtaMusicTags, pqbtaExifTags);
 }
 
 
-void IUIRenameName::GenerateName(QString & rqstrName, QTableWidgetItem* pqtwiFileItem)
+void IUIRenameName::CompilePlan(IRenamePlan & rrplPlan) const
 {
+    rrplPlan.BeginStage(m_iTabID);
+
     if (m_pqcbReplaceName->isChecked())
-    {
-        if (m_qlstReplaceNameTags.isEmpty() == false)
-            rqstrName = m_rmtlMetaTagLookup.ReplaceTagCodesWithValues(m_pqleReplaceName->text(), m_qlstReplaceNameTags, pqtwiFileItem);
-        else
-            rqstrName = m_pqleReplaceName->text();
-    }
+        rrplPlan.AddTextOp(IRenameOp::ReplaceName, m_pqleReplaceName->text(), m_qlstReplaceNameTags);
 
     if (m_pqcbReplaceTheText->isChecked() && m_pqleReplaceTheText->text().isEmpty() == false)
-    {
-        if (m_qlstReplaceTheTextWithTags.isEmpty() == false)
-            rqstrName.replace(m_pqleReplaceTheText->text(), m_rmtlMetaTagLookup.ReplaceTagCodesWithValues(m_pqleReplaceTheTextWith->text(), m_qlstReplaceTheTextWithTags, pqtwiFileItem), m_puirRenameUI->CaseSensitive() ? Qt::CaseSensitive : Qt::CaseInsensitive);
-        else
-            rqstrName.replace(m_pqleReplaceTheText->text(), m_pqleReplaceTheTextWith->text(), m_puirRenameUI->CaseSensitive() ? Qt::CaseSensitive : Qt::CaseInsensitive);
-    }
+        rrplPlan.AddReplaceTextOp(m_pqleReplaceTheText->text(), m_pqleReplaceTheTextWith->text(), m_qlstReplaceTheTextWithTags);
 
     if (m_pqcbInsertTheText->isChecked() && m_pqleInsertTheText->text().isEmpty() == false && m_pqleInsertTheTextAtPos->text().isEmpty() == false)
-    {
-        if (m_iInsertTheTextAtPos <= rqstrName.length())
-        {
-            if (m_qlstInsertTheTextTags.isEmpty() == false)
-                rqstrName.insert(m_iInsertTheTextAtPos, m_rmtlMetaTagLookup.ReplaceTagCodesWithValues(m_pqleInsertTheText->text(), m_qlstInsertTheTextTags, pqtwiFileItem));
-            else
-                rqstrName.insert(m_iInsertTheTextAtPos, m_pqleInsertTheText->text());
-        }
-    }
+        rrplPlan.AddTextOp(IRenameOp::InsertAt, m_pqleInsertTheText->text(), m_qlstInsertTheTextTags, m_iInsertTheTextAtPos);
 
     if (m_pqcbInsertAtStart->isChecked() && m_pqleInsertAtStart->text().isEmpty() == false)
-    {
-        if (m_qlstInsertAtStartTags.isEmpty() == false)
-            rqstrName.prepend(m_rmtlMetaTagLookup.ReplaceTagCodesWithValues(m_pqleInsertAtStart->text(), m_qlstInsertAtStartTags, pqtwiFileItem));
-        else
-            rqstrName.prepend(m_pqleInsertAtStart->text());
-    }
+        rrplPlan.AddTextOp(IRenameOp::InsertAtStart, m_pqleInsertAtStart->text(), m_qlstInsertAtStartTags);
 
     if (m_pqcbInsertAtEnd->isChecked() && m_pqleInsertAtEnd->text().isEmpty() == false)
-    {
-        if (m_qlstInsertAtEndTags.isEmpty() == false)
-            rqstrName.append(m_rmtlMetaTagLookup.ReplaceTagCodesWithValues(m_pqleInsertAtEnd->text(), m_qlstInsertAtEndTags, pqtwiFileItem));
-        else
-            rqstrName.append(m_pqleInsertAtEnd->text());
-    }
+        rrplPlan.AddTextOp(IRenameOp::InsertAtEnd, m_pqleInsertAtEnd->text(), m_qlstInsertAtEndTags);
 
     if (m_pqcbCropAtPos->isChecked() && m_pqleCropAtPos->text().isEmpty() == false && m_pqleCropAtPosNextNChar->text().isEmpty() == false)
-       rqstrName.remove(m_iCropAtPos, m_iCropAtPosNextNChar);
+        rrplPlan.AddCropOp(IRenameOp::CropAt, m_iCropAtPos, m_iCropAtPosNextNChar);
 
     if (m_pqcbLeftCropNChar->isChecked() && m_pqleLeftCropNChar->text().isEmpty() == false)
-       rqstrName.remove(0, m_iLeftCropNChar);
-
-    if (m_pqcbRightCropNChar->isChecked()  && m_pqleRightCropNChar->text().isEmpty() == false)
-       rqstrName.truncate(rqstrName.length() - m_iRightCropNChar);
+        rrplPlan.AddCropOp(IRenameOp::CropLeft, 0, m_iLeftCropNChar);
 
-    switch (m_pqcboChangeCase->currentIndex())
-    {
-        case CaseNoChange  : break;
-
-        case CaseTitle     : ConvertNameToTitleCase(rqstrName);
-                             break;
-
-        case CaseSentance  : rqstrName = rqstrName.toLower();
-                             rqstrName[0] = rqstrName.at(0).toUpper();
-                             break;
-
-        case CaseLower     : rqstrName = rqstrName.toLower();
-                             break;
-
-        case CaseUpper     : rqstrName = rqstrName.toUpper();
-    }
-}
-
-
-void IUIRenameName::ConvertNameToTitleCase(QString & rqstrName)
-{
-    QString qstrWordBreakChars = " -()[]{}.,;:/\\";
-    rqstrName = rqstrName.toLower();
-    rqstrName[0] = rqstrName[0].toUpper();
+    if (m_pqcbRightCropNChar->isChecked() && m_pqleRightCropNChar->text().isEmpty() == false)
+        rrplPlan.AddCropOp(IRenameOp::CropRight, 0, m_iRightCropNChar);
 
-    int iLength = rqstrName.length();
-    for (int iIndex = 1 ; iIndex < iLength ; ++iIndex)
-    {
-        if (qstrWordBreakChars.contains(rqstrName[iIndex-1]))
-            rqstrName[iIndex] = rqstrName[iIndex].toUpper();
-    }
+    if (m_pqcboChangeCase->currentIndex() != IRenameOp::CaseNoChange)
+        rrplPlan.AddChangeCaseOp(m_pqcboChangeCase->currentIndex());
 }
 
 
@@ -3,6 +3,7 @@
 
 #include <QList>
 #include "IUIRenameTabBase.h"
+#include "IRenamePlan.h"
 #include "ui_UIRenameName.h"
 
 
@@ -25,9 +26,6 @@ private:
     int                         m_iLeftCropNChar;
     int                         m_iRightCropNChar;
 
-    // Values for Change Case combo box
-    enum                        ChangeCase {CaseNoChange, CaseTitle, CaseSentance, CaseLower, CaseUpper};
-
 public:
     IUIRenameName(IUIRename* puirRenameUI, const int kiRenameElement, const int kiTabID);
 
@@ -60,12 +58,12 @@ public:
     // Disables all settings and clears line edits
     void ClearAll();
 
-    // Checks if there are music or Exif tags in any of the boxes and sets passed flags accordingly
-    void CheckForMetaTags(bool & rbMusicTags, bool & rbExifTags);
+    // Checks if there are music or Exif tags in any of the boxes and sets passed flags accordingly, and the bits of the tags used if bit
+    // arrays are passed
+    void CheckForMetaTags(bool & rbMusicTags, bool & rbExifTags, QBitArray* pqbtaMusicTags = nullptr, QBitArray* pqbtaExifTags = nullptr);
 
-    // Generates name using current settings
-    void GenerateName(QString & rqstrName, QTableWidgetItem* pqtwiFileItem);
-    void ConvertNameToTitleCase(QString & rqstrName);
+    // Compiles the enabled settings into operations for this tab's stage of the passed plan
+    void CompilePlan(IRenamePlan & rrplPlan) const;
 
     // Adds settings to stringlist
     void SaveSettings(const QString & krqstrSection, QStringList & rqstrlSettings);
@@ -97,7 +97,7 @@ void IUIRenameNumber::EnableDisableZeroFillLineEdit()
 
 void IUIRenameNumber::SettingsChanged()
 {
-    IUIMainWindow::GetMainWindow()->GetFileListUI()->GeneratePreviewName();
+    IUIMainWindow::GetMainWindow()->GetFileListUI()->GeneratePreview(m_iTabID);
 }
 
 
@@ -119,59 +119,43 @@ void IUIRenameNumber::ClearAll()
 }
 
 
-void IUIRenameNumber::InitNumberingVals(const int kiNumFilesToRename)
+void IUIRenameNumber::CompilePlan(IRenamePlan & rrplPlan, const int kiNumFilesToRename) const
 {
     if (m_pqrbNumberingNoNumber->isChecked())
         return;
 
-    m_iCurrentNumber    = m_pqleNumberingStartNum->text().toInt();
-    m_iIncrement        = m_pqleNumberingIncrement->text().toInt();
-    m_iNumberingAtPos   = m_pqleNumberingAtPos->text().isEmpty() ? INT_MAX : m_pqleNumberingAtPos->text().toInt();;
+    const int kiStartNumber = m_pqleNumberingStartNum->text().toInt();
+    const int kiIncrement   = m_pqleNumberingIncrement->text().toInt();
 
+    int iNumberCharWidth;
     if (m_pqrbNumberingZeroFillAuto->isChecked())
     {
-        int iMaxNumber = m_iCurrentNumber + (m_iIncrement * (kiNumFilesToRename-1));
+        int iMaxNumber = kiStartNumber + (kiIncrement * (kiNumFilesToRename-1));
         iMaxNumber = abs(iMaxNumber);
-        m_iNumberCharWidth =   (iMaxNumber < 10 ? 1 :
-                               (iMaxNumber < 100 ? 2 :
-                               (iMaxNumber < 1000 ? 3 :
-                               (iMaxNumber < 10000 ? 4 :
-                               (iMaxNumber < 100000 ? 5 :
-                               (iMaxNumber < 1000000 ? 6 :
-                               (iMaxNumber < 10000000 ? 7 :
-                               (iMaxNumber < 100000000 ? 8 :
-                               (iMaxNumber < 1000000000 ? 9 :
-                               10)))))))));
+        iNumberCharWidth =  (iMaxNumber < 10 ? 1 :
+                            (iMaxNumber < 100 ? 2 :
+                            (iMaxNumber < 1000 ? 3 :
+                            (iMaxNumber < 10000 ? 4 :
+                            (iMaxNumber < 100000 ? 5 :
+                            (iMaxNumber < 1000000 ? 6 :
+                            (iMaxNumber < 10000000 ? 7 :
+                            (iMaxNumber < 100000000 ? 8 :
+                            (iMaxNumber < 1000000000 ? 9 :
+                            10)))))))));
     }
     else
     {
-        m_iNumberCharWidth  = m_pqleNumberingZeroFill->text().toInt() + 1;
+        iNumberCharWidth = m_pqleNumberingZeroFill->text().toInt() + 1;
     }
-}
 
-
-void IUIRenameNumber::GenerateName(QString & rqstrName)
-{
-    if (m_pqrbNumberingNoNumber->isChecked())
-        return;
-
-    QString qstrNumber = QString("%1").arg(m_iCurrentNumber, m_iNumberCharWidth, 10, QChar('0'));
+    rrplPlan.BeginStage(m_iTabID);
 
     if (m_pqrbNumberingAfterName->isChecked())
-    {
-        rqstrName.insert(rqstrName.length(), qstrNumber);
-    }
+        rrplPlan.AddNumberOp(IRenameOp::NumberAtEnd, kiStartNumber, kiIncrement, iNumberCharWidth);
     else if (m_pqrbNumberingBeforeName->isChecked())
-    {
-        rqstrName.insert(0, qstrNumber);
-    }
-    else //if (m_pqrbNumberingAtPos->isChecked())
-    {
-        if (m_iNumberingAtPos <= rqstrName.length())
-            rqstrName.insert(m_iNumberingAtPos, qstrNumber);
-    }
-
-    m_iCurrentNumber += m_iIncrement;
+        rrplPlan.AddNumberOp(IRenameOp::NumberAtStart, kiStartNumber, kiIncrement, iNumberCharWidth);
+    else if (m_pqleNumberingAtPos->text().isEmpty() == false)
+        rrplPlan.AddNumberOp(IRenameOp::NumberAt, kiStartNumber, kiIncrement, iNumberCharWidth, m_pqleNumberingAtPos->text().toInt());
 }
 
 
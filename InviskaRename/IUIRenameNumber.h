@@ -2,6 +2,7 @@
 #define UIRenameNumber_h
 
 #include "IUIRenameTabBase.h"
+#include "IRenamePlan.h"
 #include "ui_UIRenameNumber.h"
 class IUIRename;
 
@@ -14,18 +15,6 @@ private:
     // Stores the default value for all QLineEdits apart from Numbering...At Position
     QString                     m_qstrLineEditDefault;
 
-    // Number to use for next file
-    int                         m_iCurrentNumber;
-
-    // Increment for numbering
-    int                         m_iIncrement;
-
-    // Number of characters the number will take up with zero padding
-    int                         m_iNumberCharWidth;
-
-    // Position at which to insert the number
-    int                         m_iNumberingAtPos;
-
 public:
     IUIRenameNumber(IUIRename* puirRenameUI, const int kiRenameElement, const int kiTabID);
 
@@ -51,11 +40,10 @@ public:
     // Disables all settings and clears line edits
     void ClearAll();
 
-    // Initialises variables for rename operation based on current settings andumber of files to be renamed
-    void InitNumberingVals(const int kiNumFilesToRename);
-
-    // Inserts nubering into passed name
-    void GenerateName(QString & rqstrName);
+    // Compiles the numbering settings into an operation for this tab's stage of the passed plan, with the zero fill worked out for the number of
+    // files to be renamed.  Numbers are calculated from each file's position among the files being renamed rather than counted up, so files
+    // can be numbered in any order
+    void CompilePlan(IRenamePlan & rrplPlan, const int kiNumFilesToRename) const;
 
     // Adds settings to stringlist
     void SaveSettings(const QString & krqstrSection, QStringList & rqstrlSettings);
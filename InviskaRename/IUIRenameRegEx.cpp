@@ -25,6 +25,16 @@ void IUIRenameRegEx::SetCaseSensitivity(const bool kbCaseSensitive)
         m_qreRegEx.setPatternOptions(QRegularExpression::NoPatternOption);
     else
         m_qreRegEx.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
+    OptimiseRegEx();
+}
+
+
+void IUIRenameRegEx::OptimiseRegEx()
+{
+    // Compiles the pattern and, where PCRE supports it, JIT compiles it straight away rather than after it's been matched a number of times.
+    // The plan's copies share the compiled pattern, so every row of every preview is matched with the JIT code
+    if (m_qreRegEx.pattern().isEmpty() == false && m_qreRegEx.isValid())
+        m_qreRegEx.optimize();
 }
 
 
@@ -83,6 +93,7 @@ void IUIRenameRegEx::CreateConnections()
 void IUIRenameRegEx::SettingsChangedRegEx()
 {
     m_qreRegEx.setPattern(m_pqleRegEx->text());
+    OptimiseRegEx();
     SetingsChanged();
 }
 
@@ -135,10 +146,7 @@ void IUIRenameRegEx::SettingsChangedInsertAtEnd()
 
 void IUIRenameRegEx::SetingsChanged()
 {
-    if (m_iRenameElement == Name)
-        m_puifmFileList->GeneratePreviewName();
-    else
-        m_puifmFileList->GeneratePreviewNameAndExtension();
+    m_puifmFileList->GeneratePreview(m_iTabID);
 }
 
 
@@ -178,102 +186,48 @@ void IUIRenameRegEx::ClearAll()
 }
 
 
-void IUIRenameRegEx::CheckForMetaTags(bool & rbMusicTags, bool & rbExifTags)
+void IUIRenameRegEx::CheckForMetaTags(bool & rbMusicTags, bool & rbExifTags, QBitArray* pqbtaMusicTags, QBitArray* pqbtaExifTags)
 {
-    CheckListForMetaTags(m_qlstReplaceNameTags, rbMusicTags, rbExifTags);
-    CheckListForMetaTags(m_qlstReplaceTheTextWithTags, rbMusicTags, rbExifTags);
-    CheckListForMetaTags(m_qlstInsertTheTextTags, rbMusicTags, rbExifTags);
-    CheckListForMetaTags(m_qlstInsertAtStartTags, rbMusicTags, rbExifTags);
-    CheckListForMetaTags(m_qlstInsertAtEndTags, rbMusicTags, rbExifTags);
+    CheckListForMetaTags(m_qlstReplaceNameTags, rbMusicTags, rbExifTags, pqbtaMusicTags, pqbtaExifTags);
+    CheckListForMetaTags(m_qlstReplaceTheTextWithTags, rbMusicTags, rbExifTags, pqbtaMusicTags, pqbtaExifTags);
+    CheckListForMetaTags(m_qlstInsertTheTextTags, rbMusicTags, rbExifTags, pqbtaMusicTags, pqbtaExifTags);
+    CheckListForMetaTags(m_qlstInsertAtStartTags, rbMusicTags, rbExifTags, pqbtaMusicTags, pqbtaExifTags);
+    CheckListForMetaTags(m_qlstInsertAtEndTags, rbMusicTags, rbExifTags, pqbtaMusicTags, pqbtaExifTags);
 }
 
 
-void IUIRenameRegEx::GenerateName(QString & rqstrName, QTableWidgetItem* pqtwiFileItem)
+void IUIRenameRegEx::CompilePlan(IRenamePlan & rrplPlan) const
 {
-    if (m_bTabEnabled == false)
+    const bool kbReplaceName    = m_pqcbReplaceName->isChecked();
+    const bool kbReplaceMatch   = m_pqcbReplaceMatchWith->isChecked();
+    const bool kbInsertTheText  = m_pqcbInsertTheText->isChecked() && m_pqleInsertTheText->text().isEmpty() == false && m_pqleInsertTheTextAtPos->text().isEmpty() == false;
+    const bool kbInsertAtStart  = m_pqcbInsertAtStart->isChecked() && m_pqleInsertAtStart->text().isEmpty() == false;
+    const bool kbInsertAtEnd    = m_pqcbInsertAtEnd->isChecked() && m_pqleInsertAtEnd->text().isEmpty() == false;
+
+    // The expression is only matched if something uses the match.  If the expression is empty or invalid there's no match operation and
+    // $ references are removed from the text
+    if (m_bTabEnabled == false || (kbReplaceName || kbReplaceMatch || kbInsertTheText || kbInsertAtStart || kbInsertAtEnd) == false)
         return;
 
-    m_bRegExMatch = false;
-    if (m_pqleRegEx->text().isEmpty() == false && m_qreRegEx.isValid())
-    {
-        m_qremRegExMatch = m_qreRegEx.match(rqstrName, m_iRegExStartPos);
-        if (m_qremRegExMatch.hasMatch())
-            m_bRegExMatch = true;
-    }
-
-    if (m_pqcbReplaceName->isChecked())
-    {
-        QString qstrReplaceName = m_pqleReplaceName->text();
-        InsertRegExMatches(qstrReplaceName);
-
-        if (m_qlstReplaceNameTags.isEmpty() == false)
-            rqstrName = m_rmtlMetaTagLookup.ReplaceTagCodesWithValues(qstrReplaceName, m_qlstReplaceNameTags, pqtwiFileItem);
-        else
-            rqstrName = qstrReplaceName;
-    }
-
-    if (m_pqcbReplaceMatchWith->isChecked() && m_qremRegExMatch.captured().isEmpty() == false)
-    {
-        QString qstrReplaceMatchWith = m_pqleReplaceMatchWith->text();
-        InsertRegExMatches(qstrReplaceMatchWith);
+    rrplPlan.BeginStage(m_iTabID, true);
 
-        if (m_qlstReplaceTheTextWithTags.isEmpty() == false)
-            rqstrName.replace(m_qremRegExMatch.captured(), m_rmtlMetaTagLookup.ReplaceTagCodesWithValues(qstrReplaceMatchWith, m_qlstReplaceTheTextWithTags, pqtwiFileItem), m_puirRenameUI->CaseSensitive() ? Qt::CaseSensitive : Qt::CaseInsensitive);
-        else
-            rqstrName.replace(m_qremRegExMatch.captured(), qstrReplaceMatchWith, m_puirRenameUI->CaseSensitive() ? Qt::CaseSensitive : Qt::CaseInsensitive);
-    }
+    if (m_pqleRegEx->text().isEmpty() == false && m_qreRegEx.isValid())
+        rrplPlan.AddRegExMatchOp(m_qreRegEx, m_iRegExStartPos);
 
-    if (m_pqcbInsertTheText->isChecked() && m_pqleInsertTheText->text().isEmpty() == false && m_pqleInsertTheTextAtPos->text().isEmpty() == false)
-    {
-        QString qstrInsertTheText = m_pqleInsertTheText->text();
-        InsertRegExMatches(qstrInsertTheText);
-
-        if (m_iInsertTheTextAtPos <= rqstrName.length())
-        {
-            if (m_qlstInsertTheTextTags.isEmpty() == false)
-                rqstrName.insert(m_iInsertTheTextAtPos, m_rmtlMetaTagLookup.ReplaceTagCodesWithValues(qstrInsertTheText, m_qlstInsertTheTextTags, pqtwiFileItem));
-            else
-                rqstrName.insert(m_iInsertTheTextAtPos, qstrInsertTheText);
-        }
-    }
+    if (kbReplaceName)
+        rrplPlan.AddTextOp(IRenameOp::ReplaceName, m_pqleReplaceName->text(), m_qlstReplaceNameTags);
 
-    if (m_pqcbInsertAtStart->isChecked() && m_pqleInsertAtStart->text().isEmpty() == false)
-    {
-        QString qstrInsertAtStart = m_pqleInsertAtStart->text();
-        InsertRegExMatches(qstrInsertAtStart);
+    if (kbReplaceMatch)
+        rrplPlan.AddTextOp(IRenameOp::ReplaceMatch, m_pqleReplaceMatchWith->text(), m_qlstReplaceTheTextWithTags);
 
-        if (m_qlstInsertAtStartTags.isEmpty() == false)
-            rqstrName.prepend(m_rmtlMetaTagLookup.ReplaceTagCodesWithValues(qstrInsertAtStart, m_qlstInsertAtStartTags, pqtwiFileItem));
-        else
-            rqstrName.prepend(qstrInsertAtStart);
-    }
+    if (kbInsertTheText)
+        rrplPlan.AddTextOp(IRenameOp::InsertAt, m_pqleInsertTheText->text(), m_qlstInsertTheTextTags, m_iInsertTheTextAtPos);
 
-    if (m_pqcbInsertAtEnd->isChecked() && m_pqleInsertAtEnd->text().isEmpty() == false)
-    {
-        QString qstrInsertAtEnd = m_pqleInsertAtEnd->text();
-        InsertRegExMatches(qstrInsertAtEnd);
+    if (kbInsertAtStart)
+        rrplPlan.AddTextOp(IRenameOp::InsertAtStart, m_pqleInsertAtStart->text(), m_qlstInsertAtStartTags);
 
-        if (m_qlstInsertAtEndTags.isEmpty() == false)
-            rqstrName.append(m_rmtlMetaTagLookup.ReplaceTagCodesWithValues(qstrInsertAtEnd, m_qlstInsertAtEndTags, pqtwiFileItem));
-        else
-            rqstrName.append(qstrInsertAtEnd);
-    }
-}
-
-
-void IUIRenameRegEx::InsertRegExMatches(QString & rqstrString)
-{
-    int iSubExNum;
-    int iIndex = rqstrString.indexOf('$');
-    while (iIndex != -1 && ++iIndex < rqstrString.length())
-    {
-        if (rqstrString.at(iIndex).isDigit())
-        {
-            iSubExNum = rqstrString.at(iIndex).digitValue();
-            rqstrString.replace(iIndex-1, 2, m_bRegExMatch ? m_qremRegExMatch.captured(iSubExNum) : ""); ;
-        }
-        iIndex = rqstrString.indexOf('$', iIndex);
-    }
+    if (kbInsertAtEnd)
+        rrplPlan.AddTextOp(IRenameOp::InsertAtEnd, m_pqleInsertAtEnd->text(), m_qlstInsertAtEndTags);
 }
 
 
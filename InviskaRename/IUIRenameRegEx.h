@@ -4,6 +4,7 @@
 #include <QList>
 #include <QRegularExpression>
 #include "IUIRenameTabBase.h"
+#include "IRenamePlan.h"
 #include "ui_UIRenameRegEx.h"
 class IUIRename;
 class IUIFileList;
@@ -21,12 +22,8 @@ private:
     QList<ITagInfo>             m_qlstInsertAtStartTags;
     QList<ITagInfo>             m_qlstInsertAtEndTags;
 
-    // Regular expression and match
+    // Regular expression
     QRegularExpression          m_qreRegEx;
-    QRegularExpressionMatch     m_qremRegExMatch;
-
-    // Used to indicate if there is a match for the regular expression
-    bool                        m_bRegExMatch;
 
     // Saves number values from line edits as integers to save repeatedly converting the string to an int during renames
     int                         m_iRegExStartPos;
@@ -46,6 +43,9 @@ public:
     void SetCaseSensitivity(const bool kbCaseSensitive);
 
 private:
+    // Optimises the expression once its pattern or options have been set, so it isn't compiled again when the preview is generated
+    void OptimiseRegEx();
+
     // Sets validators for line edits
     void SetValidators();
 
@@ -73,12 +73,12 @@ public:
     // Disables all settings and clears line edits
     void ClearAll();
 
-    // Checks if there are music or Exif tags in any of the boxes and sets passed flags accordingly
-    void CheckForMetaTags(bool & rbMusicTags, bool & rbExifTags);
+    // Checks if there are music or Exif tags in any of the boxes and sets passed flags accordingly, and the bits of the tags used if bit
+    // arrays are passed
+    void CheckForMetaTags(bool & rbMusicTags, bool & rbExifTags, QBitArray* pqbtaMusicTags = nullptr, QBitArray* pqbtaExifTags = nullptr);
 
-    // Generates name using current settings
-    void GenerateName(QString & rqstrName, QTableWidgetItem* pqtwiFileItem);
-    void InsertRegExMatches(QString & rqstrString);
+    // Compiles the enabled settings into operations for this tab's stage of the passed plan
+    void CompilePlan(IRenamePlan & rrplPlan) const;
 
     // Adds settings to stringlist
     void SaveSettings(const QString & krqstrSection, QStringList & rqstrlSettings);
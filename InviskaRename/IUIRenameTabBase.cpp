@@ -23,6 +23,8 @@ void IUIRenameTabBase::ReadTagCodes(QCheckBox* pqcbCheckBox, QLineEdit* pqleLine
     QString kqstrString = pqleLineEdit->text();
 
     int iSearchStart = 0;
+    bool bMusicTags = false;
+    bool bExifTags = false;
     ITagInfo tagiTagInfo;
     QString qstrCategory, qstrTagCode;
     while (true)
@@ -61,18 +63,24 @@ void IUIRenameTabBase::ReadTagCodes(QCheckBox* pqcbCheckBox, QLineEdit* pqleLine
         {
             rqlstTagList.push_back(tagiTagInfo);
 
-            if      (tagiTagInfo.m_tcatCatagory == ITagInfo::Music && m_puifmFileList->MetaTagsReadMusic() == false)
-                m_puifmFileList->ReadMetaTagsMusic();
-            else if (tagiTagInfo.m_tcatCatagory == ITagInfo::Exif && m_puifmFileList->MetaTagsReadExif() == false)
-                m_puifmFileList->ReadMetaTagsExif();
+            if      (tagiTagInfo.m_tcatCatagory == ITagInfo::Music)
+                bMusicTags = true;
+            else if (tagiTagInfo.m_tcatCatagory == ITagInfo::Exif)
+                bExifTags = true;
         }
 
         iSearchStart = tagiTagInfo.m_iEndIndex + 1;
     }
+
+    // Only the tags used are read, so the read is started once the whole string has been parsed in case the tags aren't all read yet
+    if (bMusicTags)
+        m_puifmFileList->ReadMetaTagsMusic();
+    if (bExifTags)
+        m_puifmFileList->ReadMetaTagsExif();
 }
 
 
-void IUIRenameTabBase::CheckListForMetaTags(const QList<ITagInfo> & krqlstTagList, bool & rbMusicTags, bool & rbExifTags)
+void IUIRenameTabBase::CheckListForMetaTags(const QList<ITagInfo> & krqlstTagList, bool & rbMusicTags, bool & rbExifTags, QBitArray* pqbtaMusicTags, QBitArray* pqbtaExifTags)
 {
     if (krqlstTagList.isEmpty())
         return;
@@ -80,9 +88,17 @@ void IUIRenameTabBase::CheckListForMetaTags(const QList<ITagInfo> & krqlstTagLis
     QList<ITagInfo>::const_iterator kitTag;
     for (kitTag = krqlstTagList.constBegin() ; kitTag != krqlstTagList.constEnd() ; ++kitTag)
     {
-        if (rbMusicTags == false && kitTag->m_tcatCatagory == ITagInfo::Music)
+        if (kitTag->m_tcatCatagory == ITagInfo::Music)
+        {
             rbMusicTags = true;
-        if (rbExifTags == false && kitTag->m_tcatCatagory == ITagInfo::Exif)
+            if (pqbtaMusicTags != nullptr)
+                pqbtaMusicTags->setBit(kitTag->m_iTagID);
+        }
+        else if (kitTag->m_tcatCatagory == ITagInfo::Exif)
+        {
             rbExifTags = true;
+            if (pqbtaExifTags != nullptr)
+                pqbtaExifTags->setBit(kitTag->m_iTagID);
+        }
     }
 }
@@ -2,6 +2,7 @@
 #define IUIRenameTabBase_h
 
 #include <QWidget>
+#include <QBitArray>
 #include "IMetaTagLookup.h"
 class QCheckBox;
 class QLineEdit;
@@ -40,8 +41,9 @@ protected:
     // Reads tag codes from passed string and stores tag information in passed list
     void ReadTagCodes(QCheckBox* pqcbCheckBox, QLineEdit* pqleLineEdit, QList<ITagInfo> & rqlstTagList);
 
-    // Checks if passed list contains Music or Exif tags and sets passed pools to indicate which are present
-    void CheckListForMetaTags(const QList<ITagInfo> & krqlstTagList, bool & rbMusicTags, bool & rbExifTags);
+    // Checks if passed list contains Music or Exif tags and sets passed pools to indicate which are present.  If bit arrays are passed, the
+    // bit for each tag in the list is also set
+    void CheckListForMetaTags(const QList<ITagInfo> & krqlstTagList, bool & rbMusicTags, bool & rbExifTags, QBitArray* pqbtaMusicTags, QBitArray* pqbtaExifTags);
 
 public:
     // Clears all settings on tab
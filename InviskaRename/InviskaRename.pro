@@ -1,4 +1,4 @@
-QT += core gui widgets network
+QT += core gui widgets network concurrent
 TEMPLATE = app
 
 VERSION = 12.0
@@ -44,12 +44,20 @@ HEADERS += \
     IMetaBase.h \
     IMetaExif.h \
     IMetaMusic.h \
+    IMetaStore.h \
     IMetaTagLookup.h \
     IRenameInvalidCharSub.h \
     IRenameLegacySave.h \
+    IRenamePlan.h \
+    ISysDirEntry.h \
+    ISysDirEnumerator.h \
+    ISysDirWatcher.h \
+    ISysMetaCache.h \
+    ISysMetaReader.h \
     ISysFileInfoSort.h \
     ISysFileInfoSortClasses.h \
     IUIFileList.h \
+    IUIFileListModel.h \
     IUIMainWindow.h \
     IUIMenuBar.h \
     IUIMenuBookmarks.h \
@@ -94,12 +102,19 @@ SOURCES += \
     IMetaBase.cpp \
     IMetaExif.cpp \
     IMetaMusic.cpp \
+    IMetaStore.cpp \
     IMetaTagLookup.cpp \
     IRenameInvalidCharSub.cpp \
     IRenameLegacySave.cpp \
+    IRenamePlan.cpp \
+    ISysDirEnumerator.cpp \
+    ISysDirWatcher.cpp \
+    ISysMetaCache.cpp \
+    ISysMetaReader.cpp \
     ISysFileInfoSort.cpp \
     ISysFileInfoSortClasses.cpp \
     IUIFileList.cpp \
+    IUIFileListModel.cpp \
     IUIMainWindow.cpp \
     IUIMenuBar.cpp \
     IUIMenuBookmarks.cpp \